@@ -0,0 +1,436 @@
+#define _POSIX_C_SOURCE 199309L
+#include "slab.h"
+#include "blob.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Hot-path benchmark suite for ANB_Slab and ANB_Blob.
+ *
+ * For every item-size distribution, initial size and pop pattern, each
+ * implementation runs the same sequence: push n items, iterate all of them,
+ * pop all of them (FIFO or random order). Every sequence runs twice: once
+ * untimed per op for throughput, once with a timer around each op for
+ * latency percentiles. Iterate is a single pass, so its latency columns
+ * are the per-item average of the timed pass.
+ *
+ * Implementations:
+ *   anb_push  ANB_slab_push_item
+ *   anb_alloc ANB_slab_alloc_item + fill in place
+ *   malloc    one malloc/free per item, pointers kept in an array
+ *   ring      naive growable byte ring of [len][data] records (FIFO only)
+ *   blob      ANB_blob_push (push only, reset instead of pop)
+ *
+ * Usage: anb_bench [--n N] [--format csv|json] [--seed S]
+ */
+
+#define MAX_ITEM 4096
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint64_t rng_next(uint64_t *s) {
+    // xorshift64*
+    uint64_t x = *s;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *s = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/* ------------------------------------------------------------------ */
+/* Item size distributions                                            */
+/* ------------------------------------------------------------------ */
+typedef struct {
+    const char *name;
+    size_t (*next)(uint64_t *rng);
+} Dist;
+
+static size_t dist_fixed16(uint64_t *rng) { (void)rng; return 16; }
+static size_t dist_fixed256(uint64_t *rng) { (void)rng; return 256; }
+static size_t dist_uniform(uint64_t *rng) { return 1 + rng_next(rng) % 1024; }
+static size_t dist_bimodal(uint64_t *rng) { return rng_next(rng) % 10 ? 32 : MAX_ITEM; }
+
+static const Dist DISTS[] = {
+    { "fixed16", dist_fixed16 },
+    { "fixed256", dist_fixed256 },
+    { "uniform1-1024", dist_uniform },
+    { "bimodal32-4096", dist_bimodal },
+};
+
+/* ------------------------------------------------------------------ */
+/* Implementations under test                                         */
+/* ------------------------------------------------------------------ */
+typedef struct {
+    const char *name;
+    void *(*create)(size_t initial, size_t n);
+    void (*destroy)(void *h);
+    void (*push)(void *h, const uint8_t *data, size_t len);
+    uint64_t (*iterate)(void *h);
+    void (*pop_prepare)(void *h, size_t *order, size_t n); /* NULL: FIFO only */
+    void (*pop)(void *h, size_t i);                       /* i-th pop of the sequence */
+} Impl;
+
+static uint8_t SRC[MAX_ITEM];
+
+/* ANB_Slab, push and alloc variants share everything but push */
+typedef struct {
+    ANB_Slab_t *q;
+    ANB_SlabIter_t *iters; /* per-item iterators for random pop */
+    size_t *order;
+} AnbH;
+
+static void *anb_create(size_t initial, size_t n) {
+    AnbH *h = calloc(1, sizeof(*h));
+    h->q = ANB_slab_create(initial);
+    h->iters = malloc(n * sizeof(*h->iters));
+    return h;
+}
+
+static void anb_destroy(void *p) {
+    AnbH *h = p;
+    ANB_slab_destroy(h->q);
+    free(h->iters);
+    free(h);
+}
+
+static void anb_push(void *p, const uint8_t *data, size_t len) {
+    ANB_slab_push_item(((AnbH *)p)->q, data, len);
+}
+
+static void anb_alloc(void *p, const uint8_t *data, size_t len) {
+    uint8_t *dst = ANB_slab_alloc_item(((AnbH *)p)->q, len);
+    (void)data;
+    memset(dst, (int)len, len);
+}
+
+static uint64_t anb_iterate(void *p) {
+    AnbH *h = p;
+    ANB_SlabIter_t iter = {0};
+    size_t sz;
+    uint8_t *d;
+    uint64_t sum = 0;
+    while ((d = ANB_slab_peek_item_iter(h->q, &iter, &sz)) != NULL) sum += d[0] + sz;
+    return sum;
+}
+
+static void anb_pop_prepare(void *p, size_t *order, size_t n) {
+    AnbH *h = p;
+    ANB_SlabIter_t iter = {0};
+    size_t i = 0;
+    while (i < n && ANB_slab_peek_item_iter(h->q, &iter, NULL) != NULL) h->iters[i++] = iter;
+    h->order = order;
+}
+
+static void anb_pop(void *p, size_t i) {
+    AnbH *h = p;
+    if (h->order) ANB_slab_pop_item(h->q, &h->iters[h->order[i]]);
+    else ANB_slab_pop_item(h->q, NULL);
+}
+
+/* malloc/free baseline */
+typedef struct {
+    uint8_t **ptrs;
+    size_t *lens;
+    size_t count;
+    size_t *order;
+} MallocH;
+
+static void *malloc_create(size_t initial, size_t n) {
+    MallocH *h = calloc(1, sizeof(*h));
+    (void)initial;
+    h->ptrs = malloc(n * sizeof(*h->ptrs));
+    h->lens = malloc(n * sizeof(*h->lens));
+    return h;
+}
+
+static void malloc_destroy(void *p) {
+    MallocH *h = p;
+    free(h->ptrs);
+    free(h->lens);
+    free(h);
+}
+
+static void malloc_push(void *p, const uint8_t *data, size_t len) {
+    MallocH *h = p;
+    uint8_t *d = malloc(len);
+    memcpy(d, data, len);
+    h->lens[h->count] = len;
+    h->ptrs[h->count++] = d;
+}
+
+static uint64_t malloc_iterate(void *p) {
+    MallocH *h = p;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < h->count; i++) sum += h->ptrs[i][0] + h->lens[i];
+    return sum;
+}
+
+static void malloc_pop_prepare(void *p, size_t *order, size_t n) {
+    (void)n;
+    ((MallocH *)p)->order = order;
+}
+
+static void malloc_pop(void *p, size_t i) {
+    MallocH *h = p;
+    free(h->ptrs[h->order ? h->order[i] : i]);
+}
+
+/* Naive ring buffer: [size_t len][data] records, doubles and unwraps when full */
+typedef struct {
+    uint8_t *buf;
+    size_t cap, head, used;
+} RingH;
+
+static void ring_copy_in(RingH *r, size_t at, const void *src, size_t len) {
+    size_t off = at % r->cap, first = r->cap - off < len ? r->cap - off : len;
+    memcpy(r->buf + off, src, first);
+    memcpy(r->buf, (const uint8_t *)src + first, len - first);
+}
+
+static void ring_copy_out(RingH *r, size_t at, void *dst, size_t len) {
+    size_t off = at % r->cap, first = r->cap - off < len ? r->cap - off : len;
+    memcpy(dst, r->buf + off, first);
+    memcpy((uint8_t *)dst + first, r->buf, len - first);
+}
+
+static void *ring_create(size_t initial, size_t n) {
+    RingH *r = calloc(1, sizeof(*r));
+    (void)n;
+    r->cap = initial;
+    r->buf = malloc(initial);
+    return r;
+}
+
+static void ring_destroy(void *p) {
+    RingH *r = p;
+    free(r->buf);
+    free(r);
+}
+
+static void ring_push(void *p, const uint8_t *data, size_t len) {
+    RingH *r = p;
+    size_t need = sizeof(size_t) + len;
+    if (r->used + need > r->cap) {
+        size_t cap = r->cap;
+        while (cap < r->used + need) cap *= 2;
+        uint8_t *nb = malloc(cap);
+        ring_copy_out(r, r->head, nb, r->used);
+        free(r->buf);
+        r->buf = nb;
+        r->cap = cap;
+        r->head = 0;
+    }
+    ring_copy_in(r, r->head + r->used, &len, sizeof(len));
+    ring_copy_in(r, r->head + r->used + sizeof(len), data, len);
+    r->used += need;
+}
+
+static uint64_t ring_iterate(void *p) {
+    RingH *r = p;
+    uint64_t sum = 0;
+    for (size_t at = 0; at < r->used;) {
+        size_t len;
+        uint8_t first;
+        ring_copy_out(r, r->head + at, &len, sizeof(len));
+        ring_copy_out(r, r->head + at + sizeof(len), &first, 1);
+        sum += first + len;
+        at += sizeof(len) + len;
+    }
+    return sum;
+}
+
+static void ring_pop(void *p, size_t i) {
+    RingH *r = p;
+    size_t len;
+    (void)i;
+    ring_copy_out(r, r->head, &len, sizeof(len));
+    r->head = (r->head + sizeof(len) + len) % r->cap;
+    r->used -= sizeof(len) + len;
+}
+
+/* ANB_Blob as a plain byte log: no item tracking, pop = one reset at the end */
+static void *blob_create(size_t initial, size_t n) {
+    (void)n;
+    return ANB_blob_create(initial);
+}
+
+static void blob_destroy(void *p) { ANB_blob_destroy(p); }
+
+static void blob_push(void *p, const uint8_t *data, size_t len) { ANB_blob_push(p, data, len); }
+
+static uint64_t blob_iterate(void *p) {
+    uint64_t sum = 0;
+    const uint8_t *d = ANB_blob_data(p);
+    size_t len = ANB_blob_data_len(p);
+    for (size_t i = 0; i < len; i += 64) sum += d[i];
+    return sum;
+}
+
+static void blob_pop(void *p, size_t i) {
+    (void)i;
+    ANB_blob_reset(p);
+}
+
+static const Impl IMPLS[] = {
+    { "anb_push", anb_create, anb_destroy, anb_push, anb_iterate, anb_pop_prepare, anb_pop },
+    { "anb_alloc", anb_create, anb_destroy, anb_alloc, anb_iterate, anb_pop_prepare, anb_pop },
+    { "malloc", malloc_create, malloc_destroy, malloc_push, malloc_iterate, malloc_pop_prepare, malloc_pop },
+    { "ring", ring_create, ring_destroy, ring_push, ring_iterate, NULL, ring_pop },
+    { "blob", blob_create, blob_destroy, blob_push, blob_iterate, NULL, blob_pop },
+};
+
+/* ------------------------------------------------------------------ */
+/* Measurement and output                                             */
+/* ------------------------------------------------------------------ */
+typedef struct {
+    const char *impl, *op, *dist, *pattern;
+    size_t initial, n;
+    double ns_per_op, p50, p99, p999;
+} Row;
+
+static const char *g_format = "csv";
+static int g_rows;
+
+static void emit(const Row *r) {
+    double mops = r->ns_per_op > 0 ? 1e3 / r->ns_per_op : 0;
+    if (strcmp(g_format, "json") == 0) {
+        printf("%s\n  {\"impl\":\"%s\",\"op\":\"%s\",\"dist\":\"%s\",\"pattern\":\"%s\",\"initial\":%zu,"
+               "\"n\":%zu,\"mops\":%.3f,\"ns_per_op\":%.2f,\"p50_ns\":%.0f,\"p99_ns\":%.0f,\"p999_ns\":%.0f}",
+               g_rows ? "," : "", r->impl, r->op, r->dist, r->pattern, r->initial, r->n, mops, r->ns_per_op,
+               r->p50, r->p99, r->p999);
+    } else {
+        printf("%s,%s,%s,%s,%zu,%zu,%.3f,%.2f,%.0f,%.0f,%.0f\n", r->impl, r->op, r->dist, r->pattern,
+               r->initial, r->n, mops, r->ns_per_op, r->p50, r->p99, r->p999);
+    }
+    g_rows++;
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double pct(const uint32_t *sorted, size_t n, double p) {
+    size_t i = (size_t)(p * (double)(n - 1));
+    return sorted[i];
+}
+
+enum { OP_PUSH, OP_ITER, OP_POP, OP_COUNT };
+static const char *OP_NAMES[OP_COUNT] = { "push", "iterate", "pop" };
+
+/* One push/iterate/pop sequence. If lat is non-NULL, each op is timed into lat[op][i]. */
+static void run_sequence(const Impl *impl, const size_t *sizes, size_t n, size_t initial, size_t *order,
+                         double total[OP_COUNT], uint32_t *lat[OP_COUNT]) {
+    void *h = impl->create(initial, n);
+    volatile uint64_t sink = 0;
+    double t0, t;
+
+    t0 = now_ns();
+    for (size_t i = 0; i < n; i++) {
+        if (lat) t = now_ns();
+        impl->push(h, SRC, sizes[i]);
+        if (lat) lat[OP_PUSH][i] = (uint32_t)(now_ns() - t);
+    }
+    total[OP_PUSH] = now_ns() - t0;
+
+    t0 = now_ns();
+    sink += impl->iterate(h);
+    total[OP_ITER] = now_ns() - t0;
+    if (lat) lat[OP_ITER][0] = (uint32_t)total[OP_ITER];
+
+    if (order) impl->pop_prepare(h, order, n);
+    size_t pops = impl->pop == blob_pop ? 1 : n;
+    t0 = now_ns();
+    for (size_t i = 0; i < pops; i++) {
+        if (lat) t = now_ns();
+        impl->pop(h, i);
+        if (lat) lat[OP_POP][i] = (uint32_t)(now_ns() - t);
+    }
+    total[OP_POP] = now_ns() - t0;
+
+    (void)sink;
+    impl->destroy(h);
+}
+
+static void bench(const Impl *impl, const Dist *dist, size_t initial, int random_pop, size_t n, uint64_t seed) {
+    uint64_t rng = seed;
+    size_t *sizes = malloc(n * sizeof(*sizes));
+    size_t *order = NULL;
+    uint32_t *lat[OP_COUNT];
+    double thr[OP_COUNT], tl[OP_COUNT];
+
+    for (size_t i = 0; i < n; i++) sizes[i] = dist->next(&rng);
+    if (initial == 0) {
+        /* Presized: room for every item plus per-item overhead, so nothing grows */
+        for (size_t i = 0; i < n; i++) initial += sizes[i] + 16 + sizeof(size_t);
+    }
+    if (random_pop) {
+        order = malloc(n * sizeof(*order));
+        for (size_t i = 0; i < n; i++) order[i] = i;
+        for (size_t i = n - 1; i > 0; i--) {
+            size_t j = rng_next(&rng) % (i + 1), tmp = order[i];
+            order[i] = order[j];
+            order[j] = tmp;
+        }
+    }
+    for (int op = 0; op < OP_COUNT; op++) lat[op] = malloc(n * sizeof(uint32_t));
+
+    run_sequence(impl, sizes, n, initial, order, thr, NULL);
+    run_sequence(impl, sizes, n, initial, order, tl, lat);
+
+    for (int op = 0; op < OP_COUNT; op++) {
+        size_t cnt = op == OP_ITER ? 1 : (op == OP_POP && impl->pop == blob_pop ? 1 : n);
+        if (op == OP_ITER) lat[op][0] = (uint32_t)(lat[op][0] / n); /* per-item average of the timed pass */
+        qsort(lat[op], cnt, sizeof(uint32_t), cmp_u32);
+        Row r = { impl->name, OP_NAMES[op], dist->name, random_pop ? "random" : "fifo", initial, n,
+                  thr[op] / (double)(op == OP_ITER ? n : cnt), pct(lat[op], cnt, 0.5), pct(lat[op], cnt, 0.99),
+                  pct(lat[op], cnt, 0.999) };
+        emit(&r);
+        free(lat[op]);
+    }
+    free(order);
+    free(sizes);
+}
+
+int main(int argc, char **argv) {
+    size_t n = 200000;
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--n") == 0 && i + 1 < argc) n = (size_t)strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) g_format = argv[++i];
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+        else {
+            fprintf(stderr, "usage: %s [--n N] [--format csv|json] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (n == 0) n = 1;
+    memset(SRC, 0xAB, sizeof(SRC));
+
+    /* Growth from a tiny buffer vs. a buffer presized for the whole run (0) */
+    const size_t initials[] = { 64, 0 };
+
+    if (strcmp(g_format, "json") == 0) printf("[");
+    else printf("impl,op,dist,pattern,initial,n,mops,ns_per_op,p50_ns,p99_ns,p999_ns\n");
+
+    for (size_t d = 0; d < sizeof(DISTS) / sizeof(DISTS[0]); d++) {
+        for (size_t s = 0; s < 2; s++) {
+            for (size_t m = 0; m < sizeof(IMPLS) / sizeof(IMPLS[0]); m++) {
+                bench(&IMPLS[m], &DISTS[d], initials[s], 0, n, seed);
+                if (IMPLS[m].pop_prepare) bench(&IMPLS[m], &DISTS[d], initials[s], 1, n, seed);
+            }
+        }
+    }
+
+    if (strcmp(g_format, "json") == 0) printf("\n]\n");
+    return 0;
+}
@@ -0,0 +1,177 @@
+#define _POSIX_C_SOURCE 200809L
+#include "blob.h"
+#include "blob_codec.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Throughput benchmark for the blob codec.
+ *
+ * Each workload encodes or decodes the same array of 32-bit integers (a
+ * mix of 1- to 4-byte magnitudes) twice: once with the hand-written loop
+ * the codec replaces (one ANB_blob_push per field, a byte loop per varint)
+ * and once with the codec. The best of five runs is reported in ns per
+ * integer.
+ *
+ *   u32le_encode  fixed-width little-endian, push per field vs one writer batch
+ *   varint_encode LEB128, temp buffer + push per field vs one writer batch
+ *   varint_decode LEB128, byte loop vs ANB_blob_get_varint
+ *   svb_encode    Stream VByte block vs the LEB128 writer batch
+ *   svb_decode    Stream VByte block vs the LEB128 byte loop
+ *
+ * Usage: anb_bench_codec [millions of integers]
+ * Output: CSV on stdout (workload,naive_ns,anb_ns).
+ */
+
+static uint32_t *g_values;
+static size_t g_count;
+static volatile uint64_t g_sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------------ */
+/* Workloads: each leaves its output in the blob                      */
+/* ------------------------------------------------------------------ */
+static void u32_naive(ANB_Blob_t *b) {
+    for (size_t i = 0; i < g_count; i++) {
+        uint8_t le[4] = {(uint8_t)g_values[i], (uint8_t)(g_values[i] >> 8), (uint8_t)(g_values[i] >> 16),
+                         (uint8_t)(g_values[i] >> 24)};
+        ANB_blob_push(b, le, 4);
+    }
+}
+
+static void u32_anb(ANB_Blob_t *b) {
+    ANB_BlobWriter_t w;
+    ANB_blob_writer_begin(&w, b, g_count * 4);
+    for (size_t i = 0; i < g_count; i++) ANB_blob_put_u32le(&w, g_values[i]);
+    ANB_blob_writer_end(&w);
+}
+
+static void varint_naive(ANB_Blob_t *b) {
+    for (size_t i = 0; i < g_count; i++) {
+        uint8_t tmp[5];
+        size_t n = 0;
+        uint32_t v = g_values[i];
+        while (v >= 0x80) {
+            tmp[n++] = (uint8_t)(v | 0x80);
+            v >>= 7;
+        }
+        tmp[n++] = (uint8_t)v;
+        ANB_blob_push(b, tmp, n);
+    }
+}
+
+static void varint_anb(ANB_Blob_t *b) {
+    ANB_BlobWriter_t w;
+    ANB_blob_writer_begin(&w, b, g_count * 5);
+    for (size_t i = 0; i < g_count; i++) ANB_blob_put_varint(&w, g_values[i]);
+    ANB_blob_writer_end(&w);
+}
+
+static void varint_decode_naive(ANB_Blob_t *b) {
+    size_t len;
+    const uint8_t *p = ANB_blob_peek(b, &len);
+    const uint8_t *end = p + len;
+    uint64_t sum = 0;
+    while (p < end) {
+        uint64_t v = 0;
+        for (unsigned shift = 0; p < end; shift += 7) {
+            uint8_t byte = *p++;
+            v |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        sum += v;
+    }
+    g_sink = sum;
+}
+
+static void varint_decode_anb(ANB_Blob_t *b) {
+    ANB_BlobReader_t r;
+    ANB_blob_reader_begin(&r, b);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < g_count; i++) sum += ANB_blob_get_varint(&r);
+    g_sink = sum;
+}
+
+static void svb_anb(ANB_Blob_t *b) {
+    ANB_BlobWriter_t w;
+    ANB_blob_writer_begin(&w, b, ANB_CODEC_SVB_BOUND(g_count));
+    ANB_blob_put_svb(&w, g_values, g_count);
+    ANB_blob_writer_end(&w);
+}
+
+static uint32_t *g_out;
+
+static void svb_decode_anb(ANB_Blob_t *b) {
+    ANB_BlobReader_t r;
+    ANB_blob_reader_begin(&r, b);
+    if (!ANB_blob_get_svb(&r, g_out, g_count)) abort();
+    g_sink = g_out[g_count - 1];
+}
+
+/* ------------------------------------------------------------------ */
+/* Drivers                                                            */
+/* ------------------------------------------------------------------ */
+typedef void (*Workload)(ANB_Blob_t *b);
+
+// Encoders start from an empty blob with the capacity already in place
+static double run_encode(Workload w, ANB_Blob_t *b) {
+    double best = 1e300;
+    for (int rep = 0; rep < 5; rep++) {
+        ANB_blob_reset(b);
+        double t0 = now_ns();
+        w(b);
+        double t1 = now_ns();
+        if ((t1 - t0) < best) best = t1 - t0;
+    }
+    return best / (double)g_count;
+}
+
+// Decoders read the blob filled by enc
+static double run_decode(Workload dec, Workload enc, ANB_Blob_t *b) {
+    ANB_blob_reset(b);
+    enc(b);
+    double best = 1e300;
+    for (int rep = 0; rep < 5; rep++) {
+        double t0 = now_ns();
+        dec(b);
+        double t1 = now_ns();
+        if ((t1 - t0) < best) best = t1 - t0;
+    }
+    return best / (double)g_count;
+}
+
+int main(int argc, char **argv) {
+    size_t m = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 16;
+    g_count = (m ? m : 1) * 1000 * 1000;
+    g_values = (uint32_t *)malloc(g_count * sizeof(uint32_t));
+    g_out = (uint32_t *)malloc(g_count * sizeof(uint32_t));
+    if (!g_values || !g_out) abort();
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < g_count; i++) {
+        rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        g_values[i] = (uint32_t)(rng >> 32) >> (8 * ((rng >> 20) & 3));
+    }
+
+    ANB_Blob_t *b = ANB_blob_create(ANB_CODEC_SVB_BOUND(g_count) + g_count);
+    printf("workload,naive_ns,anb_ns\n");
+    printf("u32le_encode,%.2f,%.2f\n", run_encode(u32_naive, b), run_encode(u32_anb, b));
+    printf("varint_encode,%.2f,%.2f\n", run_encode(varint_naive, b), run_encode(varint_anb, b));
+    printf("varint_decode,%.2f,%.2f\n", run_decode(varint_decode_naive, varint_anb, b),
+           run_decode(varint_decode_anb, varint_anb, b));
+    printf("svb_encode,%.2f,%.2f\n", run_encode(varint_anb, b), run_encode(svb_anb, b));
+    printf("svb_decode,%.2f,%.2f\n", run_decode(varint_decode_naive, varint_anb, b),
+           run_decode(svb_decode_anb, svb_anb, b));
+
+    ANB_blob_destroy(b);
+    free(g_values);
+    free(g_out);
+    return 0;
+}
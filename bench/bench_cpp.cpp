@@ -0,0 +1,94 @@
+#include "anb.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+ * Parity benchmark: anb.hpp wrapper vs the C API it wraps.
+ *
+ * Each workload runs the same operations twice, once through ANB_slab_* /
+ * ANB_blob_* directly and once through anb::Slab / anb::TypedSlab /
+ * anb::Blob, and reports ns per operation. The columns should match within
+ * noise; a gap means the wrapper is not inlining.
+ *
+ * Usage: anb_bench_cpp [n]
+ * Output: CSV on stdout (workload,c_ns,cpp_ns).
+ */
+
+struct Rec {
+    std::uint64_t id;
+    std::uint32_t a, b;
+};
+
+static volatile std::uint64_t sink;
+
+template <class F>
+static double time_ns(std::size_t n, F &&f) {
+    double best = 1e300;
+    for (int rep = 0; rep < 5; rep++) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)n;
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+static void slab_c(std::size_t n) {
+    ANB_Slab_t *q = ANB_slab_create(64);
+    for (std::size_t i = 0; i < n; i++) {
+        Rec *r = (Rec *)ANB_slab_alloc_item(q, sizeof(Rec));
+        r->id = i;
+        r->a = (std::uint32_t)i;
+        r->b = (std::uint32_t)(i * 3);
+    }
+    std::uint64_t sum = 0;
+    ANB_SlabIter_t it = {};
+    std::size_t sz;
+    std::uint8_t *p;
+    while ((p = ANB_slab_peek_item_iter(q, &it, &sz)) != NULL) sum += ((Rec *)p)->b;
+    while (ANB_slab_pop_item(q, NULL) == 0) {
+    }
+    ANB_slab_destroy(q);
+    sink = sum;
+}
+
+static void slab_cpp(std::size_t n) {
+    anb::TypedSlab<Rec> q(64 / sizeof(Rec));
+    for (std::size_t i = 0; i < n; i++) q.emplace(Rec{i, (std::uint32_t)i, (std::uint32_t)(i * 3)});
+    std::uint64_t sum = 0;
+    for (const Rec &r : q) sum += r.b;
+    while (q.pop()) {
+    }
+    sink = sum;
+}
+
+static void blob_c(std::size_t n) {
+    ANB_Blob_t *b = ANB_blob_create(64);
+    for (std::size_t i = 0; i < n; i++) ANB_blob_push(b, (const std::uint8_t *)&i, sizeof i);
+    std::uint64_t sum = 0;
+    const std::uint8_t *d = ANB_blob_data(b);
+    for (std::size_t i = 0, len = ANB_blob_data_len(b); i < len; i++) sum += d[i];
+    ANB_blob_destroy(b);
+    sink = sum;
+}
+
+static void blob_cpp(std::size_t n) {
+    anb::Blob b(64);
+    for (std::size_t i = 0; i < n; i++) b.push(&i, sizeof i);
+    std::uint64_t sum = 0;
+    for (std::uint8_t c : b) sum += c;
+    sink = sum;
+}
+
+int main(int argc, char **argv) {
+    std::size_t n = argc > 1 ? (std::size_t)std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::printf("workload,c_ns,cpp_ns\n");
+    std::printf("slab_emplace_iter_pop,%.2f,%.2f\n", time_ns(n, [&] { slab_c(n); }), time_ns(n, [&] { slab_cpp(n); }));
+    std::printf("blob_push_iter,%.2f,%.2f\n", time_ns(n, [&] { blob_c(n); }), time_ns(n, [&] { blob_cpp(n); }));
+    return 0;
+}
@@ -0,0 +1,160 @@
+#define _POSIX_C_SOURCE 200809L
+#include "blob.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Throughput benchmark for the blob search functions.
+ *
+ * Each workload walks a blob of generated text from one delimiter to the
+ * next, twice: once with the memchr loop the search functions replace and
+ * once with ANB_blob_find_any / ANB_blob_find. The best of five runs is
+ * reported in MB/s.
+ *
+ *   line_split   lines ending in LF, some in CR LF; stop at either byte
+ *                (memchr per delimiter, take the nearer vs ANB_blob_find_any)
+ *   header_end   1 KiB messages with CR LF header lines; find CR LF CR LF
+ *                (memchr for CR, then compare vs ANB_blob_find)
+ *
+ * Usage: anb_bench_find [megabytes]
+ * Output: CSV on stdout (workload,naive_mbps,anb_mbps).
+ */
+
+static volatile size_t g_sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ULL;
+
+static unsigned rnd(unsigned n) {
+    g_rng = g_rng * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned)((g_rng >> 33) % n);
+}
+
+// Lines of 20..140 printable bytes; one in eight ends in CR LF
+static void fill_lines(ANB_Blob_t *b, size_t total) {
+    char line[160];
+    while (ANB_blob_data_len(b) < total) {
+        unsigned len = 20 + rnd(120);
+        for (unsigned i = 0; i < len; i++) line[i] = (char)(' ' + 1 + rnd(94));
+        if (!rnd(8)) line[len++] = '\r';
+        line[len++] = '\n';
+        ANB_blob_push(b, (const uint8_t *)line, len);
+    }
+}
+
+// Messages of about 1 KiB: header lines, an empty line, then a body
+static void fill_messages(ANB_Blob_t *b, size_t total) {
+    char buf[2048];
+    while (ANB_blob_data_len(b) < total) {
+        size_t n = 0;
+        for (unsigned h = 0; h < 8; h++) {
+            unsigned len = 16 + rnd(48);
+            for (unsigned i = 0; i < len; i++) buf[n++] = (char)('a' + rnd(26));
+            buf[n++] = '\r';
+            buf[n++] = '\n';
+        }
+        buf[n++] = '\r';
+        buf[n++] = '\n';
+        unsigned body = 256 + rnd(512);
+        for (unsigned i = 0; i < body; i++) buf[n++] = (char)(' ' + 1 + rnd(94));
+        ANB_blob_push(b, (const uint8_t *)buf, n);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Workloads: each returns the number of delimiters found             */
+/* ------------------------------------------------------------------ */
+static size_t lines_naive(ANB_Blob_t *b) {
+    size_t len, count = 0, pos = 0;
+    const uint8_t *d = ANB_blob_peek(b, &len);
+    while (pos < len) {
+        const uint8_t *cr = (const uint8_t *)memchr(d + pos, '\r', len - pos);
+        const uint8_t *lf = (const uint8_t *)memchr(d + pos, '\n', cr ? (size_t)(cr - d) - pos : len - pos);
+        const uint8_t *hit = lf ? lf : cr;
+        if (!hit) break;
+        pos = (size_t)(hit - d) + 1;
+        count++;
+    }
+    return count;
+}
+
+static size_t lines_anb(ANB_Blob_t *b) {
+    static const uint8_t crlf[2] = {'\r', '\n'};
+    size_t count = 0, pos = 0;
+    while ((pos = ANB_blob_find_any(b, pos, crlf, 2)) != ANB_BLOB_NPOS) {
+        pos++;
+        count++;
+    }
+    return count;
+}
+
+static size_t headers_naive(ANB_Blob_t *b) {
+    size_t len, count = 0, pos = 0;
+    const uint8_t *d = ANB_blob_peek(b, &len);
+    while (pos + 4 <= len) {
+        const uint8_t *cr = (const uint8_t *)memchr(d + pos, '\r', len - pos - 3);
+        if (!cr) break;
+        pos = (size_t)(cr - d);
+        if (memcmp(cr, "\r\n\r\n", 4) == 0) {
+            count++;
+            pos += 4;
+        } else {
+            pos++;
+        }
+    }
+    return count;
+}
+
+static size_t headers_anb(ANB_Blob_t *b) {
+    size_t count = 0, pos = 0;
+    while ((pos = ANB_blob_find(b, pos, (const uint8_t *)"\r\n\r\n", 4)) != ANB_BLOB_NPOS) {
+        pos += 4;
+        count++;
+    }
+    return count;
+}
+
+/* ------------------------------------------------------------------ */
+/* Driver                                                             */
+/* ------------------------------------------------------------------ */
+typedef size_t (*Workload)(ANB_Blob_t *b);
+
+static double run(Workload w, ANB_Blob_t *b, size_t expect) {
+    double best = 1e300;
+    for (int rep = 0; rep < 5; rep++) {
+        double t0 = now_ns();
+        size_t found = w(b);
+        double t1 = now_ns();
+        if (expect && found != expect) abort();
+        g_sink = found;
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    return (double)ANB_blob_data_len(b) / (1024.0 * 1024.0) / (best / 1e9);
+}
+
+int main(int argc, char **argv) {
+    size_t mb = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 64;
+    size_t total = (mb ? mb : 1) * 1024 * 1024;
+
+    printf("workload,naive_mbps,anb_mbps\n");
+    ANB_Blob_t *b = ANB_blob_create(total + 4096);
+    fill_lines(b, total);
+    size_t lines = lines_naive(b);
+    printf("line_split,%.0f,%.0f\n", run(lines_naive, b, lines), run(lines_anb, b, lines));
+
+    ANB_blob_reset(b);
+    fill_messages(b, total);
+    size_t msgs = headers_naive(b);
+    printf("header_end,%.0f,%.0f\n", run(headers_naive, b, msgs), run(headers_anb, b, msgs));
+
+    ANB_blob_destroy(b);
+    return 0;
+}
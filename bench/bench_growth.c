@@ -0,0 +1,67 @@
+#define _POSIX_C_SOURCE 199309L
+#include "blob.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Growth latency benchmark for large ANB_Blob buffers.
+ *
+ * For each size S from 64 MiB up to max_mib (default 8 GiB), fills a buffer
+ * of S bytes and times a single growth step to 2S:
+ *   anb     = ANB_blob_realloc (mmap-backed, grows via mremap)
+ *   realloc = plain malloc + realloc of the same buffer
+ *
+ * Usage: anb_bench_growth [max_mib]
+ * Output: CSV on stdout (size_mib,anb_ms,realloc_ms). The realloc column
+ * needs up to 3S of memory; sizes that fail to allocate report -1.
+ */
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static double grow_anb(size_t size) {
+    ANB_Blob_t *b = ANB_blob_create(size);
+    memset(ANB_blob_data(b), 0xA5, size);
+    double t = now_ms();
+    ANB_blob_realloc(b, size * 2);
+    t = now_ms() - t;
+    if (ANB_blob_data(b)[size - 1] != 0xA5) abort();
+    ANB_blob_destroy(b);
+    return t;
+}
+
+static double grow_realloc(size_t size) {
+    uint8_t *p = (uint8_t *)malloc(size);
+    if (!p) return -1;
+    memset(p, 0xA5, size);
+    double t = now_ms();
+    uint8_t *q = (uint8_t *)realloc(p, size * 2);
+    t = now_ms() - t;
+    if (!q) {
+        free(p);
+        return -1;
+    }
+    if (q[size - 1] != 0xA5) abort();
+    free(q);
+    return t;
+}
+
+int main(int argc, char **argv) {
+    size_t max_mib = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 8192;
+
+    printf("size_mib,anb_ms,realloc_ms\n");
+    for (size_t mib = 64; mib <= max_mib; mib *= 2) {
+        size_t size = mib << 20;
+        double anb = grow_anb(size);
+        double re = grow_realloc(size);
+        printf("%zu,%.3f,%.3f\n", mib, anb, re);
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+#define _POSIX_C_SOURCE 200809L
+#include "blob.h"
+#include "blob_io.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Throughput benchmark for the blob fd helpers.
+ *
+ * Every workload moves the same number of bytes twice: once with the naive
+ * loop (read() into a 4 KiB stack buffer, ANB_blob_push, write the blob
+ * out) and once with ANB_blob_read_fd / ANB_blob_splice_fd. The best of
+ * five runs is reported in MB/s.
+ *
+ *   pipe_read     producer thread -> pipe -> blob
+ *   file_to_file  temp file -> temp file (sendfile on Linux)
+ *   pipe_to_file  producer thread -> pipe -> temp file (splice on Linux)
+ *
+ * Usage: anb_bench_io [megabytes]
+ * Output: CSV on stdout (workload,naive_mbps,anb_mbps).
+ */
+
+#define NAIVE_CHUNK 4096
+#define PRODUCER_CHUNK (64 * 1024)
+#define BLOB_DRAIN ((size_t)1 << 20)
+
+static size_t g_total;
+static uint8_t g_chunk[PRODUCER_CHUNK];
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void *producer(void *arg) {
+    int fd = *(int *)arg;
+    size_t sent = 0;
+    while (sent < g_total) {
+        size_t n = g_total - sent < sizeof(g_chunk) ? g_total - sent : sizeof(g_chunk);
+        ssize_t w = write(fd, g_chunk, n);
+        if (w <= 0) break;
+        sent += (size_t)w;
+    }
+    close(fd);
+    return NULL;
+}
+
+static int temp_fd(void) {
+    FILE *f = tmpfile();
+    if (!f) abort();
+    int fd = dup(fileno(f));
+    fclose(f);
+    return fd;
+}
+
+/* ------------------------------------------------------------------ */
+/* Workloads: each returns the bytes it moved                         */
+/* ------------------------------------------------------------------ */
+static size_t read_naive(int in, int out) {
+    (void)out;
+    ANB_Blob_t *b = ANB_blob_create(NAIVE_CHUNK);
+    uint8_t buf[NAIVE_CHUNK];
+    size_t total = 0;
+    ssize_t n;
+    while ((n = read(in, buf, sizeof(buf))) > 0) {
+        ANB_blob_push(b, buf, (size_t)n);
+        total += (size_t)n;
+        if (ANB_blob_data_len(b) >= BLOB_DRAIN) ANB_blob_reset(b);
+    }
+    ANB_blob_destroy(b);
+    return total;
+}
+
+static size_t read_anb(int in, int out) {
+    (void)out;
+    ANB_Blob_t *b = ANB_blob_create(NAIVE_CHUNK);
+    size_t total = 0;
+    ssize_t n;
+    while ((n = ANB_blob_read_fd(b, in, 0)) > 0) {
+        total += (size_t)n;
+        if (ANB_blob_data_len(b) >= BLOB_DRAIN) ANB_blob_reset(b);
+    }
+    ANB_blob_destroy(b);
+    return total;
+}
+
+static size_t copy_naive(int in, int out) {
+    ANB_Blob_t *b = ANB_blob_create(NAIVE_CHUNK);
+    uint8_t buf[NAIVE_CHUNK];
+    size_t total = 0;
+    ssize_t n;
+    while ((n = read(in, buf, sizeof(buf))) > 0) {
+        ANB_blob_push(b, buf, (size_t)n);
+        ANB_blob_write_fd(b, out);
+        total += (size_t)n;
+    }
+    ANB_blob_destroy(b);
+    return total;
+}
+
+static size_t copy_anb(int in, int out) {
+    ANB_Blob_t *b = ANB_blob_create(NAIVE_CHUNK);
+    size_t total = 0;
+    ssize_t n;
+    while ((n = ANB_blob_splice_fd(b, in, out, 0)) > 0) total += (size_t)n;
+    ANB_blob_destroy(b);
+    return total;
+}
+
+/* ------------------------------------------------------------------ */
+/* Drivers                                                            */
+/* ------------------------------------------------------------------ */
+typedef size_t (*Workload)(int in, int out);
+
+// Producer thread feeds a pipe; the workload drains it into out (or nowhere)
+static double run_pipe(Workload w, int out) {
+    double best = 0;
+    for (int rep = 0; rep < 5; rep++) {
+        int p[2];
+        if (pipe(p) != 0) abort();
+        if (out >= 0 && ftruncate(out, 0) != 0) abort();
+        if (out >= 0) lseek(out, 0, SEEK_SET);
+        pthread_t t;
+        pthread_create(&t, NULL, producer, &p[1]);
+        double t0 = now_ns();
+        size_t moved = w(p[0], out);
+        double t1 = now_ns();
+        pthread_join(t, NULL);
+        close(p[0]);
+        if (moved != g_total) abort();
+        double mbps = (double)moved / (1024.0 * 1024.0) / ((t1 - t0) / 1e9);
+        if (mbps > best) best = mbps;
+    }
+    return best;
+}
+
+static double run_file(Workload w, int in, int out) {
+    double best = 0;
+    for (int rep = 0; rep < 5; rep++) {
+        lseek(in, 0, SEEK_SET);
+        if (ftruncate(out, 0) != 0) abort();
+        lseek(out, 0, SEEK_SET);
+        double t0 = now_ns();
+        size_t moved = w(in, out);
+        double t1 = now_ns();
+        if (moved != g_total) abort();
+        double mbps = (double)moved / (1024.0 * 1024.0) / ((t1 - t0) / 1e9);
+        if (mbps > best) best = mbps;
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    size_t mb = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 256;
+    g_total = (mb ? mb : 1) * 1024 * 1024;
+    memset(g_chunk, 0x5A, sizeof(g_chunk));
+
+    int in = temp_fd();
+    int out = temp_fd();
+    for (size_t done = 0; done < g_total; done += sizeof(g_chunk)) {
+        size_t n = g_total - done < sizeof(g_chunk) ? g_total - done : sizeof(g_chunk);
+        if (write(in, g_chunk, n) != (ssize_t)n) abort();
+    }
+
+    printf("workload,naive_mbps,anb_mbps\n");
+    printf("pipe_read,%.0f,%.0f\n", run_pipe(read_naive, -1), run_pipe(read_anb, -1));
+    printf("file_to_file,%.0f,%.0f\n", run_file(copy_naive, in, out), run_file(copy_anb, in, out));
+    printf("pipe_to_file,%.0f,%.0f\n", run_pipe(copy_naive, out), run_pipe(copy_anb, out));
+
+    close(in);
+    close(out);
+    return 0;
+}
@@ -0,0 +1,364 @@
+#pragma once
+/**
+ * @file anb.hpp
+ * @brief Header-only C++20 wrapper: RAII handles, typed slab and range iterators.
+ */
+
+/**
+ * @defgroup ANB_Cpp ANB C++ wrapper
+ * @brief Move-only owners for ANB_Slab_t / ANB_Blob_t and a typed slab.
+ *
+ * Every member is defined in the class body, so calls compile down to the
+ * underlying C function with no extra indirection. Allocation failure
+ * aborts exactly as in the C API; nothing here throws.
+ */
+#include "slab.h"
+#include "blob.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace anb {
+
+/**
+ * @ingroup ANB_Cpp
+ * @brief One slab item as seen through an iterator.
+ */
+struct Item {
+    std::uint8_t *data = nullptr; /**< Item bytes, max_align_t aligned. */
+    std::size_t size = 0;         /**< Original size passed at push/alloc. */
+
+    /** @brief View the item as bytes. */
+    std::span<std::uint8_t> bytes() const noexcept { return {data, size}; }
+};
+
+/**
+ * @ingroup ANB_Cpp
+ * @brief Forward iterator over the live items of an ANB_Slab_t.
+ *
+ * Wraps ANB_SlabIter_t. Dereferencing yields an Item by value. Popping the
+ * current item through Slab::pop(it) is safe; pushes that grow the buffer
+ * invalidate previously returned data pointers, as in the C API.
+ */
+class SlabIterator {
+public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Item;
+    using difference_type = std::ptrdiff_t;
+    using reference = Item;
+
+    SlabIterator() noexcept = default;
+    explicit SlabIterator(ANB_Slab_t *q) noexcept : q_(q) { ++*this; }
+
+    Item operator*() const noexcept { return cur_; }
+
+    SlabIterator &operator++() noexcept {
+        cur_.data = ANB_slab_peek_item_iter(q_, &it_, &cur_.size);
+        if (!cur_.data) q_ = nullptr;
+        return *this;
+    }
+
+    SlabIterator operator++(int) noexcept {
+        SlabIterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    friend bool operator==(const SlabIterator &a, const SlabIterator &b) noexcept {
+        if (!a.q_ || !b.q_) return a.q_ == b.q_;
+        return a.it_._idx == b.it_._idx;
+    }
+
+    /** @brief Underlying C iterator, e.g. for ANB_slab_item_valid. */
+    ANB_SlabIter_t &raw() noexcept { return it_; }
+
+private:
+    ANB_Slab_t *q_ = nullptr;
+    ANB_SlabIter_t it_{};
+    Item cur_{};
+};
+
+/**
+ * @ingroup ANB_Cpp
+ * @brief Move-only owner of an ANB_Slab_t.
+ */
+class Slab {
+public:
+    using iterator = SlabIterator;
+
+    /** @brief Create a slab (ANB_slab_create_ex). */
+    explicit Slab(std::size_t initial_size = 1024, unsigned flags = 0)
+        : q_(ANB_slab_create_ex(initial_size, flags)) {}
+
+    /** @brief Adopt an existing slab; it is destroyed with this object. */
+    static Slab adopt(ANB_Slab_t *q) noexcept { return Slab(q, Adopt{}); }
+
+    ~Slab() { ANB_slab_destroy(q_); }
+
+    Slab(Slab &&o) noexcept : q_(std::exchange(o.q_, nullptr)) {}
+    Slab &operator=(Slab &&o) noexcept {
+        if (this != &o) {
+            ANB_slab_destroy(q_);
+            q_ = std::exchange(o.q_, nullptr);
+        }
+        return *this;
+    }
+    Slab(const Slab &) = delete;
+    Slab &operator=(const Slab &) = delete;
+
+    ANB_Slab_t *get() const noexcept { return q_; }
+    /** @brief Give up ownership without destroying. */
+    ANB_Slab_t *release() noexcept { return std::exchange(q_, nullptr); }
+    explicit operator bool() const noexcept { return q_ != nullptr; }
+
+    /** @brief Reserve an item; nullptr only for full in-place storage (ANB_slab_init_in). */
+    std::uint8_t *alloc(std::size_t n) { return ANB_slab_alloc_item(q_, n); }
+    bool push(const void *data, std::size_t n) { return ANB_slab_push_item(q_, static_cast<const std::uint8_t *>(data), n) == 0; }
+    bool push(std::span<const std::uint8_t> bytes) { return ANB_slab_push_item(q_, bytes.data(), bytes.size()) == 0; }
+
+    /** @brief Pop the first live item. @return false if empty. */
+    bool pop() { return ANB_slab_pop_item(q_, nullptr) == 0; }
+    /** @brief Pop the item it currently points at. */
+    bool pop(iterator &it) { return ANB_slab_pop_item(q_, &it.raw()) == 0; }
+    bool secure_pop() { return ANB_slab_securepop_item(q_, nullptr) == 0; }
+    bool secure_pop(iterator &it) { return ANB_slab_securepop_item(q_, &it.raw()) == 0; }
+    /** @brief Drop every item at once (ANB_slab_reset). */
+    void reset() { ANB_slab_reset(q_); }
+
+    /** @brief Number of live items, so ranges see the item count. */
+    std::size_t size() const { return ANB_slab_item_count(q_); }
+    /** @brief Bytes in use including padding (ANB_slab_size). */
+    std::size_t bytes_used() const { return ANB_slab_size(q_); }
+    std::size_t capacity() const { return ANB_slab_capacity(q_); }
+    bool empty() const { return ANB_slab_item_count(q_) == 0; }
+
+    void trim() { ANB_slab_trim(q_); }
+    void set_growth(const ANB_GrowthPolicy_t &p) { ANB_slab_set_growth(q_, &p); }
+    void set_trim(const ANB_TrimPolicy_t &p) { ANB_slab_set_trim(q_, &p); }
+
+    /** @brief Sleep until an item is queued (ANB_slab_wait_nonempty); false on timeout. */
+    bool wait_nonempty(int timeout_ms = -1) { return ANB_slab_wait_nonempty(q_, timeout_ms) != 0; }
+    /** @brief Descriptor readable on push, for poll/epoll (ANB_slab_event_fd); -1 on failure. */
+    int event_fd() { return ANB_slab_event_fd(q_); }
+    void event_ack() { ANB_slab_event_ack(q_); }
+
+    iterator begin() const noexcept { return iterator(q_); }
+    iterator end() const noexcept { return iterator(); }
+
+private:
+    struct Adopt {};
+    Slab(ANB_Slab_t *q, Adopt) noexcept : q_(q) {}
+
+    ANB_Slab_t *q_;
+};
+
+/**
+ * @ingroup ANB_Cpp
+ * @brief Whether T may be moved by a byte copy, which slab growth does.
+ *
+ * Defaults to std::is_trivially_copyable. Specialize to std::true_type for
+ * types known to survive relocation by memcpy (no self-pointers).
+ */
+template <class T>
+struct is_relocatable : std::is_trivially_copyable<T> {};
+
+/**
+ * @ingroup ANB_Cpp
+ * @brief Slab holding objects of type T, constructed in place.
+ *
+ * Objects live directly in slab memory (one item per object). Live objects
+ * are destroyed on pop and when the TypedSlab is destroyed. Because growth
+ * relocates objects bytewise, T must satisfy anb::is_relocatable.
+ */
+template <class T>
+class TypedSlab {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "slab items are max_align_t aligned");
+    static_assert(is_relocatable<T>::value, "slab growth moves objects bytewise; specialize anb::is_relocatable");
+
+public:
+    /** @brief Forward iterator yielding T&. */
+    class iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        iterator() noexcept = default;
+        explicit iterator(SlabIterator it) noexcept : it_(it) {}
+
+        T &operator*() const noexcept { return *std::launder(reinterpret_cast<T *>((*it_).data)); }
+        T *operator->() const noexcept { return &**this; }
+        iterator &operator++() noexcept {
+            ++it_;
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator tmp = *this;
+            ++it_;
+            return tmp;
+        }
+        friend bool operator==(const iterator &a, const iterator &b) noexcept { return a.it_ == b.it_; }
+
+        SlabIterator &base() noexcept { return it_; }
+
+    private:
+        SlabIterator it_;
+    };
+
+    explicit TypedSlab(std::size_t initial_count = 64, unsigned flags = 0)
+        : slab_(initial_count * sizeof(T) > 0 ? initial_count * sizeof(T) : 1, flags) {}
+
+    ~TypedSlab() {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            if (slab_) clear();
+    }
+
+    TypedSlab(TypedSlab &&) noexcept = default;
+    TypedSlab &operator=(TypedSlab &&o) noexcept {
+        if (this != &o) {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                if (slab_) clear();
+            slab_ = std::move(o.slab_);
+        }
+        return *this;
+    }
+    TypedSlab(const TypedSlab &) = delete;
+    TypedSlab &operator=(const TypedSlab &) = delete;
+
+    /** @brief Construct a T in place at the end of the slab. */
+    template <class... Args>
+    T &emplace(Args &&...args) {
+        void *p = slab_.alloc(sizeof(T));
+        return *::new (p) T(std::forward<Args>(args)...);
+    }
+
+    void push(const T &v) { emplace(v); }
+    void push(T &&v) { emplace(std::move(v)); }
+
+    /** @brief First live object. The slab must not be empty. */
+    T &front() { return *begin(); }
+
+    /** @brief Destroy and pop the first live object. @return false if empty. */
+    bool pop() {
+        if constexpr (std::is_trivially_destructible_v<T>) return slab_.pop();
+        if (empty()) return false;
+        iterator it = begin();
+        it->~T();
+        return slab_.pop(it.base());
+    }
+
+    /** @brief Destroy and pop the object it points at. */
+    bool pop(iterator &it) {
+        if constexpr (!std::is_trivially_destructible_v<T>) it->~T();
+        return slab_.pop(it.base());
+    }
+
+    /** @brief Destroy every live object; the slab resets to offset 0. */
+    void clear() {
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            slab_.reset();
+        } else {
+            while (pop()) {
+            }
+        }
+    }
+
+    std::size_t size() const { return slab_.size(); }
+    bool empty() const { return slab_.empty(); }
+
+    iterator begin() const noexcept { return iterator(slab_.begin()); }
+    iterator end() const noexcept { return iterator(); }
+
+    Slab &slab() noexcept { return slab_; }
+
+private:
+    Slab slab_;
+};
+
+/**
+ * @ingroup ANB_Cpp
+ * @brief Move-only owner of an ANB_Blob_t.
+ */
+class Blob {
+public:
+    /** @brief Create a blob (ANB_blob_create_ex). */
+    explicit Blob(std::size_t initial_size = 256, unsigned flags = 0)
+        : b_(ANB_blob_create_ex(initial_size, flags)) {}
+
+    /** @brief Adopt an existing blob; it is destroyed with this object. */
+    static Blob adopt(ANB_Blob_t *b) noexcept { return Blob(b, Adopt{}); }
+
+    ~Blob() { ANB_blob_destroy(b_); }
+
+    Blob(Blob &&o) noexcept : b_(std::exchange(o.b_, nullptr)) {}
+    Blob &operator=(Blob &&o) noexcept {
+        if (this != &o) {
+            ANB_blob_destroy(b_);
+            b_ = std::exchange(o.b_, nullptr);
+        }
+        return *this;
+    }
+    Blob(const Blob &) = delete;
+    Blob &operator=(const Blob &) = delete;
+
+    ANB_Blob_t *get() const noexcept { return b_; }
+    ANB_Blob_t *release() noexcept { return std::exchange(b_, nullptr); }
+    explicit operator bool() const noexcept { return b_ != nullptr; }
+
+    bool push(const void *data, std::size_t n) { return ANB_blob_push(b_, static_cast<const std::uint8_t *>(data), n) == 0; }
+    bool push(std::span<const std::uint8_t> bytes) { return ANB_blob_push(b_, bytes.data(), bytes.size()) == 0; }
+
+    /** @brief Writable tail of at least min_len bytes; empty only for full in-place storage. */
+    std::span<std::uint8_t> reserve(std::size_t min_len) {
+        std::size_t avail = 0;
+        std::uint8_t *p = ANB_blob_reserve(b_, min_len, &avail);
+        return p ? std::span<std::uint8_t>{p, avail} : std::span<std::uint8_t>{};
+    }
+    /** @brief Publish n bytes written into the reserved tail. */
+    void commit(std::size_t n) { ANB_blob_commit(b_, n); }
+
+    /** @brief Unread bytes after the read cursor. */
+    std::span<std::uint8_t> peek() const {
+        std::size_t len = 0;
+        std::uint8_t *p = ANB_blob_peek(b_, &len);
+        return {p, len};
+    }
+    void consume(std::size_t n) { ANB_blob_consume(b_, n); }
+    void compact() { ANB_blob_compact(b_); }
+    void set_compact(std::uint32_t pct) { ANB_blob_set_compact(b_, pct); }
+
+    std::uint8_t *data() const { return ANB_blob_data(b_); }
+    /** @brief Bytes written (ANB_blob_data_len). */
+    std::size_t size() const { return ANB_blob_data_len(b_); }
+    std::size_t capacity() const { return ANB_blob_capacity(b_); }
+    bool empty() const { return size() == 0; }
+    /** @brief The written bytes. */
+    std::span<std::uint8_t> bytes() const { return {data(), size()}; }
+
+    bool grow(std::size_t bytes) { return ANB_blob_alloc(b_, bytes) == 0; }
+    bool resize_capacity(std::size_t n) { return ANB_blob_realloc(b_, n) == 0; }
+    void reset() { ANB_blob_reset(b_); }
+    void clear() { ANB_blob_clear(b_); }
+    void trim() { ANB_blob_trim(b_); }
+    void set_growth(const ANB_GrowthPolicy_t &p) { ANB_blob_set_growth(b_, &p); }
+    void set_trim(const ANB_TrimPolicy_t &p) { ANB_blob_set_trim(b_, &p); }
+
+    std::uint8_t *begin() const { return data(); }
+    std::uint8_t *end() const { return data() + size(); }
+
+private:
+    struct Adopt {};
+    Blob(ANB_Blob_t *b, Adopt) noexcept : b_(b) {}
+
+    ANB_Blob_t *b_;
+};
+
+} // namespace anb
@@ -0,0 +1,185 @@
+#pragma once
+/**
+ * @file anb_pmr.hpp
+ * @brief std::pmr::memory_resource adapters over ANB_Slab.
+ */
+
+/**
+ * @defgroup ANB_Pmr ANB pmr resources
+ * @brief Let std::pmr containers draw from slab memory.
+ *
+ * anb::SlabResource is a monotonic bump resource: deallocate is a no-op and
+ * everything is released at once. anb::SlabPoolResource hands out fixed-size
+ * blocks from one preallocated slab and recycles them through a free list.
+ * Neither is thread-safe, same as the slab itself.
+ */
+#include "anb.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace anb {
+
+namespace detail {
+inline constexpr std::size_t slab_align = alignof(std::max_align_t);
+
+inline constexpr std::size_t align_up(std::size_t n, std::size_t a) noexcept { return (n + a - 1) & ~(a - 1); }
+} // namespace detail
+
+/**
+ * @ingroup ANB_Pmr
+ * @brief Monotonic memory resource backed by a chain of slabs.
+ *
+ * Each allocation is one slab item. A slab never grows while it holds
+ * allocations, because growth would move memory already handed out; when
+ * the current slab is full a new one of at least twice the size is chained.
+ * release() drops every allocation in one shot and folds the chain into a
+ * single slab sized for the whole previous cycle, so a steady workload ends
+ * up in one buffer with no allocator calls at all.
+ */
+class SlabResource : public std::pmr::memory_resource {
+public:
+    /**
+     * @param initial_size Capacity of the first slab in bytes.
+     * @param flags ANB_MEM_* flags applied to every slab in the chain.
+     */
+    explicit SlabResource(std::size_t initial_size = 4096, unsigned flags = 0)
+        : flags_(flags) {
+        chain_.emplace_back(initial_size ? initial_size : 1, flags_);
+    }
+
+    SlabResource(const SlabResource &) = delete;
+    SlabResource &operator=(const SlabResource &) = delete;
+
+    /** @brief Free every allocation. Containers using this resource must be gone or unused. */
+    void release() {
+        if (chain_.size() > 1) {
+            std::size_t total = 0;
+            for (const Slab &s : chain_) total += s.capacity();
+            chain_.clear();
+            chain_.emplace_back(total, flags_);
+        } else {
+            chain_.back().reset();
+        }
+    }
+
+    /** @brief Bytes currently handed out, including per-item alignment padding. */
+    std::size_t bytes_used() const noexcept {
+        std::size_t n = 0;
+        for (const Slab &s : chain_) n += s.bytes_used();
+        return n;
+    }
+
+    /** @brief Number of slabs in the chain (1 once the workload has settled). */
+    std::size_t slab_count() const noexcept { return chain_.size(); }
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t align) override {
+        // Items are max_align_t aligned; over-allocate to honour stricter requests
+        std::size_t extra = align > detail::slab_align ? align - detail::slab_align : 0;
+        std::size_t need = detail::align_up((bytes ? bytes : 1) + extra, detail::slab_align);
+
+        Slab *s = &chain_.back();
+        if (s->capacity() - s->bytes_used() < need) {
+            std::size_t cap = s->capacity() * 2;
+            chain_.emplace_back(cap > need ? cap : need, flags_);
+            s = &chain_.back();
+        }
+        auto p = reinterpret_cast<std::uintptr_t>(s->alloc(need));
+        return reinterpret_cast<void *>(extra ? detail::align_up(p, align) : p);
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    unsigned flags_;
+    std::vector<Slab> chain_;
+};
+
+/**
+ * @ingroup ANB_Pmr
+ * @brief Pool of fixed-size blocks carved from one slab that never grows.
+ *
+ * Requests up to block_size bytes (and max_align_t alignment) are served
+ * from the slab: first from the free list, then by allocating a new item
+ * while the slab has room. Larger requests, over-aligned requests and
+ * requests once all block_count blocks are in use go to the upstream
+ * resource. Freed blocks go back on an intrusive free list.
+ */
+class SlabPoolResource : public std::pmr::memory_resource {
+public:
+    /**
+     * @param block_size Size of each block in bytes (rounded up to max_align_t).
+     * @param block_count Number of blocks the slab holds.
+     * @param flags ANB_MEM_* flags for the slab.
+     * @param upstream Resource for requests the pool cannot serve.
+     * @note Do not set a trim policy on the pool's slab; blocks must stay put.
+     */
+    SlabPoolResource(std::size_t block_size, std::size_t block_count, unsigned flags = 0,
+                     std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : block_(detail::align_up(block_size ? block_size : 1, detail::slab_align)),
+          slab_(block_ * (block_count ? block_count : 1), flags),
+          base_(nullptr),
+          upstream_(upstream) {}
+
+    SlabPoolResource(const SlabPoolResource &) = delete;
+    SlabPoolResource &operator=(const SlabPoolResource &) = delete;
+
+    /**
+     * @brief Return every block to the pool at once.
+     * @note Only slab blocks are reclaimed; upstream allocations must still be
+     *       deallocated individually.
+     */
+    void release() {
+        slab_.reset();
+        free_ = nullptr;
+    }
+
+    std::size_t block_size() const noexcept { return block_; }
+    std::pmr::memory_resource *upstream_resource() const noexcept { return upstream_; }
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t align) override {
+        if (bytes <= block_ && align <= detail::slab_align) {
+            if (free_) {
+                FreeBlock *b = free_;
+                free_ = b->next;
+                return b;
+            }
+            if (slab_.capacity() - slab_.bytes_used() >= block_) {
+                std::uint8_t *p = slab_.alloc(block_);
+                if (!base_) base_ = p;
+                return p;
+            }
+        }
+        return upstream_->allocate(bytes, align);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t align) override {
+        auto *u = static_cast<std::uint8_t *>(p);
+        if (base_ && u >= base_ && u < base_ + slab_.capacity()) {
+            free_ = ::new (p) FreeBlock{free_};
+            return;
+        }
+        upstream_->deallocate(p, bytes, align);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    std::size_t block_;
+    Slab slab_;
+    std::uint8_t *base_;
+    std::pmr::memory_resource *upstream_;
+    FreeBlock *free_ = nullptr;
+};
+
+} // namespace anb
@@ -10,6 +10,12 @@
  */
 #include <stdint.h>
 #include <stdlib.h>
+#include "growth.h"
+#include "memflags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /**
  * @ingroup ANB_Blob
@@ -21,18 +27,96 @@
  */
 typedef struct ANB_Blob ANB_Blob_t;
 
+/** @ingroup ANB_Blob
+ *  @brief Bytes stored inside the handle itself. Blobs created with at most
+ *         this capacity need a single allocation until they grow past it. */
+#define ANB_BLOB_INLINE_SIZE 192
+
 /**
  * @ingroup ANB_Blob
  * @brief Create a new blob buffer.
  * @param initial_size Initial capacity in bytes. Must be > 0.
  * @return Pointer to the new blob. Aborts on allocation failure.
+ * @note Up to ANB_BLOB_INLINE_SIZE bytes are stored inside the handle; the
+ *       data moves to the heap on the first growth past that.
  */
 ANB_Blob_t* ANB_blob_create(size_t initial_size);
 
+/**
+ * @ingroup ANB_Blob
+ * @brief Create a blob whose handle and initial buffer share one allocation.
+ * @param initial_size Initial capacity in bytes. Must be > 0.
+ * @return Pointer to the new blob. Aborts on allocation failure.
+ * @note Growth past initial_size moves the data to its own heap buffer; the
+ *       initial region stays allocated with the handle until destroy. Sizes
+ *       that would be mapped (see ANB_blob_create) are created normally.
+ */
+ANB_Blob_t* ANB_blob_create_compact(size_t initial_size);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Create a new blob buffer with creation flags.
+ * @param initial_size Initial capacity in bytes. Must be > 0.
+ * @param flags Bitwise OR of ANB_MEM_* flags from memflags.h, or 0.
+ * @return Pointer to the new blob. Aborts on allocation failure, on an
+ *         unknown flag, or if ANB_MEM_MLOCK cannot lock the buffer.
+ * @note Any flag forces the buffer onto an anonymous mapping.
+ */
+ANB_Blob_t* ANB_blob_create_ex(size_t initial_size, unsigned flags);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Build a blob inside caller-provided storage, without any heap allocation.
+ * @param buf Storage for the blob header and data, e.g. a stack array or a
+ *            static or shared region. Any alignment.
+ * @param len Size of buf in bytes.
+ * @param flags 0, or a bitwise OR of ANB_MEM_SPILL and ANB_MEM_SECURE.
+ * @return The blob (located inside buf), or NULL if buf is NULL, too small or
+ *         flags are not supported.
+ * @note Once the storage is full, push, alloc and realloc return -1 instead
+ *       of growing, and the blob is left unchanged. With ANB_MEM_SPILL the
+ *       blob moves to a heap buffer and keeps growing as usual. Trim never
+ *       shrinks caller storage. Call ANB_blob_destroy when done if
+ *       ANB_MEM_SPILL or ANB_MEM_SECURE is set.
+ */
+ANB_Blob_t* ANB_blob_init_in(void *buf, size_t len, unsigned flags);
+
+/** @ingroup ANB_Blob
+ *  @brief ANB_blob_map_file: map the file private and writable. Writes through
+ *         ANB_blob_data stay in this process and never reach the file. */
+#define ANB_BLOB_MAP_PRIVATE (1u << 8)
+
+/** @ingroup ANB_Blob
+ *  @brief ANB_blob_map_file: the file will be read in random order; disable
+ *         read-ahead (MADV_RANDOM) instead of hinting a sequential scan. */
+#define ANB_BLOB_MAP_RANDOM  (1u << 9)
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Create a blob that views a file through mmap, without reading it.
+ * @param path File to map. Must be a regular file.
+ * @param flags 0, or a bitwise OR of ANB_BLOB_MAP_PRIVATE, ANB_BLOB_MAP_RANDOM
+ *              and ANB_MEM_PREFAULT (populate every page up front).
+ * @return The blob, with data_len and capacity set to the file size, or NULL
+ *         with errno set if the file cannot be opened or mapped (EINVAL for a
+ *         non-regular file or unsupported flags). An empty file gives an
+ *         empty heap blob.
+ * @note By default the view is shared and read-only: pages come straight
+ *       from the page cache and are hinted for sequential read-ahead. The
+ *       first push, reserve or resize copies the contents to an owned
+ *       buffer, and clear swaps the view for zeroed memory; peek and consume
+ *       never copy. Writing through ANB_blob_data
+ *       before that faults; use ANB_BLOB_MAP_PRIVATE to write in place.
+ *       Changes to the file by other processes show through the mapping, and
+ *       truncating it while mapped raises SIGBUS on access.
+ */
+ANB_Blob_t* ANB_blob_map_file(const char *path, unsigned flags);
+
 /**
  * @ingroup ANB_Blob
  * @brief Destroy a blob buffer and free its memory.
  * @param blob The blob to destroy. Safe to pass NULL.
+ * @note For a blob from ANB_blob_init_in, frees only a buffer it spilled to.
  */
 void ANB_blob_destroy(ANB_Blob_t* blob);
 
@@ -45,6 +129,35 @@ void ANB_blob_destroy(ANB_Blob_t* blob);
  */
 uint8_t* ANB_blob_data(ANB_Blob_t* blob);
 
+/**
+ * @ingroup ANB_Blob
+ * @brief Set the growth policy used by ANB_blob_push and ANB_blob_alloc(blob, 0).
+ * @param blob The blob. Must not be NULL.
+ * @param policy The policy to copy into the blob. NULL restores ANB_GROWTH_DEFAULT.
+ *               Aborts if its round_to is not 0, 1 or a power of two.
+ */
+void ANB_blob_set_growth(ANB_Blob_t* blob, const ANB_GrowthPolicy_t *policy);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Set the automatic trim policy evaluated on ANB_blob_reset and ANB_blob_clear.
+ * @param blob The blob. Must not be NULL.
+ * @param policy The policy to copy into the blob. NULL disables automatic trim (the default).
+ * @warning Usage is measured by the write position, so bytes written directly
+ *          through ANB_blob_data beyond ANB_blob_data_len may be discarded.
+ */
+void ANB_blob_set_trim(ANB_Blob_t* blob, const ANB_TrimPolicy_t *policy);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Shrink the blob capacity to its current data length.
+ * @param blob The blob. Must not be NULL.
+ * @note Capacity never goes below the initial capacity. Bytes beyond
+ *       ANB_blob_data_len are lost.
+ * @warning Any pointer previously returned by ANB_blob_data may be invalidated.
+ */
+void ANB_blob_trim(ANB_Blob_t* blob);
+
 /**
  * @ingroup ANB_Blob
  * @brief Get the total capacity of the blob buffer.
@@ -57,26 +170,38 @@ size_t ANB_blob_capacity(ANB_Blob_t* blob);
  * @ingroup ANB_Blob
  * @brief Grow the blob buffer by adding bytes to its capacity.
  * @param blob The blob. Must not be NULL.
- * @param bytes Number of bytes to add. If 0, doubles the current capacity.
+ * @param bytes Number of bytes to add exactly. If 0, grows by one step of the
+ *              blob's growth policy (doubling by default).
+ * @return 0 on success, -1 if the blob lives in full caller storage.
  * @note Aborts on allocation failure or if the new capacity would overflow.
  * @warning Any pointer previously returned by ANB_blob_data may be invalidated.
  */
-void ANB_blob_alloc(ANB_Blob_t* blob, size_t bytes);
+int ANB_blob_alloc(ANB_Blob_t* blob, size_t bytes);
 
 /**
  * @ingroup ANB_Blob
  * @brief Set the blob buffer to an exact capacity, shrinking or growing as needed.
  * @param blob The blob. Must not be NULL.
  * @param new_capacity The desired capacity in bytes. Must be > 0.
+ * @return 0 on success, -1 if the blob lives in caller storage that cannot
+ *         take the new capacity (growth past it without ANB_MEM_SPILL).
  * @note Aborts on allocation failure. Shrinking may lose data beyond the new size.
  * @warning Any pointer previously returned by ANB_blob_data may be invalidated.
  */
-void ANB_blob_realloc(ANB_Blob_t* blob, size_t new_capacity);
+int ANB_blob_realloc(ANB_Blob_t* blob, size_t new_capacity);
 
 /**
  * @ingroup ANB_Blob
- * @brief Zero the entire blob buffer and reset the write position to 0.
+ * @brief Zero the blob buffer and reset the write position to 0.
  * @param blob The blob. Must not be NULL.
+ * @note Only the bytes up to the highest position ever pushed or committed
+ *       since the previous clear are zeroed; the rest is already zero. Bytes
+ *       stored through ANB_blob_data past the write position, or into a
+ *       reserved tail that was never committed, are not tracked. Large ranges
+ *       of a mapped buffer are returned to the kernel instead of being written.
+ *       Blobs with ANB_MEM_SECURE always wipe the full capacity. A read-only
+ *       file view, or a buffer that slices still see, is left alone and the
+ *       blob gets a fresh buffer of the same capacity without copying.
  */
 void ANB_blob_clear(ANB_Blob_t* blob);
 
@@ -86,10 +211,34 @@ void ANB_blob_clear(ANB_Blob_t* blob);
  * @param blob The blob. Must not be NULL.
  * @param bytes Pointer to data to copy.
  * @param len Number of bytes to copy.
- * @note Auto-grows the buffer (doubling) if needed. Aborts on allocation failure.
+ * @return 0 on success, -1 if the blob lives in full caller storage (nothing is written).
+ * @note Auto-grows the buffer by the blob's growth policy if needed. Aborts on allocation failure.
+ * @warning Any pointer previously returned by ANB_blob_data may be invalidated.
+ */
+int ANB_blob_push(ANB_Blob_t* blob, const uint8_t* bytes, size_t len);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Get a writable tail of at least min_len bytes without copying anything into it.
+ * @param blob The blob. Must not be NULL.
+ * @param min_len Bytes the tail must hold. Grows the buffer by the growth
+ *                policy if needed. 0 returns whatever is free without growing.
+ * @param avail If non-NULL, receives the full size of the tail (>= min_len).
+ * @return Pointer to the byte at the write position, or NULL if the blob
+ *         lives in full caller storage (ANB_blob_init_in without ANB_MEM_SPILL).
+ * @note Write into the tail (read(), recv(), an encoder), then publish the
+ *       bytes with ANB_blob_commit. Nothing is visible in data_len until then.
  * @warning Any pointer previously returned by ANB_blob_data may be invalidated.
  */
-void ANB_blob_push(ANB_Blob_t* blob, const uint8_t* bytes, size_t len);
+uint8_t *ANB_blob_reserve(ANB_Blob_t* blob, size_t min_len, size_t *avail);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Advance the write position over bytes written into a reserved tail.
+ * @param blob The blob. Must not be NULL.
+ * @param n Bytes to publish. Aborts if n exceeds the free space after the write position.
+ */
+void ANB_blob_commit(ANB_Blob_t* blob, size_t n);
 
 /**
  * @ingroup ANB_Blob
@@ -104,5 +253,95 @@ size_t ANB_blob_data_len(ANB_Blob_t* blob);
  * @brief Reset the write position to 0 without clearing buffer contents.
  * @param blob The blob. Must not be NULL.
  * @note Subsequent pushes will overwrite existing data from the beginning.
+ *       Blobs created with ANB_MEM_SECURE wipe the written bytes instead of keeping them.
  */
 void ANB_blob_reset(ANB_Blob_t* blob);
+
+/** @ingroup ANB_Blob
+ *  @brief Default auto-compaction threshold, in percent of capacity (see ANB_blob_set_compact). */
+#define ANB_BLOB_COMPACT_DEFAULT 50
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Get the unread bytes between the read cursor and the write position.
+ * @param blob The blob. Must not be NULL.
+ * @param len If non-NULL, receives the number of unread bytes.
+ * @return Pointer to the first unread byte.
+ * @warning Invalidated by anything that may grow or compact the blob.
+ */
+uint8_t *ANB_blob_peek(ANB_Blob_t* blob, size_t *len);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Advance the read cursor over n bytes.
+ * @param blob The blob. Must not be NULL.
+ * @param n Bytes consumed. Aborts if more than are unread.
+ * @note Consuming the last unread byte resets the blob (as ANB_blob_reset)
+ *       without moving any data. Otherwise, once the consumed prefix reaches
+ *       the compaction threshold, the unread bytes are moved to the front.
+ */
+void ANB_blob_consume(ANB_Blob_t* blob, size_t n);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Move the unread bytes to the front of the buffer, dropping the consumed prefix.
+ * @param blob The blob. Must not be NULL.
+ * @note No-op when nothing has been consumed. The write position moves back
+ *       by the number of consumed bytes.
+ */
+void ANB_blob_compact(ANB_Blob_t* blob);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Set when the blob compacts on its own.
+ * @param blob The blob. Must not be NULL.
+ * @param pct Compact in ANB_blob_consume once the consumed prefix reaches
+ *            pct percent of capacity. Pushes and reserves that would grow the
+ *            buffer also compact first. 0 disables both; ANB_blob_compact
+ *            still works. Default ANB_BLOB_COMPACT_DEFAULT.
+ */
+void ANB_blob_set_compact(ANB_Blob_t* blob, uint32_t pct);
+
+/** @ingroup ANB_Blob
+ *  @brief Returned by the ANB_blob_find functions when there is no match. */
+#define ANB_BLOB_NPOS ((size_t)-1)
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Find the first occurrence of a byte in the unread bytes.
+ * @param blob The blob. Must not be NULL.
+ * @param offset Where to start, relative to the read cursor.
+ * @param byte Byte to look for.
+ * @return Offset of the match relative to the read cursor, or ANB_BLOB_NPOS.
+ */
+size_t ANB_blob_find_byte(ANB_Blob_t* blob, size_t offset, uint8_t byte);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Find the first unread byte that is any of a set of bytes.
+ * @param blob The blob. Must not be NULL.
+ * @param offset Where to start, relative to the read cursor.
+ * @param set Bytes to look for, e.g. CR and LF. Must not be NULL if set_len > 0.
+ * @param set_len Number of bytes in set. 0 never matches.
+ * @return Offset of the match relative to the read cursor, or ANB_BLOB_NPOS.
+ * @note Sets of up to 8 bytes are compared 16 or 32 bytes at a time (SSE2
+ *       or AVX2, picked at run time). Larger sets use a lookup table.
+ */
+size_t ANB_blob_find_any(ANB_Blob_t* blob, size_t offset, const uint8_t *set, size_t set_len);
+
+/**
+ * @ingroup ANB_Blob
+ * @brief Find the first occurrence of a byte string in the unread bytes.
+ * @param blob The blob. Must not be NULL.
+ * @param offset Where to start, relative to the read cursor.
+ * @param pattern Bytes to look for, e.g. CR LF CR LF. Must not be NULL if len > 0.
+ * @param len Length of pattern. An empty pattern matches at offset.
+ * @return Offset of the match relative to the read cursor, or ANB_BLOB_NPOS.
+ * @note Candidates are found by comparing the first and last pattern byte
+ *       16 or 32 positions at a time (SSE2 or AVX2, picked at run time).
+ */
+size_t ANB_blob_find(ANB_Blob_t* blob, size_t offset, const uint8_t *pattern, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,466 @@
+#pragma once
+/**
+ * @file blob_codec.h
+ * @brief ANB_BlobCodec public API — typed binary encoding into and decoding out of blobs.
+ */
+
+/**
+ * @defgroup ANB_BlobCodec ANB_Blob binary codec
+ * @brief Fixed-width integers and floats in either byte order, LEB128 and
+ *        zigzag varints, length-prefixed byte strings and Stream VByte
+ *        integer arrays.
+ *
+ * A writer reserves the worst-case size of a batch of fields once
+ * (ANB_blob_writer_begin); the put functions then store without any bounds
+ * check and ANB_blob_writer_end publishes what was written. A reader views
+ * the unread bytes of a blob; ANB_blob_reader_need checks a batch of
+ * fixed-width fields once, variable-length fields check themselves and
+ * record a sticky error, and ANB_blob_reader_end consumes the bytes read
+ * only if every check passed. The field functions are inline so an encode
+ * loop compiles down to plain stores.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "blob.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Largest encoding of a 64-bit LEB128 varint in bytes. */
+#define ANB_CODEC_VARINT_MAX 10
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Worst-case size of a Stream VByte block of count 32-bit integers.
+ */
+#define ANB_CODEC_SVB_BOUND(count) (((size_t)(count) + 3) / 4 + (size_t)(count) * 4)
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Write cursor over a reserved blob tail. Fields are private.
+ */
+typedef struct ANB_BlobWriter {
+    ANB_Blob_t *_blob;
+    uint8_t *_start;  /* reserved tail */
+    uint8_t *_p;      /* next byte to write */
+    uint8_t *_end;    /* end of the reserved tail */
+} ANB_BlobWriter_t;
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Read cursor over the unread bytes of a blob. Fields are private.
+ */
+typedef struct ANB_BlobReader {
+    ANB_Blob_t *_blob;
+    const uint8_t *_start; /* first unread byte at begin */
+    const uint8_t *_p;     /* next byte to read */
+    const uint8_t *_end;   /* write position at begin */
+    int _err;              /* set by the first failed check */
+} ANB_BlobReader_t;
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Start a batch of writes, reserving max_len bytes at the write position.
+ * @param w Writer to initialize.
+ * @param blob The blob. Must not be NULL.
+ * @param max_len Upper bound of the bytes the batch writes (fixed sizes,
+ *                ANB_CODEC_VARINT_MAX per varint, ANB_CODEC_SVB_BOUND per array).
+ * @return 0 on success, -1 if the blob lives in caller storage without room.
+ * @warning Writing more than max_len bytes is undefined behaviour; ANB_blob_writer_end
+ *          aborts if it notices. Do not touch the blob until ANB_blob_writer_end.
+ */
+int ANB_blob_writer_begin(ANB_BlobWriter_t *w, ANB_Blob_t *blob, size_t max_len);
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Publish the bytes written since ANB_blob_writer_begin (as ANB_blob_commit).
+ * @param w The writer.
+ * @return Bytes written.
+ */
+size_t ANB_blob_writer_end(ANB_BlobWriter_t *w);
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Start reading the unread bytes of a blob.
+ * @param r Reader to initialize.
+ * @param blob The blob. Must not be NULL. Must not be modified until ANB_blob_reader_end.
+ */
+void ANB_blob_reader_begin(ANB_BlobReader_t *r, ANB_Blob_t *blob);
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Finish reading; consume the bytes read if no check failed.
+ * @param r The reader.
+ * @return Bytes consumed, or -1 if a check failed, in which case nothing is
+ *         consumed (e.g. to retry once more bytes have arrived).
+ */
+long long ANB_blob_reader_end(ANB_BlobReader_t *r);
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Encode count 32-bit integers as Stream VByte: control bytes, then 1 to 4 data bytes each.
+ * @param in Values to encode.
+ * @param count Number of values.
+ * @param out Destination of at least ANB_CODEC_SVB_BOUND(count) bytes.
+ * @return Bytes written.
+ * @note Uses SSSE3 when the CPU has it (checked once at run time).
+ */
+size_t ANB_codec_svb_encode(const uint32_t *in, size_t count, uint8_t *out);
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Decode count 32-bit integers from a Stream VByte block.
+ * @param in Encoded block.
+ * @param in_len Bytes available at in.
+ * @param out Destination for count values.
+ * @param count Number of values in the block.
+ * @return Bytes the block occupies, or 0 if in_len is too short (out is then
+ *         unspecified). An empty block (count 0) also occupies 0 bytes.
+ * @note Uses SSSE3 when the CPU has it (checked once at run time).
+ */
+size_t ANB_codec_svb_decode(const uint8_t *in, size_t in_len, uint32_t *out, size_t count);
+
+/* ------------------------------------------------------------------ */
+/* Writer fields: no bounds checks, covered by ANB_blob_writer_begin  */
+/* ------------------------------------------------------------------ */
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put one byte. */
+static inline void ANB_blob_put_u8(ANB_BlobWriter_t *w, uint8_t v) {
+    *w->_p++ = v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put a 16-bit integer, least significant byte first. */
+static inline void ANB_blob_put_u16le(ANB_BlobWriter_t *w, uint16_t v) {
+    uint8_t *p = w->_p;
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    w->_p = p + 2;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put a 16-bit integer, most significant byte first. */
+static inline void ANB_blob_put_u16be(ANB_BlobWriter_t *w, uint16_t v) {
+    uint8_t *p = w->_p;
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+    w->_p = p + 2;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put a 32-bit integer, least significant byte first. */
+static inline void ANB_blob_put_u32le(ANB_BlobWriter_t *w, uint32_t v) {
+    uint8_t *p = w->_p;
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+    w->_p = p + 4;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put a 32-bit integer, most significant byte first. */
+static inline void ANB_blob_put_u32be(ANB_BlobWriter_t *w, uint32_t v) {
+    uint8_t *p = w->_p;
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (24 - 8 * i));
+    w->_p = p + 4;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put a 64-bit integer, least significant byte first. */
+static inline void ANB_blob_put_u64le(ANB_BlobWriter_t *w, uint64_t v) {
+    uint8_t *p = w->_p;
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+    w->_p = p + 8;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put a 64-bit integer, most significant byte first. */
+static inline void ANB_blob_put_u64be(ANB_BlobWriter_t *w, uint64_t v) {
+    uint8_t *p = w->_p;
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (56 - 8 * i));
+    w->_p = p + 8;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put an IEEE 754 single as its bit pattern, least significant byte first. */
+static inline void ANB_blob_put_f32le(ANB_BlobWriter_t *w, float v) {
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    ANB_blob_put_u32le(w, u);
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put an IEEE 754 single as its bit pattern, most significant byte first. */
+static inline void ANB_blob_put_f32be(ANB_BlobWriter_t *w, float v) {
+    uint32_t u;
+    memcpy(&u, &v, sizeof(u));
+    ANB_blob_put_u32be(w, u);
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put an IEEE 754 double as its bit pattern, least significant byte first. */
+static inline void ANB_blob_put_f64le(ANB_BlobWriter_t *w, double v) {
+    uint64_t u;
+    memcpy(&u, &v, sizeof(u));
+    ANB_blob_put_u64le(w, u);
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put an IEEE 754 double as its bit pattern, most significant byte first. */
+static inline void ANB_blob_put_f64be(ANB_BlobWriter_t *w, double v) {
+    uint64_t u;
+    memcpy(&u, &v, sizeof(u));
+    ANB_blob_put_u64be(w, u);
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put an unsigned LEB128 varint (1 to ANB_CODEC_VARINT_MAX bytes). */
+static inline void ANB_blob_put_varint(ANB_BlobWriter_t *w, uint64_t v) {
+    uint8_t *p = w->_p;
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    w->_p = p;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put a signed integer as a zigzag-mapped LEB128 varint, so small magnitudes stay short. */
+static inline void ANB_blob_put_svarint(ANB_BlobWriter_t *w, int64_t v) {
+    ANB_blob_put_varint(w, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put raw bytes. */
+static inline void ANB_blob_put_bytes(ANB_BlobWriter_t *w, const void *bytes, size_t len) {
+    if (len) memcpy(w->_p, bytes, len);
+    w->_p += len;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put a byte string prefixed with its length as a varint. Reserve len + ANB_CODEC_VARINT_MAX. */
+static inline void ANB_blob_put_lpbytes(ANB_BlobWriter_t *w, const void *bytes, size_t len) {
+    ANB_blob_put_varint(w, len);
+    ANB_blob_put_bytes(w, bytes, len);
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Put count 32-bit integers as a Stream VByte block. Reserve ANB_CODEC_SVB_BOUND(count).
+ *  @note The count itself is not stored; put it first (e.g. as a varint). */
+static inline void ANB_blob_put_svb(ANB_BlobWriter_t *w, const uint32_t *values, size_t count) {
+    w->_p += ANB_codec_svb_encode(values, count, w->_p);
+}
+
+/* ------------------------------------------------------------------ */
+/* Reader fields                                                      */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Check that n more bytes are unread; call before a batch of fixed-width gets.
+ * @return 1 if they are, 0 otherwise (the reader's error is set).
+ */
+static inline int ANB_blob_reader_need(ANB_BlobReader_t *r, size_t n) {
+    if ((size_t)(r->_end - r->_p) >= n) return 1;
+    r->_err = 1;
+    return 0;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get the number of bytes left to read. */
+static inline size_t ANB_blob_reader_left(const ANB_BlobReader_t *r) {
+    return (size_t)(r->_end - r->_p);
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Check whether any check of the reader has failed. */
+static inline int ANB_blob_reader_failed(const ANB_BlobReader_t *r) {
+    return r->_err;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get one byte. Unchecked: cover it with ANB_blob_reader_need. */
+static inline uint8_t ANB_blob_get_u8(ANB_BlobReader_t *r) {
+    return *r->_p++;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a little-endian 16-bit integer. Unchecked. */
+static inline uint16_t ANB_blob_get_u16le(ANB_BlobReader_t *r) {
+    const uint8_t *p = r->_p;
+    uint16_t v = (uint16_t)(p[0] | (p[1] << 8));
+    r->_p = p + 2;
+    return v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a big-endian 16-bit integer. Unchecked. */
+static inline uint16_t ANB_blob_get_u16be(ANB_BlobReader_t *r) {
+    const uint8_t *p = r->_p;
+    uint16_t v = (uint16_t)((p[0] << 8) | p[1]);
+    r->_p = p + 2;
+    return v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a little-endian 32-bit integer. Unchecked. */
+static inline uint32_t ANB_blob_get_u32le(ANB_BlobReader_t *r) {
+    const uint8_t *p = r->_p;
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)p[i] << (8 * i);
+    r->_p = p + 4;
+    return v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a big-endian 32-bit integer. Unchecked. */
+static inline uint32_t ANB_blob_get_u32be(ANB_BlobReader_t *r) {
+    const uint8_t *p = r->_p;
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v = (v << 8) | p[i];
+    r->_p = p + 4;
+    return v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a little-endian 64-bit integer. Unchecked. */
+static inline uint64_t ANB_blob_get_u64le(ANB_BlobReader_t *r) {
+    const uint8_t *p = r->_p;
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= (uint64_t)p[i] << (8 * i);
+    r->_p = p + 8;
+    return v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a big-endian 64-bit integer. Unchecked. */
+static inline uint64_t ANB_blob_get_u64be(ANB_BlobReader_t *r) {
+    const uint8_t *p = r->_p;
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v = (v << 8) | p[i];
+    r->_p = p + 8;
+    return v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a little-endian IEEE 754 single. Unchecked. */
+static inline float ANB_blob_get_f32le(ANB_BlobReader_t *r) {
+    uint32_t u = ANB_blob_get_u32le(r);
+    float v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a big-endian IEEE 754 single. Unchecked. */
+static inline float ANB_blob_get_f32be(ANB_BlobReader_t *r) {
+    uint32_t u = ANB_blob_get_u32be(r);
+    float v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a little-endian IEEE 754 double. Unchecked. */
+static inline double ANB_blob_get_f64le(ANB_BlobReader_t *r) {
+    uint64_t u = ANB_blob_get_u64le(r);
+    double v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a big-endian IEEE 754 double. Unchecked. */
+static inline double ANB_blob_get_f64be(ANB_BlobReader_t *r) {
+    uint64_t u = ANB_blob_get_u64be(r);
+    double v;
+    memcpy(&v, &u, sizeof(v));
+    return v;
+}
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Get an unsigned LEB128 varint. Checked.
+ * @return The value, or 0 with the reader's error set if the varint is
+ *         truncated, longer than ANB_CODEC_VARINT_MAX bytes, or does not
+ *         fit 64 bits.
+ */
+static inline uint64_t ANB_blob_get_varint(ANB_BlobReader_t *r) {
+    const uint8_t *p = r->_p;
+    const uint8_t *end = r->_end;
+    if (end - p > ANB_CODEC_VARINT_MAX) end = p + ANB_CODEC_VARINT_MAX;
+    uint64_t v = 0;
+    for (unsigned shift = 0; p < end; shift += 7) {
+        uint8_t byte = *p++;
+        if (shift == 63 && byte > 1) break; // Only bit 63 is left for the tenth byte
+        v |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            r->_p = p;
+            return v;
+        }
+    }
+    r->_err = 1;
+    return 0;
+}
+
+/** @ingroup ANB_BlobCodec
+ *  @brief Get a zigzag-mapped signed varint. Checked as ANB_blob_get_varint. */
+static inline int64_t ANB_blob_get_svarint(ANB_BlobReader_t *r) {
+    uint64_t u = ANB_blob_get_varint(r);
+    return (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+}
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Get len raw bytes in place. Checked.
+ * @return Pointer into the blob, valid until it is modified, or NULL with the
+ *         reader's error set if fewer bytes are left.
+ */
+static inline const uint8_t *ANB_blob_get_bytes(ANB_BlobReader_t *r, size_t len) {
+    if (!ANB_blob_reader_need(r, len)) return NULL;
+    const uint8_t *p = r->_p;
+    r->_p += len;
+    return p;
+}
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Get a varint-length-prefixed byte string in place. Checked.
+ * @param r The reader.
+ * @param len Receives the string length.
+ * @return Pointer into the blob, or NULL with the reader's error set (len is then 0).
+ */
+static inline const uint8_t *ANB_blob_get_lpbytes(ANB_BlobReader_t *r, size_t *len) {
+    uint64_t n = ANB_blob_get_varint(r);
+    const uint8_t *p = NULL;
+    if (!r->_err && n <= ANB_blob_reader_left(r)) p = ANB_blob_get_bytes(r, (size_t)n);
+    else r->_err = 1;
+    *len = p ? (size_t)n : 0;
+    return p;
+}
+
+/**
+ * @ingroup ANB_BlobCodec
+ * @brief Get count 32-bit integers from a Stream VByte block. Checked.
+ * @param r The reader.
+ * @param values Destination for count values.
+ * @param count Number of values in the block.
+ * @return 1 on success, 0 with the reader's error set if the block is truncated.
+ */
+static inline int ANB_blob_get_svb(ANB_BlobReader_t *r, uint32_t *values, size_t count) {
+    if (r->_err) return 0;
+    size_t n = ANB_codec_svb_decode(r->_p, ANB_blob_reader_left(r), values, count);
+    if (!n && count) {
+        r->_err = 1;
+        return 0;
+    }
+    r->_p += n;
+    return 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+/**
+ * @file blob_digest.h
+ * @brief Running checksum of the bytes written into an ANB_Blob.
+ */
+
+/**
+ * @defgroup ANB_BlobDigest ANB_Blob digest
+ * @brief Checksum blob contents while they are written, not in a second pass.
+ *
+ * With a digest set, ANB_blob_push hashes the bytes it copies and
+ * ANB_blob_commit hashes the bytes it publishes, so every write path
+ * (including ANB_blob_read_fd and the codec writer) is covered while the
+ * data is still in cache. ANB_blob_digest then returns the value at once.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include "blob.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @ingroup ANB_BlobDigest
+ *  @brief No digest (default). */
+#define ANB_DIGEST_NONE   0
+/** @ingroup ANB_BlobDigest
+ *  @brief CRC-32C (Castagnoli), as in iSCSI, ext4 and SCTP. Uses the SSE4.2 crc32 instruction when available. */
+#define ANB_DIGEST_CRC32C 1
+/** @ingroup ANB_BlobDigest
+ *  @brief 64-bit xxHash (XXH64). */
+#define ANB_DIGEST_XXH64  2
+/** @ingroup ANB_BlobDigest
+ *  @brief Caller-supplied update function (see ANB_DigestHook_t). */
+#define ANB_DIGEST_HOOK   3
+
+/**
+ * @ingroup ANB_BlobDigest
+ * @brief Update function for ANB_DIGEST_HOOK.
+ * @param ctx The spec's ctx.
+ * @param state Value returned by the previous call, or the seed on the first.
+ * @param data Bytes just written.
+ * @param len Number of bytes, > 0.
+ * @return The new state, which is also the digest value.
+ * @note Fits folding checksums directly, e.g. zlib's crc32(state, data, len) or adler32.
+ */
+typedef uint64_t (*ANB_DigestHook_t)(void *ctx, uint64_t state, const uint8_t *data, size_t len);
+
+/**
+ * @ingroup ANB_BlobDigest
+ * @brief Digest selection.
+ */
+typedef struct ANB_DigestSpec {
+    int kind;                 /**< ANB_DIGEST_NONE, ANB_DIGEST_CRC32C, ANB_DIGEST_XXH64 or ANB_DIGEST_HOOK. */
+    uint64_t seed;            /**< CRC32C: CRC of preceding data (0 to start); XXH64: seed; HOOK: initial state. */
+    ANB_DigestHook_t hook;    /**< HOOK: update function. */
+    void *ctx;                /**< HOOK: passed to hook. */
+} ANB_DigestSpec_t;
+
+/**
+ * @ingroup ANB_BlobDigest
+ * @brief Start (or stop) a running digest on a blob.
+ * @param blob The blob. Must not be NULL.
+ * @param spec Digest to run, copied into the blob. NULL or ANB_DIGEST_NONE turns it off.
+ * @note Covers bytes written after this call; data already in the blob is not
+ *       hashed. ANB_blob_reset and ANB_blob_clear restart the digest, while
+ *       consuming (even down to empty) and compaction do not affect it.
+ *       Allocates a small state block, also for blobs in caller storage.
+ *       Aborts on an unknown kind or a HOOK spec without hook.
+ */
+void ANB_blob_set_digest(ANB_Blob_t* blob, const ANB_DigestSpec_t *spec);
+
+/**
+ * @ingroup ANB_BlobDigest
+ * @brief Get the digest of the bytes written since it was set or restarted.
+ * @param blob The blob. Must not be NULL.
+ * @return The digest (a CRC32C is in the low 32 bits), or 0 without a digest.
+ */
+uint64_t ANB_blob_digest(ANB_Blob_t* blob);
+
+/**
+ * @ingroup ANB_BlobDigest
+ * @brief One-shot digest of a buffer, e.g. to verify data on the receiving side.
+ * @param spec Digest to compute. Must not be NULL.
+ * @param data Bytes to hash. May be NULL if len is 0.
+ * @param len Number of bytes.
+ * @return The same value a blob with this digest reports after pushing data.
+ */
+uint64_t ANB_digest(const ANB_DigestSpec_t *spec, const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
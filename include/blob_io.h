@@ -0,0 +1,87 @@
+#pragma once
+/**
+ * @file blob_io.h
+ * @brief File-descriptor I/O on ANB_Blob — read into, write out of, and copy through blobs.
+ */
+
+/**
+ * @defgroup ANB_BlobIO ANB_Blob fd I/O
+ * @brief Move bytes between file descriptors and blobs without a temporary buffer.
+ *
+ * Reads land at the write position through ANB_blob_reserve/ANB_blob_commit;
+ * writes take the unread bytes after the read cursor and consume what the
+ * kernel accepted. All calls work on pipes, regular files and sockets, in
+ * blocking and non-blocking mode, and retry on EINTR.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include "blob.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup ANB_BlobIO
+ * @brief Read from fd into the blob, growing it as needed.
+ * @param blob The blob. Must not be NULL.
+ * @param fd File descriptor to read from.
+ * @param max Maximum number of bytes to read. 0 means no limit.
+ * @return Bytes read (> 0), 0 at end of file, or -1 with errno set. errno is
+ *         EAGAIN if a non-blocking fd had nothing to read, and ENOBUFS if the
+ *         blob lives in caller storage (ANB_blob_init_in) and is full.
+ * @note Reads until max bytes are in, the fd would block, or a read comes
+ *       back short, so a blocking fd is never waited on twice. Each read
+ *       fills the free tail plus a 64 KiB stack buffer in one readv(); the
+ *       blob only grows by what actually arrived.
+ * @warning Any pointer previously returned by ANB_blob_data or ANB_blob_peek may be invalidated.
+ */
+ssize_t ANB_blob_read_fd(ANB_Blob_t* blob, int fd, size_t max);
+
+/**
+ * @ingroup ANB_BlobIO
+ * @brief Write the unread bytes of the blob to fd and consume them.
+ * @param blob The blob. Must not be NULL.
+ * @param fd File descriptor to write to.
+ * @return Bytes written (0 if nothing was unread), or -1 with errno set
+ *         (EAGAIN if a non-blocking fd accepted nothing).
+ * @note Keeps writing until everything is out or the fd would block. Bytes
+ *       the fd did not take stay unread for the next call. Writing to a
+ *       socket or pipe whose reader is gone raises SIGPIPE unless it is
+ *       ignored.
+ */
+ssize_t ANB_blob_write_fd(ANB_Blob_t* blob, int fd);
+
+/**
+ * @ingroup ANB_BlobIO
+ * @brief Write the unread bytes of several blobs to fd, in order, with writev().
+ * @param blobs Array of blobs. Must not be NULL; entries must not be NULL.
+ * @param count Number of blobs.
+ * @param fd File descriptor to write to.
+ * @return Total bytes written, or -1 with errno set. Same rules as ANB_blob_write_fd.
+ * @note Useful to send a header blob and a body blob in one system call.
+ */
+ssize_t ANB_blob_writev_fd(ANB_Blob_t *const *blobs, size_t count, int fd);
+
+/**
+ * @ingroup ANB_BlobIO
+ * @brief Copy bytes from in_fd to out_fd, in the kernel where possible.
+ * @param blob Bounce buffer for the fallback path. Must not be NULL.
+ * @param in_fd Source file descriptor.
+ * @param out_fd Destination file descriptor.
+ * @param max Maximum number of bytes to take from in_fd. 0 means until end of file.
+ * @return Bytes taken from in_fd (> 0), 0 at end of file, or -1 with errno set
+ *         (EAGAIN if either fd would block before anything moved).
+ * @note On Linux, splice() is used when either fd is a pipe and sendfile()
+ *       when in_fd is a regular file, so the data never reaches user space.
+ *       Anything else, or a kernel that refuses, is copied through the blob.
+ *       Unread bytes already in the blob are written first; bytes read in
+ *       the fallback that out_fd would not take stay in the blob and go out
+ *       first on the next call.
+ */
+ssize_t ANB_blob_splice_fd(ANB_Blob_t* blob, int in_fd, int out_fd, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+/**
+ * @file blob_pool.h
+ * @brief ANB_BlobPool public API — recycle blobs across requests by size class.
+ */
+
+/**
+ * @defgroup ANB_BlobPool ANB_BlobPool
+ * @brief Thread-safe pool of reusable ANB_Blob handles.
+ *
+ * Blobs are grouped in power-of-two size classes from
+ * ANB_BLOB_POOL_MIN_CLASS up to the pool's largest class. Acquire picks the
+ * smallest class that holds the requested capacity; release resets the blob
+ * and files it under the largest class its current capacity covers. Each
+ * thread keeps a few blobs per class in a private cache, so a steady
+ * acquire/release cycle on one thread never takes the pool lock.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include "blob.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup ANB_BlobPool
+ * @brief Opaque blob pool.
+ */
+typedef struct ANB_BlobPool ANB_BlobPool_t;
+
+/** @ingroup ANB_BlobPool
+ *  @brief Capacity of the smallest size class in bytes. Smaller requests are rounded up to it. */
+#define ANB_BLOB_POOL_MIN_CLASS 256
+
+/** @ingroup ANB_BlobPool
+ *  @brief Blobs per size class kept in each thread's private cache. */
+#define ANB_BLOB_POOL_THREAD_CACHE 8
+
+/**
+ * @ingroup ANB_BlobPool
+ * @brief Create a blob pool.
+ * @param max_blob_size Largest capacity that is pooled, rounded up to a power
+ *                      of two. Larger blobs are created and freed directly.
+ * @param retain_per_class Maximum bytes of idle blobs kept in the shared list
+ *                         of each size class. Blobs that do not fit are freed
+ *                         when a thread cache spills into it. 0 disables pooling.
+ * @param flags ANB_MEM_* flags passed to ANB_blob_create_ex for every pooled blob.
+ * @return Pointer to the new pool. Aborts on allocation failure or an unknown flag.
+ * @note Each thread cache also holds up to ANB_BLOB_POOL_THREAD_CACHE idle
+ *       blobs per class on top of the shared limit; they move to the shared
+ *       lists when the thread exits. Each pool uses one pthread key.
+ */
+ANB_BlobPool_t* ANB_blob_pool_create(size_t max_blob_size, size_t retain_per_class, unsigned flags);
+
+/**
+ * @ingroup ANB_BlobPool
+ * @brief Destroy a pool and every idle blob it holds, including other threads' caches.
+ * @param pool The pool to destroy. Safe to pass NULL.
+ * @note No other thread may use the pool during or after this call. Blobs
+ *       still acquired are not tracked; destroy them with ANB_blob_destroy.
+ */
+void ANB_blob_pool_destroy(ANB_BlobPool_t* pool);
+
+/**
+ * @ingroup ANB_BlobPool
+ * @brief Get an empty blob with at least min_capacity bytes of capacity.
+ * @param pool The pool. Must not be NULL.
+ * @param min_capacity Capacity needed. 0 means the smallest class.
+ * @return A blob with data_len 0. Recycled blobs keep the bytes of their
+ *         previous use beyond the write position (see ANB_blob_reset).
+ *         Aborts on allocation failure.
+ */
+ANB_Blob_t* ANB_blob_pool_acquire(ANB_BlobPool_t* pool, size_t min_capacity);
+
+/**
+ * @ingroup ANB_BlobPool
+ * @brief Return a blob to the pool.
+ * @param pool The pool. Must not be NULL.
+ * @param blob A blob from ANB_blob_pool_acquire on this pool. Safe to pass NULL.
+ * @note The blob is reset (not cleared), its digest is turned off and its
+ *       growth, trim and compaction settings are restored to the defaults. It
+ *       is freed instead of kept if its capacity is above the largest class or
+ *       the retention limit.
+ *       Releasing into the calling thread's cache takes no lock.
+ */
+void ANB_blob_pool_release(ANB_BlobPool_t* pool, ANB_Blob_t* blob);
+
+/**
+ * @ingroup ANB_BlobPool
+ * @brief Get the bytes of idle blob capacity the pool currently holds.
+ * @param pool The pool. Must not be NULL.
+ * @return Sum of the capacities of all idle blobs, thread caches included.
+ */
+size_t ANB_blob_pool_retained(ANB_BlobPool_t* pool);
+
+#ifdef __cplusplus
+}
+#endif
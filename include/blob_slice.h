@@ -0,0 +1,113 @@
+#pragma once
+/**
+ * @file blob_slice.h
+ * @brief Reference-counted, immutable views of ANB_Blob storage.
+ */
+
+/**
+ * @defgroup ANB_BlobSlice ANB_Blob slices
+ * @brief Hand the same bytes to many readers without copying them.
+ *
+ * ANB_blob_slice turns the blob's buffer into shared, immutable storage
+ * and returns a view of a range of it. Every slice holds a reference, so
+ * the bytes stay valid after the blob is reset, written to or destroyed.
+ * The blob itself copies on write: its next push, reserve or other write
+ * moves it to a fresh buffer, unless every slice was released by then, in
+ * which case it takes its old buffer back without copying.
+ *
+ * Reference counts are atomic, so slices may be passed to and released on
+ * other threads. A single slice (like the blob) must not be used by two
+ * threads at once; give each thread its own with ANB_blob_slice_sub.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include "blob.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup ANB_BlobSlice
+ * @brief Opaque shared storage behind slices.
+ */
+typedef struct ANB_BlobBuf ANB_BlobBuf_t;
+
+/**
+ * @ingroup ANB_BlobSlice
+ * @brief A view of len bytes of shared storage, holding one reference to it.
+ *
+ * Fields are private. A zero-initialized slice is empty and may be released.
+ */
+typedef struct ANB_BlobSlice {
+    ANB_BlobBuf_t *_buf;
+    const uint8_t *_data;
+    size_t _len;
+} ANB_BlobSlice_t;
+
+/**
+ * @ingroup ANB_BlobSlice
+ * @brief Take a slice of the blob's unread bytes.
+ * @param blob The blob. Must not be NULL.
+ * @param offset Start of the slice, relative to the read cursor.
+ * @param len Length of the slice. Aborts if offset + len is past the write position.
+ * @param out Receives the slice. Must not be NULL.
+ * @return 0 on success, -1 if the blob lives in caller storage without
+ *         ANB_MEM_SPILL (out is then zeroed).
+ * @note The first slice of a buffer shares it in place, except for inline,
+ *       compact and caller storage, which is copied once to an owned buffer.
+ *       The read cursor does not move.
+ * @warning Once shared, writing through ANB_blob_data is not allowed until
+ *          the blob has copied on write.
+ */
+int ANB_blob_slice(ANB_Blob_t* blob, size_t offset, size_t len, ANB_BlobSlice_t *out);
+
+/**
+ * @ingroup ANB_BlobSlice
+ * @brief Take a slice of a slice, adding a reference to the same storage.
+ * @param slice The slice. Must not be NULL.
+ * @param offset Start within slice.
+ * @param len Length. Aborts if offset + len is past the end of slice.
+ * @param out Receives the new slice. Must not be NULL.
+ * @note ANB_blob_slice_sub(s, 0, len, &copy) duplicates a slice, e.g. one per subscriber.
+ */
+void ANB_blob_slice_sub(const ANB_BlobSlice_t *slice, size_t offset, size_t len, ANB_BlobSlice_t *out);
+
+/**
+ * @ingroup ANB_BlobSlice
+ * @brief Release a slice's reference and zero it.
+ * @param slice The slice. NULL and empty slices are ignored.
+ */
+void ANB_blob_slice_release(ANB_BlobSlice_t *slice);
+
+/**
+ * @ingroup ANB_BlobSlice
+ * @brief Number of references to the slice's storage, including the blob's
+ *        while it still uses it. For diagnostics; 0 for an empty slice.
+ * @param slice The slice. Must not be NULL.
+ */
+size_t ANB_blob_slice_refs(const ANB_BlobSlice_t *slice);
+
+/**
+ * @ingroup ANB_BlobSlice
+ * @brief Check whether the blob's buffer is shared with slices.
+ * @param blob The blob. Must not be NULL.
+ * @return 1 if the next write copies (or reclaims) the buffer, 0 otherwise.
+ */
+int ANB_blob_is_shared(ANB_Blob_t* blob);
+
+/**
+ * @ingroup ANB_BlobSlice
+ * @brief Get the bytes of a slice.
+ * @param slice The slice. Must not be NULL.
+ * @param len If non-NULL, receives the slice length.
+ * @return Pointer to the first byte; NULL for a zeroed slice. Valid until the slice is released.
+ */
+static inline const uint8_t *ANB_blob_slice_data(const ANB_BlobSlice_t *slice, size_t *len) {
+    if (len) *len = slice->_len;
+    return slice->_data;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,109 @@
+#pragma once
+/**
+ * @file framer.h
+ * @brief ANB_Framer public API — split a blob byte stream into slab items.
+ */
+
+/**
+ * @defgroup ANB_Framer ANB_Framer
+ * @brief Receive-side framing from an ANB_Blob into an ANB_Slab.
+ *
+ * Bytes arrive in a blob (e.g. through ANB_blob_read_fd). ANB_framer_run
+ * finds every complete frame among the unread bytes, copies each payload
+ * once into an item reserved with ANB_slab_alloc_item, and consumes the
+ * framed bytes from the blob. An incomplete frame stays unread in the blob
+ * until the next call; the framer remembers how far it already scanned, so
+ * delimiters are never searched twice.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include "blob.h"
+#include "slab.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @ingroup ANB_Framer
+ *  @brief Each frame is a length prefix followed by that many payload bytes. */
+#define ANB_FRAME_LENGTH    0
+/** @ingroup ANB_Framer
+ *  @brief Each frame ends with a delimiter byte string. */
+#define ANB_FRAME_DELIMITER 1
+/** @ingroup ANB_Framer
+ *  @brief Each frame has the same size. */
+#define ANB_FRAME_FIXED     2
+
+/** @ingroup ANB_Framer
+ *  @brief Longest delimiter accepted by ANB_framer_create. */
+#define ANB_FRAME_DELIM_MAX 16
+
+/**
+ * @ingroup ANB_Framer
+ * @brief Describes how the byte stream is cut into frames.
+ *
+ * Zero-initialize and set the fields of the chosen mode. Items receive the
+ * payload only: the length prefix and the delimiter are not copied.
+ */
+typedef struct ANB_FrameSpec {
+    int mode;                /**< ANB_FRAME_LENGTH, ANB_FRAME_DELIMITER or ANB_FRAME_FIXED. */
+    unsigned prefix_bytes;   /**< LENGTH: size of the length prefix, 1, 2 or 4. */
+    int big_endian;          /**< LENGTH: non-zero if the prefix is in network byte order. */
+    const uint8_t *delim;    /**< DELIMITER: terminator bytes, e.g. CR LF. Copied by ANB_framer_create. */
+    size_t delim_len;        /**< DELIMITER: 1 to ANB_FRAME_DELIM_MAX. */
+    size_t frame_size;       /**< FIXED: bytes per frame, > 0. */
+    size_t max_frame;        /**< Largest payload accepted, 0 = no limit. Ignored for FIXED. */
+} ANB_FrameSpec_t;
+
+/**
+ * @ingroup ANB_Framer
+ * @brief Opaque framer.
+ */
+typedef struct ANB_Framer ANB_Framer_t;
+
+/**
+ * @ingroup ANB_Framer
+ * @brief Create a framer.
+ * @param spec Framing description, copied into the framer. Must not be NULL.
+ * @return Pointer to the new framer. Aborts on allocation failure or an invalid spec.
+ */
+ANB_Framer_t* ANB_framer_create(const ANB_FrameSpec_t *spec);
+
+/**
+ * @ingroup ANB_Framer
+ * @brief Destroy a framer.
+ * @param framer The framer to destroy. Safe to pass NULL.
+ */
+void ANB_framer_destroy(ANB_Framer_t* framer);
+
+/**
+ * @ingroup ANB_Framer
+ * @brief Move every complete frame from a blob into a slab.
+ * @param framer The framer. Must not be NULL.
+ * @param in Blob holding the received bytes. Frames are taken from its
+ *           unread bytes and consumed. Must not be NULL.
+ * @param out Slab that receives one item per frame. Must not be NULL.
+ * @return Number of frames moved (0 if no frame is complete yet), or -1 with
+ *         errno set. If frames were moved before hitting the error, their
+ *         count is returned and the error repeats on the next call.
+ *         - EMSGSIZE: a frame is longer than max_frame. Its bytes are left
+ *           unread; the stream cannot be resynchronized, close it.
+ *         - ENOBUFS: out lives in full caller storage. The frame is left
+ *           unread; call again once items were popped.
+ * @note Use one framer per blob and consume the blob only through it, since
+ *       the framer keeps a scan position relative to the read cursor. Call
+ *       ANB_framer_reset if the blob is reset behind its back.
+ */
+ssize_t ANB_framer_run(ANB_Framer_t* framer, ANB_Blob_t* in, ANB_Slab_t* out);
+
+/**
+ * @ingroup ANB_Framer
+ * @brief Forget the scan position, e.g. after ANB_blob_reset on the input blob.
+ * @param framer The framer. Must not be NULL.
+ */
+void ANB_framer_reset(ANB_Framer_t* framer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+/**
+ * @file growth.h
+ * @brief ANB_Growth public API — capacity growth policy shared by ANB_Slab and ANB_Blob.
+ */
+
+/**
+ * @defgroup ANB_Growth ANB_Growth
+ * @brief Pluggable capacity growth policy for slab and blob buffers.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @ingroup ANB_Growth
+ *  @brief Round to regular page size (pass as round_to). */
+#define ANB_GROWTH_ROUND_PAGE     ((size_t)4096)
+/** @ingroup ANB_Growth
+ *  @brief Round to x86-64 / aarch64 transparent huge page size (pass as round_to). */
+#define ANB_GROWTH_ROUND_HUGEPAGE ((size_t)2 * 1024 * 1024)
+
+/** @ingroup ANB_Growth
+ *  @brief Default growth factor in percent (doubling). */
+#define ANB_GROWTH_DEFAULT_FACTOR   200
+/** @ingroup ANB_Growth
+ *  @brief Default cap on bytes added per growth step. */
+#define ANB_GROWTH_DEFAULT_MAX_STEP ((size_t)256 * 1024 * 1024)
+
+/**
+ * @ingroup ANB_Growth
+ * @brief Custom growth callback.
+ * @param ctx User context from the policy.
+ * @param current Current capacity in bytes.
+ * @param required Minimum capacity that must be satisfied.
+ * @return The new capacity. Must be >= required, otherwise the caller aborts.
+ */
+typedef size_t (*ANB_GrowthFn)(void *ctx, size_t current, size_t required);
+
+/**
+ * @ingroup ANB_Growth
+ * @brief Describes how a buffer grows when it runs out of capacity.
+ *
+ * Growth is applied in steps of (factor_pct - 100)% of the current capacity
+ * until the required size is reached. Each step is capped at max_step bytes;
+ * once a step is capped the capacity jumps straight to the required size (or
+ * one capped step, whichever is larger) instead of iterating. The final
+ * capacity is rounded up to a multiple of round_to.
+ *
+ * If fn is set it replaces the built-in computation entirely.
+ */
+typedef struct ANB_GrowthPolicy {
+    uint32_t factor_pct; /**< Growth factor in percent (200 = doubling). <= 100 selects exact fit. */
+    size_t max_step;     /**< Maximum bytes added per step, 0 = unbounded. */
+    size_t round_to;     /**< Round capacity up to a multiple of this power of two, 0 or 1 = none. */
+    ANB_GrowthFn fn;     /**< Optional custom growth function, NULL = built-in. */
+    void *ctx;           /**< Context passed to fn. */
+} ANB_GrowthPolicy_t;
+
+/** @ingroup ANB_Growth
+ *  @brief Initializer for the default policy (doubling, capped per step, no rounding). */
+#define ANB_GROWTH_DEFAULT { ANB_GROWTH_DEFAULT_FACTOR, ANB_GROWTH_DEFAULT_MAX_STEP, 0, NULL, NULL }
+/** @ingroup ANB_Growth
+ *  @brief Initializer for exact-fit growth (capacity grows only to what is required). */
+#define ANB_GROWTH_EXACT   { 100, 0, 0, NULL, NULL }
+
+/**
+ * @ingroup ANB_Growth
+ * @brief Compute the next capacity for a buffer under a growth policy.
+ * @param policy The policy. If NULL, the default policy is used.
+ * @param current Current capacity in bytes.
+ * @param required Minimum capacity needed.
+ * @return The new capacity (>= required), or current if required <= current.
+ * @note Aborts if the result would overflow size_t, or if round_to is not
+ *       0, 1 or a power of two.
+ */
+size_t ANB_growth_next(const ANB_GrowthPolicy_t *policy, size_t current, size_t required);
+
+/** @ingroup ANB_Growth
+ *  @brief Trim mode: shrink the buffer (realloc / mremap down). */
+#define ANB_TRIM_SHRINK  0
+/** @ingroup ANB_Growth
+ *  @brief Trim mode: keep capacity but madvise(MADV_FREE) the unused tail of
+ *         mmap-backed buffers. Heap-backed buffers are shrunk instead. */
+#define ANB_TRIM_RELEASE 1
+
+/**
+ * @ingroup ANB_Growth
+ * @brief Automatic capacity release after a traffic spike.
+ *
+ * Evaluated each time a buffer is reset (slab: last item popped; blob:
+ * ANB_blob_reset / ANB_blob_clear). A reset is "low" when the usage since
+ * the previous reset is below usage_pct percent of capacity. After resets
+ * consecutive low resets the buffer is trimmed down to the largest usage
+ * seen during that streak (never below its initial size). Any reset above
+ * the threshold restarts the streak.
+ */
+typedef struct ANB_TrimPolicy {
+    uint32_t usage_pct; /**< Low-usage threshold in percent of capacity. 0 disables automatic trim. */
+    uint32_t resets;    /**< Consecutive low resets required before trimming. */
+    int mode;           /**< ANB_TRIM_SHRINK or ANB_TRIM_RELEASE. */
+} ANB_TrimPolicy_t;
+
+#ifdef __cplusplus
+}
+#endif
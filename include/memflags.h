@@ -0,0 +1,68 @@
+#pragma once
+/**
+ * @file memflags.h
+ * @brief ANB_Mem creation flags for slab and blob buffers.
+ */
+
+/**
+ * @defgroup ANB_Mem ANB_Mem
+ * @brief Creation flags controlling how slab and blob buffers are backed.
+ *
+ * Pass a bitwise OR of these to ANB_slab_create_ex / ANB_blob_create_ex.
+ * Every flag except ANB_MEM_SECURE forces the buffer onto an anonymous
+ * mapping regardless of its size. The mapping flags are honored on Linux
+ * and ignored elsewhere; ANB_MEM_SECURE works everywhere.
+ */
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @ingroup ANB_Mem
+ *  @brief Align the buffer to 2 MiB, size it in 2 MiB multiples and madvise(MADV_HUGEPAGE) it. */
+#define ANB_MEM_HUGEPAGE (1u << 0)
+
+/** @ingroup ANB_Mem
+ *  @brief Prefault pages on create and on every growth so first access does not fault. */
+#define ANB_MEM_PREFAULT (1u << 1)
+
+/** @ingroup ANB_Mem
+ *  @brief mlock the buffer so it is never paged out. Creation aborts if the lock fails (see RLIMIT_MEMLOCK). */
+#define ANB_MEM_MLOCK    (1u << 2)
+
+/** @ingroup ANB_Mem
+ *  @brief Never leave copies of the contents behind.
+ *
+ *  Growth allocates, copies, wipes and frees instead of realloc. The slab
+ *  wipes its data when it resets and the blob wipes on reset, clear, shrink
+ *  and destroy. Combine with ANB_MEM_MLOCK and ANB_MEM_DONTDUMP to also keep
+ *  the contents out of swap and core dumps. */
+#define ANB_MEM_SECURE   (1u << 3)
+
+/** @ingroup ANB_Mem
+ *  @brief Exclude the buffer from core dumps with madvise(MADV_DONTDUMP). */
+#define ANB_MEM_DONTDUMP (1u << 4)
+
+/** @ingroup ANB_Mem
+ *  @brief For ANB_slab_init_in / ANB_blob_init_in only: when the caller's
+ *         storage is full, move to a heap buffer instead of failing. */
+#define ANB_MEM_SPILL    (1u << 5)
+
+/** @ingroup ANB_Mem
+ *  @brief All flags accepted by the _create_ex functions. */
+#define ANB_MEM_FLAGS_ALL (ANB_MEM_HUGEPAGE | ANB_MEM_PREFAULT | ANB_MEM_MLOCK | ANB_MEM_SECURE | ANB_MEM_DONTDUMP)
+
+/**
+ * @ingroup ANB_Mem
+ * @brief Zero memory in a way the compiler cannot optimize out.
+ * @param ptr Memory to wipe. May be NULL if len is 0.
+ * @param len Number of bytes.
+ * @note Uses explicit_bzero / memset_s where available, otherwise a
+ *       vectorized memset followed by a compiler barrier.
+ */
+void ANB_secure_zero(void *ptr, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
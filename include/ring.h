@@ -0,0 +1,121 @@
+#pragma once
+/**
+ * @file ring.h
+ * @brief ANB_Ring public API — double-mapped ring buffer with contiguous wraparound views.
+ */
+
+/**
+ * @defgroup ANB_Ring ANB_Ring
+ * @brief Fixed-capacity byte ring whose readable and writable windows are always contiguous.
+ *
+ * The backing memory is mapped twice, back to back, so the byte after the
+ * last one of the buffer is the first one again. A window that crosses the
+ * wrap point is still one plain pointer and length; no split copies needed.
+ * The API mirrors ANB_Blob's reserve/commit and peek/consume.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Opaque ring buffer.
+ *
+ * One producer (reserve/commit/push) and one consumer (peek/consume) may
+ * run on different threads without locking. Everything else, including
+ * reset and destroy, needs exclusive access.
+ */
+typedef struct ANB_Ring ANB_Ring_t;
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Create a ring buffer.
+ * @param min_capacity Minimum capacity in bytes. Must be > 0. Rounded up to a
+ *                     power of two that is at least one page.
+ * @return Pointer to the new ring. Aborts if the memory or the double mapping
+ *         cannot be set up.
+ */
+ANB_Ring_t* ANB_ring_create(size_t min_capacity);
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Destroy a ring and unmap its memory.
+ * @param ring The ring to destroy. Safe to pass NULL.
+ */
+void ANB_ring_destroy(ANB_Ring_t* ring);
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Get the capacity of the ring.
+ * @param ring The ring. Must not be NULL.
+ * @return Capacity in bytes (a power of two).
+ */
+size_t ANB_ring_capacity(ANB_Ring_t* ring);
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Get the number of unread bytes.
+ * @param ring The ring. Must not be NULL.
+ * @return Bytes committed but not yet consumed.
+ */
+size_t ANB_ring_data_len(ANB_Ring_t* ring);
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Get a contiguous writable window of at least min_len bytes.
+ * @param ring The ring. Must not be NULL.
+ * @param min_len Bytes the window must hold. 0 returns whatever is free.
+ * @param avail If non-NULL, receives the full size of the window (all free space).
+ * @return Pointer to the window, or NULL if less than min_len bytes are free.
+ *         The ring never grows.
+ */
+uint8_t *ANB_ring_reserve(ANB_Ring_t* ring, size_t min_len, size_t *avail);
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Publish n bytes written into the reserved window.
+ * @param ring The ring. Must not be NULL.
+ * @param n Bytes to publish. Aborts if more than are free.
+ */
+void ANB_ring_commit(ANB_Ring_t* ring, size_t n);
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Copy bytes into the ring.
+ * @param ring The ring. Must not be NULL.
+ * @param bytes Data to copy.
+ * @param len Number of bytes.
+ * @return 0 on success, -1 if less than len bytes are free (nothing is written).
+ */
+int ANB_ring_push(ANB_Ring_t* ring, const uint8_t* bytes, size_t len);
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Get all unread bytes as one contiguous window.
+ * @param ring The ring. Must not be NULL.
+ * @param len If non-NULL, receives the number of unread bytes.
+ * @return Pointer to the first unread byte.
+ */
+uint8_t *ANB_ring_peek(ANB_Ring_t* ring, size_t *len);
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Release n bytes from the front of the unread window.
+ * @param ring The ring. Must not be NULL.
+ * @param n Bytes consumed. Aborts if more than are unread.
+ */
+void ANB_ring_consume(ANB_Ring_t* ring, size_t n);
+
+/**
+ * @ingroup ANB_Ring
+ * @brief Drop all unread bytes.
+ * @param ring The ring. Must not be NULL.
+ */
+void ANB_ring_reset(ANB_Ring_t* ring);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,186 @@
+#pragma once
+/**
+ * @file rope.h
+ * @brief ANB_Rope public API — segmented byte buffer that never copies on growth.
+ */
+
+/**
+ * @defgroup ANB_Rope ANB_Rope
+ * @brief Byte buffer made of linked fixed-size segments.
+ *
+ * Appending fills the last segment and links a new one when it is full, so
+ * a payload of any size is written exactly once and the peak memory is the
+ * payload plus at most one segment. The contents are reached segment by
+ * segment (iterator or iovec export); ANB_rope_flatten makes them
+ * contiguous when a caller needs one pointer.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/uio.h>
+#include "memflags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Opaque segmented buffer.
+ */
+typedef struct ANB_Rope ANB_Rope_t;
+
+/** @ingroup ANB_Rope
+ *  @brief Segment size used when 0 is passed to ANB_rope_create. */
+#define ANB_ROPE_SEGMENT_DEFAULT ((size_t)64 * 1024)
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Iterator over the segments of a rope.
+ *
+ * Initialize to zero before first use:
+ *   ANB_RopeIter_t iter = {0};
+ *
+ * Segments never move, so appending while iterating is safe and segments
+ * linked meanwhile are visited too. Consume, reset and flatten invalidate
+ * the iterator.
+ */
+typedef struct ANB_RopeIter {
+    const void *_seg; /* segment returned last, NULL before the first call */
+} ANB_RopeIter_t;
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Create an empty rope.
+ * @param segment_size Size of each segment in bytes. 0 selects ANB_ROPE_SEGMENT_DEFAULT.
+ * @return Pointer to the new rope. Aborts on allocation failure.
+ * @note The first segment is allocated on the first write.
+ */
+ANB_Rope_t* ANB_rope_create(size_t segment_size);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Create an empty rope with creation flags.
+ * @param segment_size Size of each segment in bytes. 0 selects ANB_ROPE_SEGMENT_DEFAULT.
+ * @param flags Bitwise OR of ANB_MEM_* flags from memflags.h, applied to every segment.
+ * @return Pointer to the new rope. Aborts on allocation failure or an unknown flag.
+ */
+ANB_Rope_t* ANB_rope_create_ex(size_t segment_size, unsigned flags);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Destroy a rope and free all its segments.
+ * @param rope The rope to destroy. Safe to pass NULL.
+ */
+void ANB_rope_destroy(ANB_Rope_t* rope);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Get the number of unread bytes.
+ * @param rope The rope. Must not be NULL.
+ * @return Bytes appended and not yet consumed.
+ */
+size_t ANB_rope_data_len(ANB_Rope_t* rope);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Get the number of linked segments.
+ * @param rope The rope. Must not be NULL.
+ * @return Segment count. An empty rope keeps at most one segment for reuse.
+ */
+size_t ANB_rope_segment_count(ANB_Rope_t* rope);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Append bytes, spreading them over as many segments as needed.
+ * @param rope The rope. Must not be NULL.
+ * @param bytes Data to copy.
+ * @param len Number of bytes.
+ * @note Existing bytes never move. Aborts on allocation failure.
+ */
+void ANB_rope_push(ANB_Rope_t* rope, const uint8_t* bytes, size_t len);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Get a contiguous writable tail of at least min_len bytes.
+ * @param rope The rope. Must not be NULL.
+ * @param min_len Bytes the tail must hold. 0 returns the free space of the
+ *                last segment, linking a new one if it is full.
+ * @param avail If non-NULL, receives the size of the tail.
+ * @return Pointer to the tail. A new segment of max(segment size, min_len)
+ *         bytes is linked if the last one has less than min_len bytes free.
+ */
+uint8_t *ANB_rope_reserve(ANB_Rope_t* rope, size_t min_len, size_t *avail);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Append n bytes written into the reserved tail.
+ * @param rope The rope. Must not be NULL.
+ * @param n Bytes to append. Aborts if n exceeds the reserved tail.
+ */
+void ANB_rope_commit(ANB_Rope_t* rope, size_t n);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Iterate over the unread bytes one segment at a time.
+ * @param rope The rope. Must not be NULL.
+ * @param iter Iterator state. Zero-initialize before the first call.
+ * @param len If non-NULL, receives the number of bytes in the returned segment.
+ * @return Pointer to the segment's bytes, or NULL after the last one.
+ */
+uint8_t *ANB_rope_segment_iter(ANB_Rope_t* rope, ANB_RopeIter_t *iter, size_t *len);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Describe the unread bytes as an iovec array, e.g. for writev().
+ * @param rope The rope. Must not be NULL.
+ * @param iov Array to fill.
+ * @param max Number of entries in iov.
+ * @return Entries filled: one per segment, at most max. Pass the bytes that
+ *         were written to ANB_rope_consume.
+ */
+int ANB_rope_iovec(ANB_Rope_t* rope, struct iovec *iov, int max);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Release n bytes from the front, freeing segments that are fully read.
+ * @param rope The rope. Must not be NULL.
+ * @param n Bytes consumed. Aborts if more than are unread.
+ * @note Consuming everything keeps the last segment for reuse if it has the
+ *       standard segment size.
+ */
+void ANB_rope_consume(ANB_Rope_t* rope, size_t n);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Drop all bytes, keeping the first segment for reuse if it has the standard segment size.
+ * @param rope The rope. Must not be NULL.
+ */
+void ANB_rope_reset(ANB_Rope_t* rope);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Make the unread bytes contiguous.
+ * @param rope The rope. Must not be NULL.
+ * @param len If non-NULL, receives the number of bytes.
+ * @return Pointer to all unread bytes in one piece, or NULL if the rope is
+ *         empty. With more than one segment, the bytes are copied once into
+ *         a single segment that replaces all of them.
+ * @note The pointer stays valid until the next consume, reset or flatten;
+ *       appends go to new segments after it.
+ */
+uint8_t *ANB_rope_flatten(ANB_Rope_t* rope, size_t *len);
+
+/**
+ * @ingroup ANB_Rope
+ * @brief Copy bytes out of the rope without changing it.
+ * @param rope The rope. Must not be NULL.
+ * @param offset Offset from the first unread byte.
+ * @param dst Destination buffer.
+ * @param len Bytes to copy.
+ * @return Bytes copied, less than len if the rope ends first.
+ */
+size_t ANB_rope_copy_out(ANB_Rope_t* rope, size_t offset, uint8_t *dst, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,195 @@
+#pragma once
+/**
+ * @file shm_slab.h
+ * @brief ANB_ShmSlab public API — item queue in shared memory for zero-copy messaging between processes.
+ */
+
+/**
+ * @defgroup ANB_ShmSlab ANB_ShmSlab
+ * @brief Fixed-capacity item queue living entirely inside a shared memory segment.
+ *
+ * The segment (a memfd, or a POSIX shm object when named) starts with a
+ * header holding a magic, a layout version, the capacity and the queue
+ * positions; items follow in a circular data area. Everything inside refers
+ * to other parts by offset, so each process maps the segment wherever it
+ * likes and works on the same queue. A producer writes an item straight into
+ * the segment and the consumer reads it there: no copy through a socket.
+ *
+ * Items are stored like in ANB_Slab, padded to max_align_t, and each item is
+ * contiguous. The data area starts at a page boundary and each process maps
+ * it twice back to back, like ANB_Ring, so an item crossing the end of the
+ * data area continues in the second view: any item up to the capacity minus
+ * its header fits once the queue has that much free space.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @ingroup ANB_ShmSlab
+ *  @brief Layout version written into the segment header. Opening a segment with another version fails. */
+#define ANB_SHM_SLAB_VERSION 1
+
+/** @ingroup ANB_ShmSlab
+ *  @brief Creation flag: allow several producers (threads or processes). Without it, one producer at a time. */
+#define ANB_SHM_MPSC 1
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Opaque per-process handle to a shared queue.
+ *
+ * One consumer (peek, pop, wait) and one producer, or any number of
+ * producers with ANB_SHM_MPSC, may work on the queue at the same time from
+ * any process that has it open, without locking.
+ */
+typedef struct ANB_ShmSlab ANB_ShmSlab_t;
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Iterator over the items waiting in the queue.
+ *
+ * Initialize to zero before first use: ANB_ShmSlabIter_t iter = {0};
+ * Popping while iterating is safe: popped items are skipped.
+ */
+typedef struct ANB_ShmSlabIter {
+    uint64_t _pos;   /* queue position of the next item to look at */
+} ANB_ShmSlabIter_t;
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Create a shared queue in a new segment.
+ * @param name NULL for an anonymous memfd, to be passed on with ANB_shm_slab_fd
+ *             (fork or SCM_RIGHTS). Otherwise a POSIX shm name ("/name"),
+ *             which must not exist yet.
+ * @param capacity Bytes for items, including their headers and padding.
+ *                 Must be > 0. Rounded up to a power of two that is at
+ *                 least one page.
+ * @param flags 0 or ANB_SHM_MPSC.
+ * @return The queue, or NULL if the segment cannot be created (errno is set).
+ *         Aborts on an unknown flag.
+ */
+ANB_ShmSlab_t* ANB_shm_slab_create(const char *name, size_t capacity, unsigned flags);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Map an existing queue from a file descriptor.
+ * @param fd Descriptor of the segment, e.g. received from the creating
+ *           process. The handle keeps its own duplicate; the caller still
+ *           owns fd.
+ * @return The queue, or NULL if fd cannot be mapped or does not hold a queue
+ *         of this layout version and a consistent size.
+ */
+ANB_ShmSlab_t* ANB_shm_slab_open_fd(int fd);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Map an existing queue by its POSIX shm name.
+ * @param name Name given to ANB_shm_slab_create.
+ * @return The queue, or NULL as for ANB_shm_slab_open_fd.
+ */
+ANB_ShmSlab_t* ANB_shm_slab_open(const char *name);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Unmap the queue in this process.
+ * @param queue The queue. Safe to pass NULL.
+ * @note The handle that created a named segment also unlinks the name;
+ *       processes that have it mapped keep working. The memory goes away when
+ *       the last process unmaps it.
+ */
+void ANB_shm_slab_destroy(ANB_ShmSlab_t* queue);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Get the segment's file descriptor, to pass it to another process.
+ * @param queue The queue. Must not be NULL.
+ * @return The descriptor, owned by the handle (close-on-exec).
+ */
+int ANB_shm_slab_fd(ANB_ShmSlab_t* queue);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Get the size of the data area.
+ * @param queue The queue. Must not be NULL.
+ * @return Capacity in bytes. The largest item is this minus one item header.
+ */
+size_t ANB_shm_slab_capacity(ANB_ShmSlab_t* queue);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Reserve space for an item without publishing it.
+ * @param queue The queue. Must not be NULL.
+ * @param data_len Number of bytes to reserve.
+ * @return Pointer into the segment (aligned to max_align_t) to fill, then
+ *         pass to ANB_shm_slab_publish. NULL if there is not enough free space
+ *         right now; the queue never grows.
+ * @note Without ANB_SHM_MPSC, items must be published in the order they were
+ *       allocated. With it, each producer publishes its own items in any
+ *       order, and the consumer sees an item once everything before it is
+ *       published.
+ */
+uint8_t *ANB_shm_slab_alloc_item(ANB_ShmSlab_t* queue, size_t data_len);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Make an allocated item visible to the consumer and wake it if it waits.
+ * @param queue The queue. Must not be NULL.
+ * @param item Pointer returned by ANB_shm_slab_alloc_item.
+ */
+void ANB_shm_slab_publish(ANB_ShmSlab_t* queue, uint8_t *item);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Copy data into the queue as one item and publish it.
+ * @param queue The queue. Must not be NULL.
+ * @param data Data to copy. May be NULL if data_len is 0.
+ * @param data_len Number of bytes.
+ * @return 0 on success, -1 if there is not enough free space (nothing is added).
+ */
+int ANB_shm_slab_push_item(ANB_ShmSlab_t* queue, const uint8_t *data, size_t data_len);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Iterate the published items in FIFO order without removing them. Consumer only.
+ * @param queue The queue. Must not be NULL.
+ * @param iter Iterator state, zero-initialized before the first call. If NULL,
+ *             returns the first item.
+ * @param out_size If non-NULL, receives the item's original size in bytes.
+ * @return Pointer to the item in this process's mapping, or NULL if no more
+ *         items are published. Valid until the item is popped.
+ */
+uint8_t *ANB_shm_slab_peek_item_iter(ANB_ShmSlab_t* queue, ANB_ShmSlabIter_t *iter, size_t *out_size);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Remove the first item and return its space to the producers. Consumer only.
+ * @param queue The queue. Must not be NULL.
+ * @return 0 on success, -1 if no item is published.
+ */
+int ANB_shm_slab_pop_item(ANB_ShmSlab_t* queue);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Get the number of published items not yet popped.
+ * @param queue The queue. Must not be NULL.
+ * @return Item count; a snapshot while producers are running.
+ */
+size_t ANB_shm_slab_item_count(ANB_ShmSlab_t* queue);
+
+/**
+ * @ingroup ANB_ShmSlab
+ * @brief Sleep until an item is published. Consumer only.
+ * @param queue The queue. Must not be NULL.
+ * @param timeout_ms Longest wait in milliseconds; 0 only checks, -1 waits forever.
+ * @return 1 if an item is ready to peek, 0 on timeout.
+ * @note Sleeps on a futex inside the segment, so a producer in any process
+ *       wakes it. Producers only make the wake system call while the
+ *       consumer actually sleeps.
+ */
+int ANB_shm_slab_wait(ANB_ShmSlab_t* queue, int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
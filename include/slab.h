@@ -10,6 +10,12 @@
  */
 #include <stdint.h>
 #include <stdlib.h>
+#include "growth.h"
+#include "memflags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /**
  * @ingroup ANB_Slab
@@ -29,13 +35,77 @@ typedef struct ANB_Slab ANB_Slab_t;
  */
 ANB_Slab_t* ANB_slab_create(size_t initial_size);
 
+/**
+ * @ingroup ANB_Slab
+ * @brief Create a new buffer queue with creation flags.
+ * @param initial_size Initial capacity in bytes. Must be > 0.
+ * @param flags Bitwise OR of ANB_MEM_* flags from memflags.h, or 0.
+ * @return Pointer to the new queue. Aborts on allocation failure, on an
+ *         unknown flag, or if ANB_MEM_MLOCK cannot lock the buffer.
+ * @note Any flag forces the buffer onto an anonymous mapping. ANB_MEM_HUGEPAGE
+ *       applies to the data buffer only; the item index is locked and
+ *       prefaulted along with it.
+ */
+ANB_Slab_t* ANB_slab_create_ex(size_t initial_size, unsigned flags);
+
+/**
+ * @ingroup ANB_Slab
+ * @brief Build a queue inside caller-provided storage, without any heap allocation.
+ * @param buf Storage for the queue header, item index and data, e.g. a stack
+ *            array or a static or shared region. Any alignment.
+ * @param len Size of buf in bytes.
+ * @param flags 0, or a bitwise OR of ANB_MEM_SPILL and ANB_MEM_SECURE.
+ * @return The queue (located inside buf), or NULL if buf is NULL, too small
+ *         or flags are not supported.
+ * @note Once the storage is full, ANB_slab_alloc_item returns NULL and
+ *       ANB_slab_push_item returns -1 instead of growing. With ANB_MEM_SPILL
+ *       the queue moves to heap buffers and keeps growing as usual. Roughly a
+ *       third of len goes to the item index, sized so the index never fills
+ *       before the data. Trim never shrinks caller storage.
+ *       Call ANB_slab_destroy when done if ANB_MEM_SPILL or ANB_MEM_SECURE is
+ *       set; otherwise simply discarding buf is enough.
+ */
+ANB_Slab_t* ANB_slab_init_in(void *buf, size_t len, unsigned flags);
+
 /**
  * @ingroup ANB_Slab
  * @brief Destroy a buffer queue and free its memory.
  * @param queue The queue to destroy. Safe to pass NULL.
+ * @note For a queue from ANB_slab_init_in, frees only buffers it spilled to.
  */
 void ANB_slab_destroy(ANB_Slab_t* queue);
 
+/**
+ * @ingroup ANB_Slab
+ * @brief Set the growth policy used when the data buffer runs out of space.
+ * @param queue The queue. Must not be NULL.
+ * @param policy The policy to copy into the queue. NULL restores ANB_GROWTH_DEFAULT.
+ *               Aborts if its round_to is not 0, 1 or a power of two.
+ * @note The item index does not use the policy; it doubles its slot count when full.
+ */
+void ANB_slab_set_growth(ANB_Slab_t* queue, const ANB_GrowthPolicy_t *policy);
+
+/**
+ * @ingroup ANB_Slab
+ * @brief Set the automatic trim policy evaluated whenever the queue resets (last item popped).
+ * @param queue The queue. Must not be NULL.
+ * @param policy The policy to copy into the queue. NULL disables automatic trim (the default).
+ * @note Data and index are tracked independently. Trimmed capacity never goes
+ *       below the queue's initial size. ANB_TRIM_RELEASE keeps the capacity
+ *       and releases the pages of mmap-backed data instead.
+ */
+void ANB_slab_set_trim(ANB_Slab_t* queue, const ANB_TrimPolicy_t *policy);
+
+/**
+ * @ingroup ANB_Slab
+ * @brief Shrink the data buffer and item index to what is currently in use.
+ * @param queue The queue. Must not be NULL.
+ * @note Live items and iterators stay valid, but data pointers previously
+ *       returned by peek_item_iter may be invalidated. Capacity never goes
+ *       below the initial size.
+ */
+void ANB_slab_trim(ANB_Slab_t* queue);
+
 /**
  * @ingroup ANB_Slab
  * @brief Allocate space for an item without copying data.
@@ -43,8 +113,11 @@ void ANB_slab_destroy(ANB_Slab_t* queue);
  * @param data_len Number of bytes to reserve.
  * @return Pointer to the allocated region (at least data_len bytes, aligned
  *         to max_align_t). The caller is responsible for filling the memory.
- * @note The item is immediately tracked (counted, indexed). Buffer and item
- *       index grow automatically if needed. Padding bytes are uninitialized.
+ *         NULL if the queue lives in full caller storage (ANB_slab_init_in
+ *         without ANB_MEM_SPILL); nothing is added in that case.
+ * @note The item is immediately tracked (counted, indexed). The buffer grows
+ *       by the queue's growth policy and the item index doubles if needed.
+ *       Padding bytes are uninitialized.
  * @warning Any data pointer previously returned by peek_item_iter may be
  *          invalidated by a push/alloc that grows the buffer.
  */
@@ -59,8 +132,9 @@ uint8_t *ANB_slab_alloc_item(ANB_Slab_t* queue, size_t data_len);
  * @note Data is stored with max_align_t alignment padding. The buffer
  *       consumes ALIGN_UP(data_len) bytes internally. Padding bytes are
  *       uninitialized. Buffer and item index grow automatically if needed.
+ * @return 0 on success, -1 if the queue lives in full caller storage.
  */
-void ANB_slab_push_item(ANB_Slab_t* queue, const uint8_t* data, size_t data_len);
+int ANB_slab_push_item(ANB_Slab_t* queue, const uint8_t* data, size_t data_len);
 
 /**
  * @ingroup ANB_Slab
@@ -70,6 +144,14 @@ void ANB_slab_push_item(ANB_Slab_t* queue, const uint8_t* data, size_t data_len)
  */
 size_t ANB_slab_size(ANB_Slab_t* queue);
 
+/**
+ * @ingroup ANB_Slab
+ * @brief Get the allocated capacity of the data buffer.
+ * @param queue The queue. Must not be NULL.
+ * @return Bytes that can be in use before the next push grows the buffer.
+ */
+size_t ANB_slab_capacity(ANB_Slab_t* queue);
+
 /**
  * @ingroup ANB_Slab
  * @brief Get the number of discrete items in the queue.
@@ -120,13 +202,25 @@ uint8_t *ANB_slab_peek_item_iter(ANB_Slab_t* queue, ANB_SlabIter_t *iter, size_t
  */
 int ANB_slab_pop_item(ANB_Slab_t* queue, ANB_SlabIter_t *iter);
 
+/**
+ * @ingroup ANB_Slab
+ * @brief Drop every item at once, as if all had been popped.
+ * @param queue The queue. Must not be NULL.
+ * @note Runs the same reset as popping the last item: positions rewind, the
+ *       version changes (invalidating iterators), ANB_MEM_SECURE data is wiped
+ *       and the trim policy is evaluated.
+ */
+void ANB_slab_reset(ANB_Slab_t* queue);
+
 /**
  * @ingroup ANB_Slab
  * @brief Pop an item and securely zero its data to prevent sensitive data from lingering in memory.
  * @param queue The queue. Must not be NULL.
  * @param iter Optional iterator pointing to the item to pop. If NULL, pops the first non-deleted item.
  * @return 0 on success, -1 on failure (empty queue or already deleted).
- * @note Uses volatile writes to prevent the compiler from optimizing out the zeroing.
+ * @note Uses ANB_secure_zero, which the compiler cannot optimize out. For
+ *       queues whose data must never linger anywhere, create them with
+ *       ANB_MEM_SECURE.
  */
 int ANB_slab_securepop_item(ANB_Slab_t* queue, ANB_SlabIter_t *iter);
 
@@ -149,3 +243,45 @@ int ANB_slab_item_valid(ANB_Slab_t* queue, ANB_SlabIter_t *iter);
  * @return Pointer to the item's data, or NULL if the iterator is invalid.
  */
 uint8_t *ANB_slab_peek_item(ANB_Slab_t* queue, ANB_SlabIter_t *iter, size_t *out_size);
+
+/**
+ * @ingroup ANB_Slab
+ * @brief Sleep until the queue holds at least one item.
+ * @param queue The queue. Must not be NULL.
+ * @param timeout_ms Longest wait in milliseconds; 0 only checks, -1 waits forever.
+ * @return 1 if items are queued, 0 on timeout.
+ * @note Unlike the other calls, this one may run while another thread pushes
+ *       or pops; those still need exclusive access among themselves (e.g. a
+ *       mutex the consumer takes only after waking). Sleeps on a futex; a
+ *       burst of pushes makes one wake system call, and none while nobody
+ *       sleeps.
+ */
+int ANB_slab_wait_nonempty(ANB_Slab_t* queue, int timeout_ms);
+
+/**
+ * @ingroup ANB_Slab
+ * @brief Get a descriptor that becomes readable when items are pushed, for poll or epoll loops.
+ * @param queue The queue. Must not be NULL.
+ * @return The descriptor (nonblocking, close-on-exec, closed by ANB_slab_destroy),
+ *         or -1 with errno set if it cannot be created.
+ * @note Created by the first call, which may race pushes from other threads
+ *       but not another first call; it is readable at once if items are
+ *       already queued. Readiness is
+ *       coalesced: after it fires, further pushes do not touch the descriptor
+ *       until ANB_slab_event_ack. An eventfd on Linux, a pipe elsewhere.
+ */
+int ANB_slab_event_fd(ANB_Slab_t* queue);
+
+/**
+ * @ingroup ANB_Slab
+ * @brief Re-arm the event descriptor after handling its readiness.
+ * @param queue The queue. Must not be NULL.
+ * @note Drains the descriptor. Call it after popping what the wakeup was for;
+ *       if items are still queued, the descriptor is readable again at once.
+ *       Does nothing without ANB_slab_event_fd.
+ */
+void ANB_slab_event_ack(ANB_Slab_t* queue);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,31 +1,191 @@
 #include <stdint.h>
 #include "blob.h"
+#include "blob_internal.h"
+#include "digest_internal.h"
+#include "growth.h"
+#include "growth_internal.h"
+#include "vmem.h"
+#include <errno.h>
+#include <fcntl.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 struct ANB_Blob {
     uint8_t *data;
     size_t capacity;
     size_t pos;
+    ANB_GrowthPolicy_t growth;
+    unsigned state; // Backing store state of data (see vmem.h)
+    size_t min_capacity;        // Initial capacity, trim never goes below it
+    ANB_TrimPolicy_t trim;      // Automatic trim on reset/clear, disabled by default
+    ANB_TrimState_t trim_state;
+    int in_place;               // Struct lives in caller storage (ANB_blob_init_in), not freed on destroy
+    size_t ext_cap;             // Bytes available behind data while it is external (inline, compact or caller storage)
+    size_t rpos;                // Read cursor: bytes before it have been consumed
+    uint32_t compact_pct;       // Auto-compact once the consumed prefix reaches this percent of capacity, 0 = off
+    ANB_BlobBuf_t *shared;      // Owner of data while slices may see it; state then has ANB_VMEM_READONLY added
+    ANB_DigestState_t *digest;  // Running digest of written bytes, NULL = off
+    size_t dirty;               // High-water mark: bytes past max(dirty, pos) are known to be zero
+
+    // Small contents live here until the first growth past it. Must stay last:
+    // compact and in-place blobs put their data from this offset on instead.
+    _Alignas(max_align_t) uint8_t inline_buf[ANB_BLOB_INLINE_SIZE];
 };
 
+#define ANB_B_ALIGN_UP(x) (((x) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+#define ANB_B_HEAD offsetof(ANB_Blob_t, inline_buf)
+
+// Fold the write position into the high-water mark before it moves back
+static inline void ANB_b_dirty_mark(ANB_Blob_t* blob) {
+    if (blob->pos > blob->dirty) blob->dirty = blob->pos;
+}
+
+// The buffer was (re)allocated from byte from on: fresh anonymous pages are zero, anything else may hold old bytes
+static void ANB_b_dirty_fresh(ANB_Blob_t* blob, size_t from) {
+    ANB_b_dirty_mark(blob);
+    int zeroed = (blob->state & ANB_VMEM_MAPPED) && !(blob->state & ANB_VMEM_FILE);
+    if (!zeroed && blob->capacity > from) blob->dirty = blob->capacity;
+    else if (blob->dirty > blob->capacity) blob->dirty = blob->capacity;
+}
+
 ANB_Blob_t* ANB_blob_create(size_t initial_size) {
+    return ANB_blob_create_ex(initial_size, 0);
+}
+
+ANB_Blob_t* ANB_blob_create_ex(size_t initial_size, unsigned flags) {
     if (initial_size == 0) abort();
-    ANB_Blob_t* blob = (ANB_Blob_t*)calloc(1, sizeof(ANB_Blob_t));
+    if (flags & ~ANB_MEM_FLAGS_ALL) abort();
+    ANB_Blob_t* blob = (ANB_Blob_t*)malloc(sizeof(ANB_Blob_t));
     if (!blob) abort();
+    memset(blob, 0, ANB_B_HEAD);
 
-    blob->data = (uint8_t*)malloc(initial_size);
-    if (!blob->data) abort();
+    if (initial_size <= ANB_BLOB_INLINE_SIZE && !(flags & ~ANB_MEM_SECURE)) {
+        // One allocation: the data starts in the handle and spills on the first growth past it
+        blob->state = flags | ANB_MEM_SPILL | ANB_VMEM_EXTERNAL;
+        blob->data = blob->inline_buf;
+        blob->ext_cap = ANB_BLOB_INLINE_SIZE;
+    } else {
+        blob->state = flags;
+        blob->data = ANB_vmem_alloc(initial_size, &blob->state);
+        if (!blob->data) abort();
+    }
+    blob->capacity = initial_size;
+    blob->min_capacity = initial_size;
+    ANB_b_dirty_fresh(blob, 0);
+    ANB_blob_set_growth(blob, NULL);
+    blob->compact_pct = ANB_BLOB_COMPACT_DEFAULT;
+
+    return blob;
+}
+
+ANB_Blob_t* ANB_blob_init_in(void *buf, size_t len, unsigned flags) {
+    if (!buf) return NULL;
+    if (flags & ~(ANB_MEM_SPILL | ANB_MEM_SECURE)) return NULL;
+
+    // Layout: struct header | data, where the data takes the place of the inline buffer
+    uint8_t *base = (uint8_t *)ANB_B_ALIGN_UP((uintptr_t)buf);
+    uint8_t *end = (uint8_t *)buf + len;
+    if (base > end || (size_t)(end - base) <= ANB_B_HEAD) return NULL;
+
+    ANB_Blob_t* blob = (ANB_Blob_t*)base;
+    memset(blob, 0, ANB_B_HEAD);
+    blob->in_place = 1;
+    blob->state = flags | ANB_VMEM_EXTERNAL;
+    blob->data = base + ANB_B_HEAD;
+    blob->capacity = (size_t)(end - blob->data);
+    blob->ext_cap = blob->capacity;
+    blob->min_capacity = blob->capacity;
+    blob->dirty = blob->capacity;
+    ANB_blob_set_growth(blob, NULL);
+    blob->compact_pct = ANB_BLOB_COMPACT_DEFAULT;
+
+    return blob;
+}
+
+ANB_Blob_t* ANB_blob_create_compact(size_t initial_size) {
+    if (initial_size == 0) abort();
+    // Small sizes already fit inline; huge ones are mapped, where one more allocation is noise
+    if (initial_size <= ANB_BLOB_INLINE_SIZE || initial_size >= ANB_VMEM_MAP_THRESHOLD) {
+        return ANB_blob_create(initial_size);
+    }
+
+    ANB_Blob_t* blob = (ANB_Blob_t*)malloc(ANB_B_HEAD + initial_size);
+    if (!blob) abort();
+    memset(blob, 0, ANB_B_HEAD);
+    blob->state = ANB_MEM_SPILL | ANB_VMEM_EXTERNAL;
+    blob->data = blob->inline_buf;
     blob->capacity = initial_size;
+    blob->ext_cap = initial_size;
+    blob->min_capacity = initial_size;
+    blob->dirty = initial_size;
+    ANB_blob_set_growth(blob, NULL);
+    blob->compact_pct = ANB_BLOB_COMPACT_DEFAULT;
+
+    return blob;
+}
+
+ANB_Blob_t* ANB_blob_map_file(const char *path, unsigned flags) {
+    if (!path) {
+        errno = EINVAL;
+        return NULL;
+    }
+    if (flags & ~(ANB_BLOB_MAP_PRIVATE | ANB_BLOB_MAP_RANDOM | ANB_MEM_PREFAULT)) {
+        errno = EINVAL;
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+    struct stat st;
+    int err = 0;
+    if (fstat(fd, &st) != 0) err = errno;
+    else if (!S_ISREG(st.st_mode)) err = EINVAL;
+    else if ((uintmax_t)st.st_size > SIZE_MAX) err = EFBIG;
+    if (err) {
+        close(fd);
+        errno = err;
+        return NULL;
+    }
+    if (st.st_size == 0) {
+        // Nothing to map: an empty blob behaves the same
+        close(fd);
+        return ANB_blob_create(1);
+    }
+
+    size_t size = (size_t)st.st_size;
+    unsigned state = flags & ANB_MEM_PREFAULT;
+    if (!(flags & ANB_BLOB_MAP_PRIVATE)) state |= ANB_VMEM_READONLY;
+    uint8_t *data = ANB_vmem_map_file(fd, size, (flags & ANB_BLOB_MAP_RANDOM) != 0, &state);
+    err = errno;
+    close(fd); // The mapping keeps the file referenced
+    if (!data) {
+        errno = err;
+        return NULL;
+    }
+
+    ANB_Blob_t* blob = (ANB_Blob_t*)malloc(sizeof(ANB_Blob_t));
+    if (!blob) abort();
+    memset(blob, 0, ANB_B_HEAD);
+    blob->state = state;
+    blob->data = data;
+    blob->capacity = size;
+    blob->pos = size;
+    blob->min_capacity = size;
+    blob->dirty = size;
+    ANB_blob_set_growth(blob, NULL);
+    blob->compact_pct = ANB_BLOB_COMPACT_DEFAULT;
 
     return blob;
 }
 
 void ANB_blob_destroy(ANB_Blob_t* blob) {
     if (blob) {
-        free(blob->data);
-        free(blob);
+        if (blob->shared) ANB_blob_buf_release(blob->shared);
+        else ANB_vmem_free(blob->data, blob->capacity, blob->state);
+        free(blob->digest);
+        if (!blob->in_place) free(blob);
     }
 }
 
@@ -34,54 +194,221 @@ uint8_t* ANB_blob_data(ANB_Blob_t* blob) {
     return blob->data;
 }
 
+void ANB_blob_set_growth(ANB_Blob_t* blob, const ANB_GrowthPolicy_t *policy) {
+    if (!blob) abort();
+    static const ANB_GrowthPolicy_t def = ANB_GROWTH_DEFAULT;
+    if (policy) ANB_growth_check(policy);
+    blob->growth = policy ? *policy : def;
+}
+
+void ANB_blob_set_trim(ANB_Blob_t* blob, const ANB_TrimPolicy_t *policy) {
+    if (!blob) abort();
+    static const ANB_TrimPolicy_t off = { 0, 0, ANB_TRIM_SHRINK };
+    blob->trim = policy ? *policy : off;
+    memset(&blob->trim_state, 0, sizeof(blob->trim_state));
+}
+
+// Shrink to target bytes, never below the initial capacity or the written data
+static void ANB_b_shrink(ANB_Blob_t* blob, size_t target, int mode) {
+    if (target < blob->min_capacity) target = blob->min_capacity;
+    if (target < blob->pos) target = blob->pos;
+    if (target >= blob->capacity) return;
+    if (blob->state & ANB_VMEM_EXTERNAL) return; // Caller storage keeps its size
+    if (blob->shared) return;                    // Slices still see the whole buffer
+    if (mode == ANB_TRIM_RELEASE &&
+        ANB_vmem_release_tail(blob->data, blob->capacity, target, blob->state) == 0) return;
+    blob->data = ANB_vmem_resize(blob->data, blob->capacity, target, &blob->state);
+    if (!blob->data) abort();
+    blob->capacity = target;
+    ANB_b_dirty_fresh(blob, target);
+}
+
+// Called on reset/clear with the number of bytes used since the previous one
+static void ANB_b_auto_trim(ANB_Blob_t* blob, size_t used) {
+    size_t target = ANB_trim_track(&blob->trim, &blob->trim_state, used, blob->capacity);
+    if (target) ANB_b_shrink(blob, target, blob->trim.mode);
+}
+
+// Move the unread bytes to the front, dropping the consumed prefix
+static void ANB_b_compact(ANB_Blob_t* blob) {
+    if (blob->state & ANB_VMEM_READONLY) return; // A read-only file view has no writer to make room for
+    size_t unread = blob->pos - blob->rpos;
+    ANB_b_dirty_mark(blob);
+    memmove(blob->data, blob->data + blob->rpos, unread);
+    if (blob->state & ANB_MEM_SECURE) ANB_secure_zero(blob->data + unread, blob->rpos);
+    blob->pos = unread;
+    blob->rpos = 0;
+}
+
+void ANB_blob_trim(ANB_Blob_t* blob) {
+    if (!blob) abort();
+    if (blob->rpos) ANB_b_compact(blob);
+    ANB_b_shrink(blob, blob->pos, ANB_TRIM_SHRINK);
+}
+
 size_t ANB_blob_capacity(ANB_Blob_t* blob) {
     if (!blob) abort();
     return blob->capacity;
 }
 
-void ANB_blob_alloc(ANB_Blob_t* blob, size_t bytes) {
+// Stop sharing data: take the buffer back if no slice is left, otherwise copy the written bytes to a new one
+static void ANB_b_unshare(ANB_Blob_t* blob, size_t new_cap) {
+    ANB_BlobBuf_t *buf = blob->shared;
+    blob->shared = NULL;
+    if (atomic_load_explicit(&buf->refs, memory_order_acquire) == 1) {
+        blob->state = buf->state;
+        free(buf);
+        return;
+    }
+    unsigned state = blob->state & ANB_MEM_FLAGS_ALL;
+    uint8_t *data = ANB_vmem_alloc(new_cap, &state);
+    if (!data) abort();
+    memcpy(data, blob->data, blob->pos < new_cap ? blob->pos : new_cap);
+    ANB_blob_buf_release(buf);
+    blob->data = data;
+    blob->state = state;
+    blob->capacity = new_cap;
+    ANB_b_dirty_fresh(blob, 0);
+}
+
+// Move to new_cap bytes; only caller storage that may not spill can fail, everything else aborts
+static int ANB_b_resize(ANB_Blob_t* blob, size_t new_cap) {
+    if (blob->shared) {
+        ANB_b_unshare(blob, new_cap);
+        if (new_cap == blob->capacity && !(blob->state & ANB_VMEM_READONLY)) return 0;
+    }
+    if ((blob->state & ANB_VMEM_EXTERNAL) && new_cap <= blob->ext_cap) {
+        // Still fits the inline, compact or caller storage: nothing moves
+        if ((blob->state & ANB_MEM_SECURE) && new_cap < blob->capacity) {
+            ANB_secure_zero(blob->data + new_cap, blob->capacity - new_cap);
+        }
+        size_t old_cap = blob->capacity;
+        blob->capacity = new_cap;
+        ANB_b_dirty_fresh(blob, old_cap);
+        return 0;
+    }
+    uint8_t *data = ANB_vmem_resize(blob->data, blob->capacity, new_cap, &blob->state);
+    if (!data) {
+        if (ANB_VMEM_IS_FIXED(blob->state)) return -1;
+        abort();
+    }
+    size_t old_cap = blob->capacity;
+    blob->data = data;
+    blob->capacity = new_cap;
+    ANB_b_dirty_fresh(blob, old_cap);
+    return 0;
+}
+
+// Grow to at least required bytes by the growth policy, using up external storage before leaving it
+static int ANB_b_grow(ANB_Blob_t* blob, size_t required) {
+    size_t new_cap = ANB_growth_next(&blob->growth, blob->capacity, required);
+    if ((blob->state & ANB_VMEM_EXTERNAL) && required <= blob->ext_cap && new_cap > blob->ext_cap) {
+        new_cap = blob->ext_cap;
+    }
+    return ANB_b_resize(blob, new_cap);
+}
+
+// Make room for len more bytes at the write position: reclaim the consumed prefix first, then grow.
+// A read-only file view is copied to an owned buffer first, by the growth itself if it needs one.
+static int ANB_b_make_room(ANB_Blob_t* blob, size_t len) {
+    if ((blob->state & ANB_VMEM_READONLY) && len <= blob->capacity - blob->pos) {
+        return ANB_b_resize(blob, blob->capacity);
+    }
+    if (blob->rpos && blob->compact_pct) {
+        ANB_b_compact(blob);
+        if (len <= blob->capacity - blob->pos) return 0;
+    }
+    if (len > SIZE_MAX - blob->pos) abort();
+    return ANB_b_grow(blob, blob->pos + len);
+}
+
+int ANB_blob_alloc(ANB_Blob_t* blob, size_t bytes) {
     if (!blob) abort();
     size_t new_cap;
     if (bytes == 0) {
-        new_cap = blob->capacity * 2;
+        if (blob->capacity == SIZE_MAX) abort();
+        new_cap = ANB_growth_next(&blob->growth, blob->capacity, blob->capacity + 1);
     } else {
         new_cap = blob->capacity + bytes;
     }
     if (new_cap <= blob->capacity) abort();
-    blob->data = (uint8_t*)realloc(blob->data, new_cap);
-    if (!blob->data) abort();
-    blob->capacity = new_cap;
+    return ANB_b_resize(blob, new_cap);
 }
 
-void ANB_blob_realloc(ANB_Blob_t* blob, size_t new_capacity) {
+int ANB_blob_realloc(ANB_Blob_t* blob, size_t new_capacity) {
     if (!blob) abort();
     if (new_capacity == 0) abort();
-    blob->data = (uint8_t*)realloc(blob->data, new_capacity);
-    if (!blob->data) abort();
-    blob->capacity = new_capacity;
+    return ANB_b_resize(blob, new_capacity);
+}
+
+// Swap a read-only file view, or a buffer slices still see, for a fresh one of the same capacity.
+// Nothing is copied: the caller is about to zero it.
+static void ANB_b_drop_view(ANB_Blob_t* blob) {
+    if (blob->shared && atomic_load_explicit(&blob->shared->refs, memory_order_acquire) == 1) {
+        ANB_b_unshare(blob, blob->capacity); // Takes the buffer back without copying
+        if (!(blob->state & ANB_VMEM_READONLY)) return;
+    }
+    unsigned state = blob->state & ANB_MEM_FLAGS_ALL;
+    uint8_t *data = ANB_vmem_alloc(blob->capacity, &state);
+    if (!data) abort();
+    if (blob->shared) {
+        ANB_blob_buf_release(blob->shared);
+        blob->shared = NULL;
+    } else {
+        ANB_vmem_free(blob->data, blob->capacity, blob->state);
+    }
+    blob->data = data;
+    blob->state = state;
+    blob->pos = 0;
+    blob->dirty = 0;
+    ANB_b_dirty_fresh(blob, 0);
 }
 
 void ANB_blob_clear(ANB_Blob_t* blob) {
     if (!blob) abort();
-    memset(blob->data, 0, blob->capacity);
+    size_t used = blob->pos;
+    if (blob->state & ANB_VMEM_READONLY) ANB_b_drop_view(blob);
+    if (blob->state & ANB_MEM_SECURE) {
+        ANB_secure_zero(blob->data, blob->capacity);
+    } else {
+        // Past the high-water mark the buffer is still zero from the last clear or allocation
+        ANB_b_dirty_mark(blob);
+        ANB_vmem_zero(blob->data, blob->dirty, blob->state);
+    }
+    blob->dirty = 0;
     blob->pos = 0;
+    blob->rpos = 0;
+    if (blob->digest) ANB_digest_start(blob->digest, &blob->digest->spec);
+    ANB_b_auto_trim(blob, used);
 }
 
-void ANB_blob_push(ANB_Blob_t* blob, const uint8_t* bytes, size_t len) {
+int ANB_blob_push(ANB_Blob_t* blob, const uint8_t* bytes, size_t len) {
     if (!blob) abort();
-    if (len == 0) return;
-    if (blob->pos + len > blob->capacity) {
-        size_t new_cap = blob->capacity;
-        while (new_cap < blob->pos + len) {
-            new_cap *= 2;
-            if (new_cap <= blob->capacity) abort();
-        }
-        blob->data = (uint8_t*)realloc(blob->data, new_cap);
-        if (!blob->data) abort();
-        blob->capacity = new_cap;
+    if (len == 0) return 0;
+    if (len > blob->capacity - blob->pos || (blob->state & ANB_VMEM_READONLY)) {
+        if (ANB_b_make_room(blob, len) != 0) return -1;
     }
     memcpy(blob->data + blob->pos, bytes, len);
+    // Hash the source while it is still in cache
+    if (blob->digest) ANB_digest_update(blob->digest, bytes, len);
     blob->pos += len;
+    return 0;
+}
+
+uint8_t *ANB_blob_reserve(ANB_Blob_t* blob, size_t min_len, size_t *avail) {
+    if (!blob) abort();
+    if (min_len > blob->capacity - blob->pos || (blob->state & ANB_VMEM_READONLY)) {
+        if (ANB_b_make_room(blob, min_len) != 0) return NULL;
+    }
+    if (avail) *avail = blob->capacity - blob->pos;
+    return blob->data + blob->pos;
+}
+
+void ANB_blob_commit(ANB_Blob_t* blob, size_t n) {
+    if (!blob) abort();
+    if (n > blob->capacity - blob->pos) abort();
+    if (blob->digest && n) ANB_digest_update(blob->digest, blob->data + blob->pos, n);
+    blob->pos += n;
 }
 
 size_t ANB_blob_data_len(ANB_Blob_t* blob) {
@@ -89,7 +416,116 @@ size_t ANB_blob_data_len(ANB_Blob_t* blob) {
     return blob->pos;
 }
 
+// Rewind to an empty blob; the digest keeps running
+static void ANB_b_rewind(ANB_Blob_t* blob) {
+    size_t used = blob->pos;
+    ANB_b_dirty_mark(blob);
+    // Shared bytes are wiped by the last release instead
+    if ((blob->state & ANB_MEM_SECURE) && !blob->shared) ANB_secure_zero(blob->data, used);
+    blob->pos = 0;
+    blob->rpos = 0;
+    ANB_b_auto_trim(blob, used);
+}
+
 void ANB_blob_reset(ANB_Blob_t* blob) {
     if (!blob) abort();
-    blob->pos = 0;
+    ANB_b_rewind(blob);
+    if (blob->digest) ANB_digest_start(blob->digest, &blob->digest->spec);
+}
+
+uint8_t *ANB_blob_peek(ANB_Blob_t* blob, size_t *len) {
+    if (!blob) abort();
+    if (len) *len = blob->pos - blob->rpos;
+    return blob->data + blob->rpos;
+}
+
+void ANB_blob_consume(ANB_Blob_t* blob, size_t n) {
+    if (!blob) abort();
+    if (n > blob->pos - blob->rpos) abort();
+    if (n == 0) return;
+    blob->rpos += n;
+    if (blob->rpos == blob->pos) {
+        // Everything read: rewind instead of moving anything
+        ANB_b_rewind(blob);
+        return;
+    }
+    if (blob->compact_pct) {
+        size_t pct = blob->compact_pct > 100 ? 100 : blob->compact_pct;
+        size_t threshold = (blob->capacity / 100) * pct + ((blob->capacity % 100) * pct) / 100;
+        if (blob->rpos >= threshold) ANB_b_compact(blob);
+    }
+}
+
+void ANB_blob_compact(ANB_Blob_t* blob) {
+    if (!blob) abort();
+    if (blob->rpos) ANB_b_compact(blob);
+}
+
+void ANB_blob_set_compact(ANB_Blob_t* blob, uint32_t pct) {
+    if (!blob) abort();
+    blob->compact_pct = pct;
+}
+
+int ANB_blob_can_grow(ANB_Blob_t* blob) {
+    if (!blob) abort();
+    return !ANB_VMEM_IS_FIXED(blob->state);
+}
+
+ANB_BlobBuf_t *ANB_blob_share(ANB_Blob_t* blob) {
+    if (!blob) abort();
+    if (!blob->shared) {
+        if (blob->state & ANB_VMEM_EXTERNAL) {
+            // Inline, compact and caller storage dies with the handle: spill it to an owned buffer once
+            if (ANB_VMEM_IS_FIXED(blob->state)) return NULL;
+            unsigned state = blob->state & ANB_MEM_FLAGS_ALL;
+            uint8_t *data = ANB_vmem_alloc(blob->capacity, &state);
+            if (!data) abort();
+            memcpy(data, blob->data, blob->pos);
+            ANB_vmem_free(blob->data, blob->capacity, blob->state);
+            blob->data = data;
+            blob->state = state;
+            blob->ext_cap = 0;
+            ANB_b_dirty_fresh(blob, 0);
+        }
+        ANB_BlobBuf_t *buf = (ANB_BlobBuf_t *)malloc(sizeof(*buf));
+        if (!buf) abort();
+        atomic_init(&buf->refs, 1);
+        buf->data = blob->data;
+        buf->capacity = blob->capacity;
+        buf->state = blob->state;
+        blob->shared = buf;
+        blob->state |= ANB_VMEM_READONLY;   // Routes every write through ANB_b_resize, which unshares
+    }
+    atomic_fetch_add_explicit(&blob->shared->refs, 1, memory_order_relaxed);
+    return blob->shared;
+}
+
+void ANB_blob_buf_release(ANB_BlobBuf_t *buf) {
+    if (atomic_fetch_sub_explicit(&buf->refs, 1, memory_order_acq_rel) != 1) return;
+    ANB_vmem_free(buf->data, buf->capacity, buf->state);
+    free(buf);
+}
+
+int ANB_blob_is_shared(ANB_Blob_t* blob) {
+    if (!blob) abort();
+    return blob->shared != NULL;
+}
+
+void ANB_blob_set_digest(ANB_Blob_t* blob, const ANB_DigestSpec_t *spec) {
+    if (!blob) abort();
+    if (!spec || spec->kind == ANB_DIGEST_NONE) {
+        free(blob->digest);
+        blob->digest = NULL;
+        return;
+    }
+    if (!blob->digest) {
+        blob->digest = (ANB_DigestState_t *)malloc(sizeof(ANB_DigestState_t));
+        if (!blob->digest) abort();
+    }
+    ANB_digest_start(blob->digest, spec);
+}
+
+uint64_t ANB_blob_digest(ANB_Blob_t* blob) {
+    if (!blob) abort();
+    return blob->digest ? ANB_digest_value(blob->digest) : 0;
 }
@@ -0,0 +1,226 @@
+#include <stdint.h>
+#include "blob_codec.h"
+#include "simd.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if ANB_SIMD_X86
+#include <immintrin.h>
+#endif
+
+int ANB_blob_writer_begin(ANB_BlobWriter_t *w, ANB_Blob_t *blob, size_t max_len) {
+    if (!w || !blob) abort();
+    size_t avail;
+    uint8_t *tail = ANB_blob_reserve(blob, max_len, &avail);
+    if (!tail) return -1;
+    w->_blob = blob;
+    w->_start = w->_p = tail;
+    w->_end = tail + avail;
+    return 0;
+}
+
+size_t ANB_blob_writer_end(ANB_BlobWriter_t *w) {
+    if (!w || !w->_blob) abort();
+    if (w->_p < w->_start || w->_p > w->_end) abort();
+    size_t n = (size_t)(w->_p - w->_start);
+    ANB_blob_commit(w->_blob, n);
+    w->_blob = NULL;
+    return n;
+}
+
+void ANB_blob_reader_begin(ANB_BlobReader_t *r, ANB_Blob_t *blob) {
+    if (!r || !blob) abort();
+    size_t len;
+    const uint8_t *p = ANB_blob_peek(blob, &len);
+    r->_blob = blob;
+    r->_start = r->_p = p;
+    r->_end = p + len;
+    r->_err = 0;
+}
+
+long long ANB_blob_reader_end(ANB_BlobReader_t *r) {
+    if (!r || !r->_blob) abort();
+    ANB_Blob_t *blob = r->_blob;
+    r->_blob = NULL;
+    if (r->_err) return -1;
+    size_t n = (size_t)(r->_p - r->_start);
+    if (n) ANB_blob_consume(blob, n);
+    return (long long)n;
+}
+
+/* ------------------------------------------------------------------ */
+/* Stream VByte                                                       */
+/* ------------------------------------------------------------------ */
+// Layout: ceil(count / 4) control bytes, two bits per value (byte length - 1,
+// first value in the low bits), then each value's low bytes, little-endian.
+
+typedef size_t (*ANB_SvbEncodeFn)(const uint32_t *in, size_t count, uint8_t *out);
+typedef size_t (*ANB_SvbDecodeFn)(const uint8_t *in, size_t in_len, uint32_t *out, size_t count);
+
+static pthread_once_t ANB_svb_once = PTHREAD_ONCE_INIT;
+static ANB_SvbEncodeFn ANB_svb_encode_impl;
+static ANB_SvbDecodeFn ANB_svb_decode_impl;
+static uint8_t ANB_svb_len[256];           // Data bytes of a group of four, by control byte
+
+static inline unsigned ANB_svb_code(uint32_t v) {
+    return (v > 0xFF) + (v > 0xFFFF) + (v > 0xFFFFFF);
+}
+
+// Encode up to four values; returns the data bytes written at data
+static inline size_t ANB_svb_encode_group(const uint32_t *in, size_t n, uint8_t *ctrl, uint8_t *data) {
+    uint8_t c = 0;
+    size_t len = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t v = in[i];
+        unsigned code = ANB_svb_code(v);
+        c |= (uint8_t)(code << (2 * i));
+        for (unsigned k = 0; k <= code; k++) data[len++] = (uint8_t)(v >> (8 * k));
+    }
+    *ctrl = c;
+    return len;
+}
+
+static size_t ANB_svb_encode_scalar(const uint32_t *in, size_t count, uint8_t *out) {
+    uint8_t *ctrl = out;
+    uint8_t *data = out + (count + 3) / 4;
+    for (size_t i = 0; i < count; i += 4) {
+        size_t n = count - i < 4 ? count - i : 4;
+        data += ANB_svb_encode_group(in + i, n, ctrl++, data);
+    }
+    return (size_t)(data - out);
+}
+
+// Decode n values of one group; returns the data bytes read, or 0 if they pass end
+static inline size_t ANB_svb_decode_group(uint8_t c, size_t n, const uint8_t *data, const uint8_t *end,
+                                          uint32_t *out) {
+    const uint8_t *p = data;
+    for (size_t i = 0; i < n; i++) {
+        unsigned len = ((c >> (2 * i)) & 3) + 1;
+        if ((size_t)(end - p) < len) return 0;
+        uint32_t v = 0;
+        for (unsigned k = 0; k < len; k++) v |= (uint32_t)p[k] << (8 * k);
+        out[i] = v;
+        p += len;
+    }
+    return (size_t)(p - data);
+}
+
+static size_t ANB_svb_decode_scalar(const uint8_t *in, size_t in_len, uint32_t *out, size_t count) {
+    size_t nctrl = (count + 3) / 4;
+    if (in_len < nctrl) return 0;
+    const uint8_t *end = in + in_len;
+    const uint8_t *data = in + nctrl;
+    for (size_t i = 0; i < count; i += 4) {
+        size_t n = count - i < 4 ? count - i : 4;
+        size_t len = ANB_svb_decode_group(in[i / 4], n, data, end, out + i);
+        if (!len) return 0;
+        data += len;
+    }
+    return (size_t)(data - in);
+}
+
+#if ANB_SIMD_X86
+static uint8_t ANB_svb_dec_shuf[256][16];  // Spreads a group's data bytes to four 32-bit lanes
+static uint8_t ANB_svb_enc_shuf[256][16];  // Packs four 32-bit lanes to their low bytes
+
+// One group per iteration: control bytes from three unsigned compares, data
+// bytes packed with one shuffle. Every full group writes 16 bytes, which the
+// 4 bytes per value of ANB_CODEC_SVB_BOUND always leave room for.
+ANB_SIMD_TARGET("ssse3")
+static size_t ANB_svb_encode_ssse3(const uint32_t *in, size_t count, uint8_t *out) {
+    uint8_t *ctrl = out;
+    uint8_t *data = out + (count + 3) / 4;
+    const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+    const __m128i t1 = _mm_set1_epi32((int)(0xFFu ^ 0x80000000u));
+    const __m128i t2 = _mm_set1_epi32((int)(0xFFFFu ^ 0x80000000u));
+    const __m128i t3 = _mm_set1_epi32((int)(0xFFFFFFu ^ 0x80000000u));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i s = _mm_xor_si128(v, bias);
+        // Each compare is -1 where the lane needs one more byte
+        __m128i code = _mm_sub_epi32(_mm_setzero_si128(),
+                                     _mm_add_epi32(_mm_add_epi32(_mm_cmpgt_epi32(s, t1), _mm_cmpgt_epi32(s, t2)),
+                                                   _mm_cmpgt_epi32(s, t3)));
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(code, code), code);
+        uint32_t x = (uint32_t)_mm_cvtsi128_si32(packed);
+        uint8_t c = (uint8_t)(x | (x >> 6) | (x >> 12) | (x >> 18));
+        *ctrl++ = c;
+        __m128i shuf = _mm_loadu_si128((const __m128i *)ANB_svb_enc_shuf[c]);
+        _mm_storeu_si128((__m128i *)data, _mm_shuffle_epi8(v, shuf));
+        data += ANB_svb_len[c];
+    }
+    if (i < count) data += ANB_svb_encode_group(in + i, count - i, ctrl, data);
+    return (size_t)(data - out);
+}
+
+// Groups are decoded with one 16-byte load and shuffle while 16 bytes of
+// input remain, so the load never crosses in_len; the rest goes scalar.
+ANB_SIMD_TARGET("ssse3")
+static size_t ANB_svb_decode_ssse3(const uint8_t *in, size_t in_len, uint32_t *out, size_t count) {
+    size_t nctrl = (count + 3) / 4;
+    if (in_len < nctrl) return 0;
+    const uint8_t *end = in + in_len;
+    const uint8_t *data = in + nctrl;
+    size_t i = 0;
+    for (; i + 4 <= count && end - data >= 16; i += 4) {
+        uint8_t c = in[i / 4];
+        __m128i d = _mm_loadu_si128((const __m128i *)data);
+        __m128i shuf = _mm_loadu_si128((const __m128i *)ANB_svb_dec_shuf[c]);
+        _mm_storeu_si128((__m128i *)(out + i), _mm_shuffle_epi8(d, shuf));
+        data += ANB_svb_len[c];
+    }
+    for (; i < count; i += 4) {
+        size_t n = count - i < 4 ? count - i : 4;
+        size_t len = ANB_svb_decode_group(in[i / 4], n, data, end, out + i);
+        if (!len) return 0;
+        data += len;
+    }
+    return (size_t)(data - in);
+}
+#endif
+
+static void ANB_svb_init(void) {
+    for (unsigned c = 0; c < 256; c++) {
+        unsigned pos = 0;
+        for (unsigned lane = 0; lane < 4; lane++) {
+            unsigned len = ((c >> (2 * lane)) & 3) + 1;
+#if ANB_SIMD_X86
+            for (unsigned k = 0; k < 4; k++) {
+                ANB_svb_dec_shuf[c][4 * lane + k] = k < len ? (uint8_t)(pos + k) : 0xFF;
+            }
+            for (unsigned k = 0; k < len; k++) ANB_svb_enc_shuf[c][pos + k] = (uint8_t)(4 * lane + k);
+#endif
+            pos += len;
+        }
+#if ANB_SIMD_X86
+        for (unsigned k = pos; k < 16; k++) ANB_svb_enc_shuf[c][k] = 0xFF;
+#endif
+        ANB_svb_len[c] = (uint8_t)pos;
+    }
+    ANB_svb_encode_impl = ANB_svb_encode_scalar;
+    ANB_svb_decode_impl = ANB_svb_decode_scalar;
+#if ANB_SIMD_X86
+    if (ANB_simd_has(ANB_SIMD_SSSE3)) {
+        ANB_svb_encode_impl = ANB_svb_encode_ssse3;
+        ANB_svb_decode_impl = ANB_svb_decode_ssse3;
+    }
+#endif
+}
+
+size_t ANB_codec_svb_encode(const uint32_t *in, size_t count, uint8_t *out) {
+    if (!count) return 0;
+    if (!in || !out) abort();
+    pthread_once(&ANB_svb_once, ANB_svb_init);
+    return ANB_svb_encode_impl(in, count, out);
+}
+
+size_t ANB_codec_svb_decode(const uint8_t *in, size_t in_len, uint32_t *out, size_t count) {
+    if (!count) return 0;
+    if (!out) abort();
+    if (!in) return 0;
+    pthread_once(&ANB_svb_once, ANB_svb_init);
+    return ANB_svb_decode_impl(in, in_len, out, count);
+}
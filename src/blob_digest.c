@@ -0,0 +1,335 @@
+#include <stdint.h>
+#include "blob_digest.h"
+#include "digest_internal.h"
+#include "simd.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if ANB_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#define ANB_CRC32C_POLY 0x82F63B78u   // Castagnoli, bit-reflected
+
+#define ANB_XXH_P1 0x9E3779B185EBCA87ULL
+#define ANB_XXH_P2 0xC2B2AE3D27D4EB4FULL
+#define ANB_XXH_P3 0x165667B19E3779F9ULL
+#define ANB_XXH_P4 0x85EBCA77C2B2AE63ULL
+#define ANB_XXH_P5 0x27D4EB2F165667C5ULL
+
+/* ------------------------------------------------------------------ */
+/* CRC32C                                                             */
+/* ------------------------------------------------------------------ */
+// Kernels take and return the raw register (pre- and post-inverted by the caller)
+typedef uint32_t (*ANB_Crc32cFn)(uint32_t crc, const uint8_t *p, size_t n);
+
+static pthread_once_t ANB_crc32c_once = PTHREAD_ONCE_INIT;
+static ANB_Crc32cFn ANB_crc32c_impl;
+static uint32_t ANB_crc32c_table[8][256];
+
+static inline uint64_t ANB_d_load64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline uint32_t ANB_d_load32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+// Slicing-by-8: one table lookup per input byte, eight independent per step
+static uint32_t ANB_crc32c_sw(uint32_t crc, const uint8_t *p, size_t n) {
+    uint32_t (*t)[256] = ANB_crc32c_table;
+    for (; n >= 8; n -= 8, p += 8) {
+        uint64_t v = ANB_d_load64(p) ^ crc;
+        crc = t[7][v & 0xFF] ^ t[6][(v >> 8) & 0xFF] ^ t[5][(v >> 16) & 0xFF] ^ t[4][(v >> 24) & 0xFF] ^
+              t[3][(v >> 32) & 0xFF] ^ t[2][(v >> 40) & 0xFF] ^ t[1][(v >> 48) & 0xFF] ^ t[0][v >> 56];
+    }
+    while (n--) crc = t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+#if ANB_SIMD_X86
+// Block sizes of the three-way interleaved loop: crc32 has a latency of three
+// cycles but issues one per cycle, so three independent streams keep it busy
+#define ANB_CRC32C_LONG 8192
+#define ANB_CRC32C_SHORT 256
+
+// Operators that append LONG / SHORT zero bytes to a register, as slicing tables
+static uint32_t ANB_crc32c_long[4][256];
+static uint32_t ANB_crc32c_short[4][256];
+
+static uint32_t ANB_gf2_times(const uint32_t *mat, uint32_t vec) {
+    uint32_t sum = 0;
+    for (; vec; vec >>= 1, mat++) {
+        if (vec & 1) sum ^= *mat;
+    }
+    return sum;
+}
+
+static void ANB_gf2_square(uint32_t *square, const uint32_t *mat) {
+    for (int n = 0; n < 32; n++) square[n] = ANB_gf2_times(mat, mat[n]);
+}
+
+// Build the matrix for len zero bytes by repeated squaring of the one-bit operator
+static void ANB_crc32c_zeros(uint32_t zeros[4][256], size_t len) {
+    uint32_t even[32], odd[32];
+    odd[0] = ANB_CRC32C_POLY;
+    for (int n = 1; n < 32; n++) odd[n] = 1u << (n - 1);
+    ANB_gf2_square(even, odd);          // 2 zero bits
+    ANB_gf2_square(odd, even);          // 4 zero bits
+    const uint32_t *op;
+    for (;;) {
+        ANB_gf2_square(even, odd);      // 1, 4, 16... zero bytes
+        len >>= 1;
+        if (!len) {
+            op = even;
+            break;
+        }
+        ANB_gf2_square(odd, even);
+        len >>= 1;
+        if (!len) {
+            op = odd;
+            break;
+        }
+    }
+    for (uint32_t n = 0; n < 256; n++) {
+        zeros[0][n] = ANB_gf2_times(op, n);
+        zeros[1][n] = ANB_gf2_times(op, n << 8);
+        zeros[2][n] = ANB_gf2_times(op, n << 16);
+        zeros[3][n] = ANB_gf2_times(op, n << 24);
+    }
+}
+
+static inline uint32_t ANB_crc32c_shift(uint32_t zeros[4][256], uint32_t crc) {
+    return zeros[0][crc & 0xFF] ^ zeros[1][(crc >> 8) & 0xFF] ^ zeros[2][(crc >> 16) & 0xFF] ^ zeros[3][crc >> 24];
+}
+
+#if defined(__x86_64__)
+// Three streams over consecutive blocks of len bytes each, merged by shifting
+#define ANB_CRC32C_3WAY(crc, p, n, len, zeros)                                                                  \
+    while ((n) >= 3 * (len)) {                                                                                  \
+        uint64_t c0 = (crc), c1 = 0, c2 = 0;                                                                    \
+        for (const uint8_t *end = (p) + (len); (p) < end; (p) += 8) {                                           \
+            uint64_t v0, v1, v2;                                                                                \
+            memcpy(&v0, (p), 8);                                                                                \
+            memcpy(&v1, (p) + (len), 8);                                                                        \
+            memcpy(&v2, (p) + 2 * (len), 8);                                                                    \
+            c0 = _mm_crc32_u64(c0, v0);                                                                         \
+            c1 = _mm_crc32_u64(c1, v1);                                                                         \
+            c2 = _mm_crc32_u64(c2, v2);                                                                         \
+        }                                                                                                       \
+        (crc) = ANB_crc32c_shift(zeros, (uint32_t)c0) ^ (uint32_t)c1;                                           \
+        (crc) = ANB_crc32c_shift(zeros, (crc)) ^ (uint32_t)c2;                                                  \
+        (p) += 2 * (len);                                                                                       \
+        (n) -= 3 * (len);                                                                                       \
+    }
+#endif
+
+ANB_SIMD_TARGET("sse4.2")
+static uint32_t ANB_crc32c_hw(uint32_t crc, const uint8_t *p, size_t n) {
+#if defined(__x86_64__)
+    ANB_CRC32C_3WAY(crc, p, n, ANB_CRC32C_LONG, ANB_crc32c_long)
+    ANB_CRC32C_3WAY(crc, p, n, ANB_CRC32C_SHORT, ANB_crc32c_short)
+    uint64_t c = crc;
+    for (; n >= 8; n -= 8, p += 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        c = _mm_crc32_u64(c, v);
+    }
+    crc = (uint32_t)c;
+#endif
+    for (; n >= 4; n -= 4, p += 4) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        crc = _mm_crc32_u32(crc, v);
+    }
+    while (n--) crc = _mm_crc32_u8(crc, *p++);
+    return crc;
+}
+#endif
+
+static void ANB_crc32c_init(void) {
+    for (unsigned i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) c = (c >> 1) ^ (ANB_CRC32C_POLY & (0u - (c & 1)));
+        ANB_crc32c_table[0][i] = c;
+    }
+    for (unsigned i = 0; i < 256; i++) {
+        for (int s = 1; s < 8; s++) {
+            uint32_t c = ANB_crc32c_table[s - 1][i];
+            ANB_crc32c_table[s][i] = ANB_crc32c_table[0][c & 0xFF] ^ (c >> 8);
+        }
+    }
+    ANB_crc32c_impl = ANB_crc32c_sw;
+#if ANB_SIMD_X86
+    if (ANB_simd_has(ANB_SIMD_SSE42)) {
+        ANB_crc32c_zeros(ANB_crc32c_long, ANB_CRC32C_LONG);
+        ANB_crc32c_zeros(ANB_crc32c_short, ANB_CRC32C_SHORT);
+        ANB_crc32c_impl = ANB_crc32c_hw;
+    }
+#endif
+}
+
+/* ------------------------------------------------------------------ */
+/* XXH64                                                              */
+/* ------------------------------------------------------------------ */
+static inline uint64_t ANB_xxh_rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t ANB_xxh_round(uint64_t acc, uint64_t input) {
+    acc += input * ANB_XXH_P2;
+    return ANB_xxh_rotl(acc, 31) * ANB_XXH_P1;
+}
+
+static inline uint64_t ANB_xxh_merge(uint64_t h, uint64_t acc) {
+    h ^= ANB_xxh_round(0, acc);
+    return h * ANB_XXH_P1 + ANB_XXH_P4;
+}
+
+// Whole 32-byte stripes of p into the four lanes; returns the bytes taken
+static size_t ANB_xxh_stripes(uint64_t acc[4], const uint8_t *p, size_t n) {
+    uint64_t v1 = acc[0], v2 = acc[1], v3 = acc[2], v4 = acc[3];
+    size_t done = 0;
+    for (; n - done >= 32; done += 32) {
+        v1 = ANB_xxh_round(v1, ANB_d_load64(p + done));
+        v2 = ANB_xxh_round(v2, ANB_d_load64(p + done + 8));
+        v3 = ANB_xxh_round(v3, ANB_d_load64(p + done + 16));
+        v4 = ANB_xxh_round(v4, ANB_d_load64(p + done + 24));
+    }
+    acc[0] = v1;
+    acc[1] = v2;
+    acc[2] = v3;
+    acc[3] = v4;
+    return done;
+}
+
+static uint64_t ANB_xxh_value(const ANB_DigestState_t *st) {
+    uint64_t h;
+    if (st->total >= 32) {
+        h = ANB_xxh_rotl(st->acc[0], 1) + ANB_xxh_rotl(st->acc[1], 7) + ANB_xxh_rotl(st->acc[2], 12) +
+            ANB_xxh_rotl(st->acc[3], 18);
+        for (int i = 0; i < 4; i++) h = ANB_xxh_merge(h, st->acc[i]);
+    } else {
+        h = st->spec.seed + ANB_XXH_P5;
+    }
+    h += st->total;
+
+    const uint8_t *p = st->buf;
+    size_t n = st->buf_len;
+    for (; n >= 8; n -= 8, p += 8) {
+        h ^= ANB_xxh_round(0, ANB_d_load64(p));
+        h = ANB_xxh_rotl(h, 27) * ANB_XXH_P1 + ANB_XXH_P4;
+    }
+    if (n >= 4) {
+        h ^= (uint64_t)ANB_d_load32(p) * ANB_XXH_P1;
+        h = ANB_xxh_rotl(h, 23) * ANB_XXH_P2 + ANB_XXH_P3;
+        n -= 4;
+        p += 4;
+    }
+    while (n--) {
+        h ^= *p++ * ANB_XXH_P5;
+        h = ANB_xxh_rotl(h, 11) * ANB_XXH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= ANB_XXH_P2;
+    h ^= h >> 29;
+    h *= ANB_XXH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+static void ANB_xxh_update(ANB_DigestState_t *st, const uint8_t *p, size_t n) {
+    st->total += n;
+    if (st->buf_len) {
+        // Complete the pending stripe first
+        size_t take = 32 - st->buf_len < n ? 32 - st->buf_len : n;
+        memcpy(st->buf + st->buf_len, p, take);
+        st->buf_len += take;
+        p += take;
+        n -= take;
+        if (st->buf_len < 32) return;
+        ANB_xxh_stripes(st->acc, st->buf, 32);
+        st->buf_len = 0;
+    }
+    size_t done = ANB_xxh_stripes(st->acc, p, n);
+    memcpy(st->buf, p + done, n - done);
+    st->buf_len = n - done;
+}
+
+/* ------------------------------------------------------------------ */
+/* Dispatch                                                           */
+/* ------------------------------------------------------------------ */
+void ANB_digest_start(ANB_DigestState_t *st, const ANB_DigestSpec_t *spec) {
+    ANB_DigestSpec_t s = *spec;
+    switch (s.kind) {
+    case ANB_DIGEST_CRC32C:
+        pthread_once(&ANB_crc32c_once, ANB_crc32c_init);
+        break;
+    case ANB_DIGEST_XXH64:
+        break;
+    case ANB_DIGEST_HOOK:
+        if (!s.hook) abort();
+        break;
+    default:
+        abort();
+    }
+    memset(st, 0, sizeof(*st));
+    st->spec = s;
+    if (s.kind == ANB_DIGEST_XXH64) {
+        st->acc[0] = s.seed + ANB_XXH_P1 + ANB_XXH_P2;
+        st->acc[1] = s.seed + ANB_XXH_P2;
+        st->acc[2] = s.seed;
+        st->acc[3] = s.seed - ANB_XXH_P1;
+    } else if (s.kind == ANB_DIGEST_CRC32C) {
+        st->acc[0] = ~(uint32_t)s.seed;
+    } else {
+        st->acc[0] = s.seed;
+    }
+}
+
+void ANB_digest_update(ANB_DigestState_t *st, const uint8_t *data, size_t len) {
+    switch (st->spec.kind) {
+    case ANB_DIGEST_CRC32C:
+        st->acc[0] = ANB_crc32c_impl((uint32_t)st->acc[0], data, len);
+        break;
+    case ANB_DIGEST_XXH64:
+        ANB_xxh_update(st, data, len);
+        break;
+    default:
+        st->acc[0] = st->spec.hook(st->spec.ctx, st->acc[0], data, len);
+        break;
+    }
+}
+
+uint64_t ANB_digest_value(const ANB_DigestState_t *st) {
+    switch (st->spec.kind) {
+    case ANB_DIGEST_CRC32C:
+        return (uint32_t)~st->acc[0];
+    case ANB_DIGEST_XXH64:
+        return ANB_xxh_value(st);
+    default:
+        return st->acc[0];
+    }
+}
+
+uint64_t ANB_digest(const ANB_DigestSpec_t *spec, const uint8_t *data, size_t len) {
+    if (!spec) abort();
+    if (spec->kind == ANB_DIGEST_NONE) return 0;
+    ANB_DigestState_t st;
+    ANB_digest_start(&st, spec);
+    if (len) ANB_digest_update(&st, data, len);
+    return ANB_digest_value(&st);
+}
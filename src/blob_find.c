@@ -0,0 +1,187 @@
+#include <stdint.h>
+#include "blob.h"
+#include "simd.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if ANB_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Largest set ANB_blob_find_any compares with vector registers; larger sets use a table
+#define ANB_FIND_SET_MAX 8
+
+// Kernels search h[0, n) and return the match index or ANB_BLOB_NPOS
+typedef size_t (*ANB_FindAnyFn)(const uint8_t *h, size_t n, const uint8_t *set, size_t set_len);
+typedef size_t (*ANB_FindFn)(const uint8_t *h, size_t n, const uint8_t *p, size_t m);
+
+static pthread_once_t ANB_find_once = PTHREAD_ONCE_INIT;
+static ANB_FindAnyFn ANB_find_any_impl;
+static ANB_FindFn ANB_find_impl;
+
+static size_t ANB_find_any_table(const uint8_t *h, size_t n, const uint8_t *set, size_t set_len) {
+    uint8_t in_set[256] = {0};
+    for (size_t j = 0; j < set_len; j++) in_set[set[j]] = 1;
+    for (size_t i = 0; i < n; i++) {
+        if (in_set[h[i]]) return i;
+    }
+    return ANB_BLOB_NPOS;
+}
+
+static size_t ANB_find_scalar(const uint8_t *h, size_t n, const uint8_t *p, size_t m) {
+    if (m > n) return ANB_BLOB_NPOS;
+    const uint8_t *cur = h;
+    const uint8_t *last = h + (n - m);
+    while (cur <= last) {
+        cur = (const uint8_t *)memchr(cur, p[0], (size_t)(last - cur) + 1);
+        if (!cur) break;
+        if (cur[m - 1] == p[m - 1] && memcmp(cur + 1, p + 1, m - 2) == 0) return (size_t)(cur - h);
+        cur++;
+    }
+    return ANB_BLOB_NPOS;
+}
+
+#if ANB_SIMD_X86
+// A two-byte set (CR and LF) gets its own copy of the loop with both compares unrolled
+#define ANB_FIND_ANY_KERNEL(name, isa, vec, width, set1, cmpeq, or_, load, movemask)                            \
+    ANB_SIMD_TARGET(isa)                                                                                        \
+    static inline __attribute__((always_inline)) size_t name##_k(const uint8_t *h, size_t n,                    \
+                                                                 const uint8_t *set, size_t k) {                \
+        vec v[ANB_FIND_SET_MAX];                                                                                \
+        for (size_t j = 0; j < k; j++) v[j] = set1((char)set[j]);                                               \
+        size_t i = 0;                                                                                           \
+        for (; i + (width) <= n; i += (width)) {                                                                \
+            vec d = load((const vec *)(h + i));                                                                 \
+            vec m = cmpeq(d, v[0]);                                                                             \
+            for (size_t j = 1; j < k; j++) m = or_(m, cmpeq(d, v[j]));                                          \
+            unsigned mask = (unsigned)movemask(m);                                                              \
+            if (mask) return i + (size_t)__builtin_ctz(mask);                                                   \
+        }                                                                                                       \
+        if (i == n) return ANB_BLOB_NPOS;                                                                       \
+        if (n >= (width)) {                                                                                     \
+            /* Last block overlaps the one before; drop the bytes already checked */                            \
+            size_t at = n - (width);                                                                            \
+            vec d = load((const vec *)(h + at));                                                                \
+            vec m = cmpeq(d, v[0]);                                                                             \
+            for (size_t j = 1; j < k; j++) m = or_(m, cmpeq(d, v[j]));                                          \
+            unsigned mask = (unsigned)movemask(m) & (~0u << (i - at));                                          \
+            return mask ? at + (size_t)__builtin_ctz(mask) : ANB_BLOB_NPOS;                                     \
+        }                                                                                                       \
+        for (; i < n; i++) {                                                                                    \
+            for (size_t j = 0; j < k; j++) {                                                                    \
+                if (h[i] == set[j]) return i;                                                                   \
+            }                                                                                                   \
+        }                                                                                                       \
+        return ANB_BLOB_NPOS;                                                                                   \
+    }                                                                                                           \
+    ANB_SIMD_TARGET(isa)                                                                                        \
+    static size_t name(const uint8_t *h, size_t n, const uint8_t *set, size_t k) {                              \
+        if (k == 2) return name##_k(h, n, set, 2);                                                              \
+        return name##_k(h, n, set, k);                                                                          \
+    }
+
+// First and last pattern byte filter candidates; only they are compared in full
+#define ANB_FIND_KERNEL(name, isa, vec, width, set1, cmpeq, and_, load, movemask)                               \
+    ANB_SIMD_TARGET(isa)                                                                                        \
+    static size_t name(const uint8_t *h, size_t n, const uint8_t *p, size_t m) {                                \
+        if (m > n) return ANB_BLOB_NPOS;                                                                        \
+        size_t starts = n - m + 1;                                                                              \
+        vec first = set1((char)p[0]);                                                                           \
+        vec last = set1((char)p[m - 1]);                                                                        \
+        size_t i = 0;                                                                                           \
+        for (; i + (width) <= starts; i += (width)) {                                                           \
+            vec f = cmpeq(first, load((const vec *)(h + i)));                                                   \
+            vec l = cmpeq(last, load((const vec *)(h + i + m - 1)));                                            \
+            unsigned mask = (unsigned)movemask(and_(f, l));                                                     \
+            while (mask) {                                                                                      \
+                size_t at = i + (size_t)__builtin_ctz(mask);                                                    \
+                if (memcmp(h + at + 1, p + 1, m - 2) == 0) return at;                                           \
+                mask &= mask - 1;                                                                               \
+            }                                                                                                   \
+        }                                                                                                       \
+        if (i == starts) return ANB_BLOB_NPOS;                                                                  \
+        if (starts < (width)) {                                                                                 \
+            size_t rest = ANB_find_scalar(h + i, n - i, p, m);                                                  \
+            return rest == ANB_BLOB_NPOS ? rest : i + rest;                                                     \
+        }                                                                                                       \
+        /* Last block of starts overlaps the one before; drop the starts already checked */                     \
+        size_t base = starts - (width);                                                                         \
+        vec f = cmpeq(first, load((const vec *)(h + base)));                                                    \
+        vec l = cmpeq(last, load((const vec *)(h + base + m - 1)));                                             \
+        unsigned mask = (unsigned)movemask(and_(f, l)) & (~0u << (i - base));                                   \
+        while (mask) {                                                                                          \
+            size_t at = base + (size_t)__builtin_ctz(mask);                                                     \
+            if (memcmp(h + at + 1, p + 1, m - 2) == 0) return at;                                               \
+            mask &= mask - 1;                                                                                   \
+        }                                                                                                       \
+        return ANB_BLOB_NPOS;                                                                                   \
+    }
+
+ANB_FIND_ANY_KERNEL(ANB_find_any_sse2, "sse2", __m128i, 16, _mm_set1_epi8, _mm_cmpeq_epi8, _mm_or_si128,
+                    _mm_loadu_si128, _mm_movemask_epi8)
+ANB_FIND_ANY_KERNEL(ANB_find_any_avx2, "avx2", __m256i, 32, _mm256_set1_epi8, _mm256_cmpeq_epi8, _mm256_or_si256,
+                    _mm256_loadu_si256, _mm256_movemask_epi8)
+ANB_FIND_KERNEL(ANB_find_sse2, "sse2", __m128i, 16, _mm_set1_epi8, _mm_cmpeq_epi8, _mm_and_si128,
+                _mm_loadu_si128, _mm_movemask_epi8)
+ANB_FIND_KERNEL(ANB_find_avx2, "avx2", __m256i, 32, _mm256_set1_epi8, _mm256_cmpeq_epi8, _mm256_and_si256,
+                _mm256_loadu_si256, _mm256_movemask_epi8)
+#endif
+
+static void ANB_find_init(void) {
+    ANB_find_any_impl = ANB_find_any_table;
+    ANB_find_impl = ANB_find_scalar;
+#if ANB_SIMD_X86
+    if (ANB_simd_has(ANB_SIMD_AVX2)) {
+        ANB_find_any_impl = ANB_find_any_avx2;
+        ANB_find_impl = ANB_find_avx2;
+    } else if (ANB_simd_has(ANB_SIMD_SSE2)) {
+        ANB_find_any_impl = ANB_find_any_sse2;
+        ANB_find_impl = ANB_find_sse2;
+    }
+#endif
+}
+
+// Unread bytes from offset on; NULL if offset is past the write position
+static const uint8_t *ANB_find_range(ANB_Blob_t *blob, size_t offset, size_t *n) {
+    if (!blob) abort();
+    size_t len;
+    const uint8_t *data = ANB_blob_peek(blob, &len);
+    if (offset > len) return NULL;
+    *n = len - offset;
+    return data + offset;
+}
+
+size_t ANB_blob_find_byte(ANB_Blob_t* blob, size_t offset, uint8_t byte) {
+    size_t n;
+    const uint8_t *h = ANB_find_range(blob, offset, &n);
+    if (!h || !n) return ANB_BLOB_NPOS;
+    // memchr is vectorized with its own run-time dispatch in the common libcs
+    const uint8_t *hit = (const uint8_t *)memchr(h, byte, n);
+    return hit ? offset + (size_t)(hit - h) : ANB_BLOB_NPOS;
+}
+
+size_t ANB_blob_find_any(ANB_Blob_t* blob, size_t offset, const uint8_t *set, size_t set_len) {
+    size_t n;
+    const uint8_t *h = ANB_find_range(blob, offset, &n);
+    if (!h || !n || !set_len) return ANB_BLOB_NPOS;
+    if (!set) abort();
+    if (set_len == 1) return ANB_blob_find_byte(blob, offset, set[0]);
+    pthread_once(&ANB_find_once, ANB_find_init);
+    size_t at = set_len <= ANB_FIND_SET_MAX ? ANB_find_any_impl(h, n, set, set_len)
+                                            : ANB_find_any_table(h, n, set, set_len);
+    return at == ANB_BLOB_NPOS ? at : offset + at;
+}
+
+size_t ANB_blob_find(ANB_Blob_t* blob, size_t offset, const uint8_t *pattern, size_t len) {
+    size_t n;
+    const uint8_t *h = ANB_find_range(blob, offset, &n);
+    if (!h) return ANB_BLOB_NPOS;
+    if (!len) return offset;
+    if (!pattern) abort();
+    if (len == 1) return ANB_blob_find_byte(blob, offset, pattern[0]);
+    pthread_once(&ANB_find_once, ANB_find_init);
+    size_t at = ANB_find_impl(h, n, pattern, len);
+    return at == ANB_BLOB_NPOS ? at : offset + at;
+}
@@ -0,0 +1,44 @@
+#pragma once
+/**
+ * @file blob_internal.h
+ * @brief Internal ANB_Blob queries for modules built on top of the public blob API.
+ */
+#include <stdatomic.h>
+#include "blob.h"
+#include "blob_slice.h"
+
+/**
+ * @brief Check whether the blob can grow.
+ * @param blob The blob. Must not be NULL.
+ * @return 0 if it lives in caller storage without ANB_MEM_SPILL, 1 otherwise.
+ */
+int ANB_blob_can_grow(ANB_Blob_t* blob);
+
+/**
+ * @brief Storage handed over by a blob once it is shared (ANB_blob_slice).
+ *
+ * Holds the buffer and its vmem state word. The blob keeps one reference
+ * while it still uses the buffer and every slice holds one more; the last
+ * release frees the buffer.
+ */
+struct ANB_BlobBuf {
+    _Atomic size_t refs;
+    uint8_t *data;
+    size_t capacity;
+    unsigned state;
+};
+
+/**
+ * @brief Share the blob's storage, moving caller, inline or compact storage to an owned buffer first.
+ * @param blob The blob. Must not be NULL.
+ * @return The storage with one reference added for the caller, or NULL if
+ *         the blob lives in caller storage without ANB_MEM_SPILL.
+ * @note The blob copies on its next write unless it holds the only reference by then.
+ */
+ANB_BlobBuf_t *ANB_blob_share(ANB_Blob_t* blob);
+
+/**
+ * @brief Drop one reference to shared storage, freeing it with the last one.
+ * @param buf The storage. Must not be NULL.
+ */
+void ANB_blob_buf_release(ANB_BlobBuf_t *buf);
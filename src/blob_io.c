@@ -0,0 +1,210 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include <stdint.h>
+#include "blob_io.h"
+#include "blob_internal.h"
+#include <errno.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#endif
+
+#define ANB_IO_SPILL_SIZE ((size_t)64 * 1024)     // Stack buffer behind the free tail in each readv
+#define ANB_IO_COPY_CHUNK ((size_t)128 * 1024)    // Bytes read per round of the userspace copy
+#define ANB_IO_KERNEL_CHUNK ((size_t)1 << 30)     // Per-call cap for splice/sendfile
+#define ANB_IO_MAX_IOV 64
+
+ssize_t ANB_blob_read_fd(ANB_Blob_t* blob, int fd, size_t max) {
+    if (!blob) abort();
+    uint8_t spill[ANB_IO_SPILL_SIZE];
+    int growable = ANB_blob_can_grow(blob);
+    size_t limit = (max && max < (size_t)SSIZE_MAX) ? max : (size_t)SSIZE_MAX;
+    size_t total = 0;
+
+    while (total < limit) {
+        size_t want = limit - total;
+        size_t avail;
+        uint8_t *tail = ANB_blob_reserve(blob, 0, &avail);
+        if (!growable && avail < want) {
+            // Fixed storage cannot take the overflow; reclaim the consumed prefix instead
+            ANB_blob_compact(blob);
+            tail = ANB_blob_reserve(blob, 0, &avail);
+        }
+
+        struct iovec iov[2];
+        int cnt = 0;
+        size_t direct = avail < want ? avail : want;
+        if (direct) {
+            iov[cnt].iov_base = tail;
+            iov[cnt].iov_len = direct;
+            cnt++;
+        }
+        if (growable && want > direct) {
+            iov[cnt].iov_base = spill;
+            iov[cnt].iov_len = want - direct < sizeof(spill) ? want - direct : sizeof(spill);
+            cnt++;
+        }
+        if (cnt == 0) {
+            if (total) break;
+            errno = ENOBUFS;
+            return -1;
+        }
+        size_t asked = iov[0].iov_len + (cnt > 1 ? iov[1].iov_len : 0);
+
+        ssize_t n = readv(fd, iov, cnt);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (total) break; // Report what arrived; the error comes back on the next call
+            return -1;
+        }
+        if (n == 0) break;
+
+        size_t got = (size_t)n;
+        if (got <= direct) {
+            ANB_blob_commit(blob, got);
+        } else {
+            ANB_blob_commit(blob, direct);
+            ANB_blob_push(blob, spill, got - direct);
+        }
+        total += got;
+        if (got < asked) break; // Drained for now, don't block on a second read
+    }
+    return (ssize_t)total;
+}
+
+ssize_t ANB_blob_writev_fd(ANB_Blob_t *const *blobs, size_t count, int fd) {
+    if (!blobs) abort();
+    size_t total = 0;
+    size_t first = 0;
+
+    for (;;) {
+        struct iovec iov[ANB_IO_MAX_IOV];
+        int cnt = 0;
+        while (first < count) {
+            size_t len;
+            ANB_blob_peek(blobs[first], &len);
+            if (len) break;
+            first++;
+        }
+        for (size_t i = first; i < count && cnt < ANB_IO_MAX_IOV; i++) {
+            size_t len;
+            uint8_t *p = ANB_blob_peek(blobs[i], &len);
+            if (!len) continue;
+            iov[cnt].iov_base = p;
+            iov[cnt].iov_len = len;
+            cnt++;
+        }
+        if (cnt == 0) break;
+
+        ssize_t n = writev(fd, iov, cnt);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (total) break;
+            return -1;
+        }
+        if (n == 0) break;
+
+        // Consume across the blobs in order
+        size_t left = (size_t)n;
+        total += left;
+        for (size_t i = first; i < count && left; i++) {
+            size_t len;
+            ANB_blob_peek(blobs[i], &len);
+            size_t take = len < left ? len : left;
+            ANB_blob_consume(blobs[i], take);
+            left -= take;
+        }
+    }
+    return (ssize_t)total;
+}
+
+ssize_t ANB_blob_write_fd(ANB_Blob_t* blob, int fd) {
+    if (!blob) abort();
+    return ANB_blob_writev_fd(&blob, 1, fd);
+}
+
+// Copy through the blob: read a bounded chunk, write it out, keep whatever out_fd refuses
+static ssize_t ANB_io_copy(ANB_Blob_t* blob, int in_fd, int out_fd, size_t limit) {
+    size_t total = 0;
+    while (total < limit) {
+        size_t want = limit - total;
+        ssize_t r = ANB_blob_read_fd(blob, in_fd, want < ANB_IO_COPY_CHUNK ? want : ANB_IO_COPY_CHUNK);
+        if (r < 0) {
+            if (total) break;
+            return -1;
+        }
+        if (r == 0) break;
+        total += (size_t)r;
+
+        ssize_t w = ANB_blob_write_fd(blob, out_fd);
+        if (w < 0 && errno != EAGAIN) return -1;
+        size_t pending;
+        ANB_blob_peek(blob, &pending);
+        if (pending) break; // out_fd is full; the rest goes first on the next call
+    }
+    return (ssize_t)total;
+}
+
+#if defined(__linux__)
+enum { ANB_IO_SPLICE, ANB_IO_SENDFILE, ANB_IO_COPY };
+
+// Move bytes with splice() or sendfile(); returns -2 if the kernel refuses this fd pair
+static ssize_t ANB_io_kernel(int method, int in_fd, int out_fd, size_t limit) {
+    size_t total = 0;
+    while (total < limit) {
+        size_t want = limit - total;
+        if (want > ANB_IO_KERNEL_CHUNK) want = ANB_IO_KERNEL_CHUNK;
+        ssize_t n = method == ANB_IO_SPLICE
+            ? splice(in_fd, NULL, out_fd, NULL, want, SPLICE_F_MOVE)
+            : sendfile(out_fd, in_fd, NULL, want);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (total) break;
+            if (errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP) return -2;
+            return -1;
+        }
+        if (n == 0) break;
+        total += (size_t)n;
+    }
+    return (ssize_t)total;
+}
+#endif
+
+ssize_t ANB_blob_splice_fd(ANB_Blob_t* blob, int in_fd, int out_fd, size_t max) {
+    if (!blob) abort();
+    size_t limit = (max && max < (size_t)SSIZE_MAX) ? max : (size_t)SSIZE_MAX;
+
+    // Bytes left over from an earlier call must reach out_fd before anything new
+    size_t pending;
+    ANB_blob_peek(blob, &pending);
+    if (pending) {
+        if (ANB_blob_write_fd(blob, out_fd) < 0) return -1;
+        ANB_blob_peek(blob, &pending);
+        if (pending) {
+            errno = EAGAIN;
+            return -1;
+        }
+    }
+
+#if defined(__linux__)
+    struct stat in_st, out_st;
+    int method = ANB_IO_COPY;
+    if (fstat(in_fd, &in_st) == 0 && fstat(out_fd, &out_st) == 0) {
+        if (S_ISFIFO(in_st.st_mode) || S_ISFIFO(out_st.st_mode)) method = ANB_IO_SPLICE;
+        else if (S_ISREG(in_st.st_mode)) method = ANB_IO_SENDFILE;
+    }
+    if (method != ANB_IO_COPY) {
+        ssize_t n = ANB_io_kernel(method, in_fd, out_fd, limit);
+        if (n != -2) return n;
+    }
+#endif
+    return ANB_io_copy(blob, in_fd, out_fd, limit);
+}
@@ -0,0 +1,253 @@
+#include <stdint.h>
+#include "blob_pool.h"
+#include "blob_digest.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ANB_BP_MIN_SHIFT 8 // log2(ANB_BLOB_POOL_MIN_CLASS)
+#define ANB_BP_BATCH (ANB_BLOB_POOL_THREAD_CACHE / 2)
+
+// Everything in a class is guarded by the pool lock
+typedef struct ANB_BlobPoolClass {
+    ANB_Blob_t **items;         // Idle blobs shared by all threads
+    size_t count;
+    size_t cap;
+    size_t bytes;               // Capacity of the blobs in items, held under the retention limit
+} ANB_BlobPoolClass_t;
+
+typedef struct ANB_BlobPoolCache {
+    ANB_BlobPool_t *pool;
+    struct ANB_BlobPoolCache *prev, *next; // Every live cache of the pool, guarded by the pool lock
+    _Atomic size_t bytes;       // Idle bytes in this cache; written by the owner only, read by ANB_blob_pool_retained
+    uint32_t *count;            // Blobs cached per class
+    ANB_Blob_t **slots;         // nclasses rows of ANB_BLOB_POOL_THREAD_CACHE
+} ANB_BlobPoolCache_t;
+
+struct ANB_BlobPool {
+    pthread_mutex_t lock;
+    pthread_key_t key;          // Thread cache of the calling thread
+    unsigned flags;
+    unsigned nclasses;
+    size_t max_size;            // Capacity of the largest class
+    size_t retain;              // Per-class retention limit in bytes
+    ANB_BlobPoolCache_t *caches;
+    ANB_BlobPoolClass_t classes[];
+};
+
+// Number of significant bits in n (n > 0)
+static unsigned ANB_bp_bits(size_t n) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)(sizeof(unsigned long long) * 8) - (unsigned)__builtin_clzll((unsigned long long)n);
+#else
+    unsigned b = 0;
+    while (n) {
+        n >>= 1;
+        b++;
+    }
+    return b;
+#endif
+}
+
+// Smallest class holding n bytes
+static unsigned ANB_bp_class_up(size_t n) {
+    if (n <= ANB_BLOB_POOL_MIN_CLASS) return 0;
+    return ANB_bp_bits(n - 1) - ANB_BP_MIN_SHIFT;
+}
+
+// Largest class a capacity of cap bytes covers (cap >= ANB_BLOB_POOL_MIN_CLASS)
+static unsigned ANB_bp_class_down(size_t cap) {
+    return ANB_bp_bits(cap) - 1 - ANB_BP_MIN_SHIFT;
+}
+
+// Append to a class's shared list if the retention limit allows; the pool lock must be held.
+// Returns 0 if the caller has to destroy the blob instead.
+static int ANB_bp_shared_push(ANB_BlobPool_t *pool, ANB_BlobPoolClass_t *cls, ANB_Blob_t *blob) {
+    size_t cap = ANB_blob_capacity(blob);
+    if (cls->bytes > pool->retain || cap > pool->retain - cls->bytes) return 0;
+    if (cls->count == cls->cap) {
+        size_t cap = cls->cap ? cls->cap * 2 : ANB_BLOB_POOL_THREAD_CACHE;
+        ANB_Blob_t **items = (ANB_Blob_t **)realloc(cls->items, cap * sizeof(*items));
+        if (!items) abort();
+        cls->items = items;
+        cls->cap = cap;
+    }
+    cls->items[cls->count++] = blob;
+    cls->bytes += cap;
+    return 1;
+}
+
+// Owner-only update of a cache's byte count; relaxed load/store, no locked instruction
+static void ANB_bp_cache_add(ANB_BlobPoolCache_t *tc, size_t add, size_t sub) {
+    size_t cur = atomic_load_explicit(&tc->bytes, memory_order_relaxed);
+    atomic_store_explicit(&tc->bytes, cur + add - sub, memory_order_relaxed);
+}
+
+// Thread exit: hand the cached blobs to the shared lists, freeing what does not fit
+static void ANB_bp_cache_exit(void *arg) {
+    ANB_BlobPoolCache_t *tc = (ANB_BlobPoolCache_t *)arg;
+    ANB_BlobPool_t *pool = tc->pool;
+    pthread_mutex_lock(&pool->lock);
+    for (unsigned c = 0; c < pool->nclasses; c++) {
+        ANB_Blob_t **row = tc->slots + (size_t)c * ANB_BLOB_POOL_THREAD_CACHE;
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < tc->count[c]; i++) {
+            if (!ANB_bp_shared_push(pool, &pool->classes[c], row[i])) row[kept++] = row[i];
+        }
+        tc->count[c] = kept;
+    }
+    if (tc->prev) tc->prev->next = tc->next;
+    else pool->caches = tc->next;
+    if (tc->next) tc->next->prev = tc->prev;
+    pthread_mutex_unlock(&pool->lock);
+
+    for (unsigned c = 0; c < pool->nclasses; c++) {
+        ANB_Blob_t **row = tc->slots + (size_t)c * ANB_BLOB_POOL_THREAD_CACHE;
+        for (uint32_t i = 0; i < tc->count[c]; i++) ANB_blob_destroy(row[i]);
+    }
+    free(tc);
+}
+
+static ANB_BlobPoolCache_t *ANB_bp_cache(ANB_BlobPool_t *pool) {
+    ANB_BlobPoolCache_t *tc = (ANB_BlobPoolCache_t *)pthread_getspecific(pool->key);
+    if (tc) return tc;
+
+    // One allocation: header | slots | counts
+    size_t nslots = (size_t)pool->nclasses * ANB_BLOB_POOL_THREAD_CACHE;
+    tc = (ANB_BlobPoolCache_t *)calloc(1, sizeof(*tc) + nslots * sizeof(ANB_Blob_t *) +
+                                              pool->nclasses * sizeof(uint32_t));
+    if (!tc) abort();
+    tc->pool = pool;
+    atomic_init(&tc->bytes, 0);
+    tc->slots = (ANB_Blob_t **)(tc + 1);
+    tc->count = (uint32_t *)(tc->slots + nslots);
+
+    pthread_mutex_lock(&pool->lock);
+    tc->next = pool->caches;
+    if (pool->caches) pool->caches->prev = tc;
+    pool->caches = tc;
+    pthread_mutex_unlock(&pool->lock);
+    if (pthread_setspecific(pool->key, tc) != 0) abort();
+    return tc;
+}
+
+ANB_BlobPool_t* ANB_blob_pool_create(size_t max_blob_size, size_t retain_per_class, unsigned flags) {
+    if (flags & ~ANB_MEM_FLAGS_ALL) abort();
+    if (max_blob_size > SIZE_MAX / 2 + 1) abort();
+    unsigned nclasses = ANB_bp_class_up(max_blob_size) + 1;
+
+    ANB_BlobPool_t *pool = (ANB_BlobPool_t *)calloc(1, sizeof(*pool) + nclasses * sizeof(ANB_BlobPoolClass_t));
+    if (!pool) abort();
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) abort();
+    if (pthread_key_create(&pool->key, ANB_bp_cache_exit) != 0) abort();
+    pool->flags = flags;
+    pool->nclasses = nclasses;
+    pool->max_size = (size_t)ANB_BLOB_POOL_MIN_CLASS << (nclasses - 1);
+    pool->retain = retain_per_class;
+    return pool;
+}
+
+void ANB_blob_pool_destroy(ANB_BlobPool_t* pool) {
+    if (!pool) return;
+    // Deleting the key first keeps exiting threads from touching the pool
+    pthread_key_delete(pool->key);
+    ANB_BlobPoolCache_t *tc = pool->caches;
+    while (tc) {
+        ANB_BlobPoolCache_t *next = tc->next;
+        for (unsigned c = 0; c < pool->nclasses; c++) {
+            ANB_Blob_t **row = tc->slots + (size_t)c * ANB_BLOB_POOL_THREAD_CACHE;
+            for (uint32_t i = 0; i < tc->count[c]; i++) ANB_blob_destroy(row[i]);
+        }
+        free(tc);
+        tc = next;
+    }
+    for (unsigned c = 0; c < pool->nclasses; c++) {
+        ANB_BlobPoolClass_t *cls = &pool->classes[c];
+        for (size_t i = 0; i < cls->count; i++) ANB_blob_destroy(cls->items[i]);
+        free(cls->items);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+ANB_Blob_t* ANB_blob_pool_acquire(ANB_BlobPool_t* pool, size_t min_capacity) {
+    if (!pool) abort();
+    if (min_capacity > pool->max_size) return ANB_blob_create_ex(min_capacity, pool->flags);
+
+    unsigned c = ANB_bp_class_up(min_capacity);
+    ANB_BlobPoolClass_t *cls = &pool->classes[c];
+    ANB_BlobPoolCache_t *tc = ANB_bp_cache(pool);
+    ANB_Blob_t **row = tc->slots + (size_t)c * ANB_BLOB_POOL_THREAD_CACHE;
+
+    if (!tc->count[c]) {
+        // Refill half the thread cache in one trip to the shared list
+        size_t moved = 0;
+        pthread_mutex_lock(&pool->lock);
+        while (tc->count[c] < ANB_BP_BATCH && cls->count) {
+            ANB_Blob_t *b = cls->items[--cls->count];
+            moved += ANB_blob_capacity(b);
+            row[tc->count[c]++] = b;
+        }
+        cls->bytes -= moved;
+        pthread_mutex_unlock(&pool->lock);
+        if (!tc->count[c]) return ANB_blob_create_ex((size_t)ANB_BLOB_POOL_MIN_CLASS << c, pool->flags);
+        ANB_bp_cache_add(tc, moved, 0);
+    }
+
+    ANB_Blob_t *blob = row[--tc->count[c]];
+    ANB_bp_cache_add(tc, 0, ANB_blob_capacity(blob));
+    return blob;
+}
+
+void ANB_blob_pool_release(ANB_BlobPool_t* pool, ANB_Blob_t* blob) {
+    if (!pool) abort();
+    if (!blob) return;
+    size_t cap = ANB_blob_capacity(blob);
+    if (cap < ANB_BLOB_POOL_MIN_CLASS || cap > pool->max_size || cap > pool->retain) {
+        ANB_blob_destroy(blob);
+        return;
+    }
+
+    // Trim goes off first so the reset cannot shrink the blob out of its class
+    ANB_blob_set_trim(blob, NULL);
+    ANB_blob_set_growth(blob, NULL);
+    ANB_blob_set_compact(blob, ANB_BLOB_COMPACT_DEFAULT);
+    ANB_blob_set_digest(blob, NULL);
+    ANB_blob_reset(blob);
+
+    unsigned c = ANB_bp_class_down(cap);
+    ANB_BlobPoolCache_t *tc = ANB_bp_cache(pool);
+    ANB_Blob_t **row = tc->slots + (size_t)c * ANB_BLOB_POOL_THREAD_CACHE;
+    if (tc->count[c] == ANB_BLOB_POOL_THREAD_CACHE) {
+        // Full: move the older half to the shared list in one trip; what is over the limit is freed
+        ANB_Blob_t *excess[ANB_BP_BATCH];
+        uint32_t nexcess = 0;
+        size_t moved = 0;
+        pthread_mutex_lock(&pool->lock);
+        for (uint32_t i = 0; i < ANB_BP_BATCH; i++) {
+            moved += ANB_blob_capacity(row[i]);
+            if (!ANB_bp_shared_push(pool, &pool->classes[c], row[i])) excess[nexcess++] = row[i];
+        }
+        pthread_mutex_unlock(&pool->lock);
+        for (uint32_t i = 0; i < nexcess; i++) ANB_blob_destroy(excess[i]);
+        memmove(row, row + ANB_BP_BATCH, (ANB_BLOB_POOL_THREAD_CACHE - ANB_BP_BATCH) * sizeof(*row));
+        tc->count[c] -= ANB_BP_BATCH;
+        ANB_bp_cache_add(tc, 0, moved);
+    }
+    row[tc->count[c]++] = blob;
+    ANB_bp_cache_add(tc, cap, 0);
+}
+
+size_t ANB_blob_pool_retained(ANB_BlobPool_t* pool) {
+    if (!pool) abort();
+    size_t total = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (unsigned c = 0; c < pool->nclasses; c++) total += pool->classes[c].bytes;
+    for (ANB_BlobPoolCache_t *tc = pool->caches; tc; tc = tc->next) {
+        total += atomic_load_explicit(&tc->bytes, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return total;
+}
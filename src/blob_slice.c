@@ -0,0 +1,46 @@
+#include <stdint.h>
+#include "blob_slice.h"
+#include "blob_internal.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+int ANB_blob_slice(ANB_Blob_t* blob, size_t offset, size_t len, ANB_BlobSlice_t *out) {
+    if (!blob || !out) abort();
+    size_t unread;
+    ANB_blob_peek(blob, &unread);
+    if (offset > unread || len > unread - offset) abort();
+    memset(out, 0, sizeof(*out));
+    ANB_BlobBuf_t *buf = ANB_blob_share(blob);
+    if (!buf) return -1;
+    // Sharing may have moved the bytes out of the handle: peek again
+    out->_buf = buf;
+    out->_data = ANB_blob_peek(blob, NULL) + offset;
+    out->_len = len;
+    return 0;
+}
+
+void ANB_blob_slice_sub(const ANB_BlobSlice_t *slice, size_t offset, size_t len, ANB_BlobSlice_t *out) {
+    if (!slice || !out) abort();
+    if (offset > slice->_len || len > slice->_len - offset) abort();
+    if (!slice->_buf) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    atomic_fetch_add_explicit(&slice->_buf->refs, 1, memory_order_relaxed);
+    out->_buf = slice->_buf;
+    out->_data = slice->_data + offset;
+    out->_len = len;
+}
+
+void ANB_blob_slice_release(ANB_BlobSlice_t *slice) {
+    if (!slice || !slice->_buf) return;
+    ANB_blob_buf_release(slice->_buf);
+    memset(slice, 0, sizeof(*slice));
+}
+
+size_t ANB_blob_slice_refs(const ANB_BlobSlice_t *slice) {
+    if (!slice) abort();
+    return slice->_buf ? atomic_load_explicit(&slice->_buf->refs, memory_order_relaxed) : 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+/**
+ * @file digest_internal.h
+ * @brief Internal incremental digest state behind ANB_blob_set_digest.
+ */
+#include "blob_digest.h"
+
+/** Running digest. Set up with ANB_digest_start. */
+typedef struct ANB_DigestState {
+    ANB_DigestSpec_t spec;
+    uint64_t acc[4];      /* CRC32C register or hook state in acc[0]; XXH64 lanes */
+    uint64_t total;       /* XXH64: bytes hashed */
+    uint8_t buf[32];      /* XXH64: input not yet forming a full stripe */
+    size_t buf_len;
+} ANB_DigestState_t;
+
+/**
+ * @brief Start or restart a digest.
+ * @param st The state.
+ * @param spec Digest to run; may point at st->spec to restart.
+ */
+void ANB_digest_start(ANB_DigestState_t *st, const ANB_DigestSpec_t *spec);
+
+/**
+ * @brief Hash more bytes.
+ * @param st The state.
+ * @param data Bytes to hash.
+ * @param len Number of bytes, > 0.
+ */
+void ANB_digest_update(ANB_DigestState_t *st, const uint8_t *data, size_t len);
+
+/**
+ * @brief Get the digest of everything hashed so far without ending it.
+ * @param st The state.
+ * @return The digest value.
+ */
+uint64_t ANB_digest_value(const ANB_DigestState_t *st);
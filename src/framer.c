@@ -0,0 +1,132 @@
+#include <stdint.h>
+#include "framer.h"
+#include <errno.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ANB_Framer {
+    ANB_FrameSpec_t spec;
+    uint8_t delim[ANB_FRAME_DELIM_MAX];
+    size_t scan;                // DELIMITER: bytes after the read cursor known not to start a delimiter
+};
+
+ANB_Framer_t* ANB_framer_create(const ANB_FrameSpec_t *spec) {
+    if (!spec) abort();
+    switch (spec->mode) {
+    case ANB_FRAME_LENGTH:
+        if (spec->prefix_bytes != 1 && spec->prefix_bytes != 2 && spec->prefix_bytes != 4) abort();
+        break;
+    case ANB_FRAME_DELIMITER:
+        if (!spec->delim || !spec->delim_len || spec->delim_len > ANB_FRAME_DELIM_MAX) abort();
+        break;
+    case ANB_FRAME_FIXED:
+        if (!spec->frame_size) abort();
+        break;
+    default:
+        abort();
+    }
+
+    ANB_Framer_t *framer = (ANB_Framer_t *)calloc(1, sizeof(*framer));
+    if (!framer) abort();
+    framer->spec = *spec;
+    if (spec->mode == ANB_FRAME_DELIMITER) {
+        memcpy(framer->delim, spec->delim, spec->delim_len);
+        framer->spec.delim = framer->delim;
+    }
+    return framer;
+}
+
+void ANB_framer_destroy(ANB_Framer_t* framer) {
+    free(framer);
+}
+
+void ANB_framer_reset(ANB_Framer_t* framer) {
+    if (!framer) abort();
+    framer->scan = 0;
+}
+
+static size_t ANB_f_prefix(const ANB_FrameSpec_t *spec, const uint8_t *p) {
+    size_t n = 0;
+    for (unsigned i = 0; i < spec->prefix_bytes; i++) {
+        unsigned b = spec->big_endian ? i : spec->prefix_bytes - 1 - i;
+        n = (n << 8) | p[b];
+    }
+    return n;
+}
+
+// Locate the frame at pos. Returns 1 with the payload offset/length and the
+// bytes the frame occupies, 0 if it is incomplete, -1 if it is too long.
+static int ANB_f_next(ANB_Framer_t *f, ANB_Blob_t *in, const uint8_t *d, size_t len, size_t pos,
+                      size_t *start, size_t *payload, size_t *total) {
+    const ANB_FrameSpec_t *spec = &f->spec;
+    size_t avail = len - pos;
+    size_t max = spec->max_frame;
+
+    switch (spec->mode) {
+    case ANB_FRAME_LENGTH: {
+        if (avail < spec->prefix_bytes) return 0;
+        size_t n = ANB_f_prefix(spec, d + pos);
+        if (max && n > max) return -1;
+        if (avail - spec->prefix_bytes < n) return 0;
+        *start = pos + spec->prefix_bytes;
+        *payload = n;
+        *total = spec->prefix_bytes + n;
+        return 1;
+    }
+    case ANB_FRAME_DELIMITER: {
+        size_t dl = spec->delim_len;
+        size_t hit = ANB_blob_find(in, pos + f->scan, spec->delim, dl);
+        if (hit == ANB_BLOB_NPOS) {
+            // The last dl - 1 bytes may still begin a delimiter
+            f->scan = avail >= dl ? avail - dl + 1 : 0;
+            return max && avail >= max + dl ? -1 : 0;
+        }
+        f->scan = 0;
+        *start = pos;
+        *payload = hit - pos;
+        *total = *payload + dl;
+        return max && *payload > max ? -1 : 1;
+    }
+    default:
+        if (avail < spec->frame_size) return 0;
+        *start = pos;
+        *payload = *total = spec->frame_size;
+        return 1;
+    }
+}
+
+ssize_t ANB_framer_run(ANB_Framer_t* framer, ANB_Blob_t* in, ANB_Slab_t* out) {
+    if (!framer || !in || !out) abort();
+    size_t len;
+    const uint8_t *d = ANB_blob_peek(in, &len);
+    size_t pos = 0;
+    ssize_t frames = 0;
+    int err = 0;
+
+    for (;;) {
+        size_t start, payload, total;
+        int r = ANB_f_next(framer, in, d, len, pos, &start, &payload, &total);
+        if (r == 0) break;
+        if (r < 0) {
+            err = EMSGSIZE;
+            break;
+        }
+        uint8_t *item = ANB_slab_alloc_item(out, payload);
+        if (!item) {
+            err = ENOBUFS;
+            break;
+        }
+        if (payload) memcpy(item, d + start, payload);
+        pos += total;
+        frames++;
+    }
+
+    // One consume for the whole batch; d stays valid until here
+    if (pos) ANB_blob_consume(in, pos);
+    if (err && !frames) {
+        errno = err;
+        return -1;
+    }
+    return frames;
+}
@@ -0,0 +1,55 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include <stdint.h>
+#include "futex_internal.h"
+#include <limits.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+void ANB_futex_wait(_Atomic uint32_t *word, uint32_t val, const struct timespec *rel, int shared) {
+    syscall(SYS_futex, (uint32_t *)word, shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, val, rel, NULL, 0);
+}
+
+void ANB_futex_wake(_Atomic uint32_t *word, int shared) {
+    syscall(SYS_futex, (uint32_t *)word, shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+#else
+// No portable futex: nap briefly and let the caller recheck
+void ANB_futex_wait(_Atomic uint32_t *word, uint32_t val, const struct timespec *rel, int shared) {
+    (void)shared;
+    struct timespec nap = {0, 1000000};
+    if (rel && rel->tv_sec == 0 && rel->tv_nsec < nap.tv_nsec) nap = *rel;
+    if (atomic_load_explicit(word, memory_order_acquire) == val) nanosleep(&nap, NULL);
+}
+
+void ANB_futex_wake(_Atomic uint32_t *word, int shared) {
+    (void)word;
+    (void)shared;
+}
+#endif
+
+void ANB_deadline_set(struct timespec *dl, int timeout_ms) {
+    clock_gettime(CLOCK_MONOTONIC, dl);
+    dl->tv_sec += timeout_ms / 1000;
+    dl->tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (dl->tv_nsec >= 1000000000L) {
+        dl->tv_sec++;
+        dl->tv_nsec -= 1000000000L;
+    }
+}
+
+int ANB_deadline_left(const struct timespec *dl, struct timespec *rel) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    rel->tv_sec = dl->tv_sec - now.tv_sec;
+    rel->tv_nsec = dl->tv_nsec - now.tv_nsec;
+    if (rel->tv_nsec < 0) {
+        rel->tv_sec--;
+        rel->tv_nsec += 1000000000L;
+    }
+    return rel->tv_sec > 0 || (rel->tv_sec == 0 && rel->tv_nsec > 0);
+}
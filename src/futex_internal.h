@@ -0,0 +1,41 @@
+#pragma once
+/**
+ * @file futex_internal.h
+ * @brief Internal sleep/wake on a 32-bit word, behind the blocking waits of ANB_Slab and ANB_ShmSlab.
+ */
+#include <stdatomic.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Sleep while *word equals val, until woken or the timeout passes.
+ * @param word The futex word.
+ * @param val Value read from word before deciding to sleep; returns at once if it changed.
+ * @param rel Longest sleep, or NULL for no limit.
+ * @param shared Nonzero if other processes may wake the word (shared memory).
+ * @note May return early for no reason; callers recheck their condition.
+ *       Outside Linux this naps for at most a millisecond instead.
+ */
+void ANB_futex_wait(_Atomic uint32_t *word, uint32_t val, const struct timespec *rel, int shared);
+
+/**
+ * @brief Wake every thread sleeping on word.
+ * @param word The futex word, already changed by the caller.
+ * @param shared Must match the sleepers' shared argument.
+ */
+void ANB_futex_wake(_Atomic uint32_t *word, int shared);
+
+/**
+ * @brief Turn a millisecond timeout into a CLOCK_MONOTONIC deadline.
+ * @param dl Receives the deadline.
+ * @param timeout_ms Timeout, >= 0.
+ */
+void ANB_deadline_set(struct timespec *dl, int timeout_ms);
+
+/**
+ * @brief Get the time left until a deadline.
+ * @param dl Deadline from ANB_deadline_set.
+ * @param rel Receives the time left.
+ * @return 1 if time is left, 0 if the deadline passed.
+ */
+int ANB_deadline_left(const struct timespec *dl, struct timespec *rel);
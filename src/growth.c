@@ -0,0 +1,74 @@
+#include <stdint.h>
+#include "growth.h"
+#include "growth_internal.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+static const ANB_GrowthPolicy_t ANB_G_DEFAULT = ANB_GROWTH_DEFAULT;
+
+// Bytes added by one step of factor_pct growth, without overflowing on huge capacities
+static size_t ANB_g_step(size_t cap, uint32_t factor_pct) {
+    size_t pct = factor_pct - 100;
+    return (cap / 100) * pct + ((cap % 100) * pct) / 100;
+}
+
+void ANB_growth_check(const ANB_GrowthPolicy_t *policy) {
+    size_t r = policy->round_to;
+    if (r > 1 && (r & (r - 1))) abort();
+}
+
+size_t ANB_growth_next(const ANB_GrowthPolicy_t *policy, size_t current, size_t required) {
+    if (!policy) policy = &ANB_G_DEFAULT;
+    ANB_growth_check(policy);
+    if (required <= current) return current;
+
+    if (policy->fn) {
+        size_t cap = policy->fn(policy->ctx, current, required);
+        if (cap < required) abort();
+        return cap;
+    }
+
+    size_t cap = current;
+    if (policy->factor_pct <= 100) {
+        cap = required;
+    } else {
+        while (cap < required) {
+            size_t step = ANB_g_step(cap, policy->factor_pct);
+            if (step == 0) step = required - cap;
+            if (policy->max_step && step >= policy->max_step) {
+                // Capped: stop iterating and take one step or jump to what is needed
+                step = policy->max_step;
+                if (required - cap > step) step = required - cap;
+            }
+            if (cap > SIZE_MAX - step) abort();
+            cap += step;
+        }
+    }
+
+    size_t r = policy->round_to;
+    if (r > 1) {
+        if (cap > SIZE_MAX - (r - 1)) abort();
+        cap = (cap + r - 1) & ~(r - 1);
+    }
+    return cap;
+}
+
+size_t ANB_trim_track(const ANB_TrimPolicy_t *policy, ANB_TrimState_t *st, size_t used, size_t capacity) {
+    if (policy->usage_pct == 0) return 0;
+
+    size_t pct = policy->usage_pct > 100 ? 100 : policy->usage_pct;
+    size_t threshold = (capacity / 100) * pct + ((capacity % 100) * pct) / 100;
+    if (used >= threshold) {
+        st->streak = 0;
+        st->peak = 0;
+        return 0;
+    }
+
+    if (used > st->peak) st->peak = used;
+    if (++st->streak < policy->resets) return 0;
+
+    size_t target = st->peak;
+    st->streak = 0;
+    st->peak = 0;
+    return target ? target : 1;
+}
@@ -0,0 +1,29 @@
+#pragma once
+/**
+ * @file growth_internal.h
+ * @brief Internal hysteresis tracking for ANB_TrimPolicy_t.
+ */
+#include "growth.h"
+
+/**
+ * @brief Abort on a policy the built-in computation cannot apply.
+ * @param policy The policy to check. Must not be NULL.
+ * @note round_to must be 0, 1 or a power of two.
+ */
+void ANB_growth_check(const ANB_GrowthPolicy_t *policy);
+
+/** Per-buffer state for automatic trim. Zero-initialize. */
+typedef struct ANB_TrimState {
+    uint32_t streak; /* consecutive low resets */
+    size_t peak;     /* largest usage seen during the streak */
+} ANB_TrimState_t;
+
+/**
+ * @brief Record one reset and decide whether to trim.
+ * @param policy The buffer's trim policy.
+ * @param st The buffer's trim state.
+ * @param used Bytes used since the previous reset.
+ * @param capacity Current capacity in bytes.
+ * @return The capacity to trim to, or 0 if no trim is due.
+ */
+size_t ANB_trim_track(const ANB_TrimPolicy_t *policy, ANB_TrimState_t *st, size_t used, size_t capacity);
@@ -0,0 +1,146 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include <stdint.h>
+#include "ring.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if !defined(__linux__)
+#include <fcntl.h>
+#include <stdio.h>
+#endif
+
+struct ANB_Ring {
+    uint8_t *data;         // First of two adjacent mappings of the same memory
+    size_t capacity;       // Power of two, multiple of the page size
+    _Atomic size_t wpos;   // Bytes ever committed; written by the producer only
+    _Atomic size_t rpos;   // Bytes ever consumed; written by the consumer only
+};
+
+// Anonymous shared memory object that can be mapped more than once
+static int ANB_r_memfd(size_t size) {
+    int fd;
+#if defined(__linux__)
+    fd = memfd_create("anb_ring", MFD_CLOEXEC);
+#else
+    char name[64];
+    snprintf(name, sizeof(name), "/anb_ring_%ld_%p", (long)getpid(), (void *)&name);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) shm_unlink(name);
+#endif
+    if (fd < 0) return -1;
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Reserve 2 * size of address space, then map the object over both halves
+static uint8_t *ANB_r_map_twice(int fd, size_t size) {
+    uint8_t *base = (uint8_t *)mmap(NULL, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == (uint8_t *)MAP_FAILED) return NULL;
+    for (int half = 0; half < 2; half++) {
+        void *p = mmap(base + half * size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        if (p == MAP_FAILED) {
+            munmap(base, 2 * size);
+            return NULL;
+        }
+    }
+    return base;
+}
+
+ANB_Ring_t* ANB_ring_create(size_t min_capacity) {
+    if (min_capacity == 0) abort();
+    long page = sysconf(_SC_PAGESIZE);
+    size_t cap = page > 0 ? (size_t)page : 4096;
+    while (cap < min_capacity) {
+        if (cap > SIZE_MAX / 4) abort();
+        cap <<= 1;
+    }
+
+    ANB_Ring_t* ring = (ANB_Ring_t*)calloc(1, sizeof(ANB_Ring_t));
+    if (!ring) abort();
+
+    int fd = ANB_r_memfd(cap);
+    if (fd < 0) abort();
+    ring->data = ANB_r_map_twice(fd, cap);
+    close(fd); // The mappings keep the memory alive
+    if (!ring->data) abort();
+
+    ring->capacity = cap;
+    atomic_init(&ring->wpos, 0);
+    atomic_init(&ring->rpos, 0);
+    return ring;
+}
+
+void ANB_ring_destroy(ANB_Ring_t* ring) {
+    if (ring) {
+        munmap(ring->data, 2 * ring->capacity);
+        free(ring);
+    }
+}
+
+size_t ANB_ring_capacity(ANB_Ring_t* ring) {
+    if (!ring) abort();
+    return ring->capacity;
+}
+
+size_t ANB_ring_data_len(ANB_Ring_t* ring) {
+    if (!ring) abort();
+    return atomic_load_explicit(&ring->wpos, memory_order_acquire) -
+           atomic_load_explicit(&ring->rpos, memory_order_acquire);
+}
+
+uint8_t *ANB_ring_reserve(ANB_Ring_t* ring, size_t min_len, size_t *avail) {
+    if (!ring) abort();
+    size_t w = atomic_load_explicit(&ring->wpos, memory_order_relaxed);
+    size_t r = atomic_load_explicit(&ring->rpos, memory_order_acquire);
+    size_t space = ring->capacity - (w - r);
+    if (min_len > space) return NULL;
+    if (avail) *avail = space;
+    return ring->data + (w & (ring->capacity - 1));
+}
+
+void ANB_ring_commit(ANB_Ring_t* ring, size_t n) {
+    if (!ring) abort();
+    size_t w = atomic_load_explicit(&ring->wpos, memory_order_relaxed);
+    size_t r = atomic_load_explicit(&ring->rpos, memory_order_acquire);
+    if (n > ring->capacity - (w - r)) abort();
+    atomic_store_explicit(&ring->wpos, w + n, memory_order_release);
+}
+
+int ANB_ring_push(ANB_Ring_t* ring, const uint8_t* bytes, size_t len) {
+    uint8_t *dst = ANB_ring_reserve(ring, len, NULL);
+    if (!dst) return -1;
+    memcpy(dst, bytes, len);
+    ANB_ring_commit(ring, len);
+    return 0;
+}
+
+uint8_t *ANB_ring_peek(ANB_Ring_t* ring, size_t *len) {
+    if (!ring) abort();
+    size_t r = atomic_load_explicit(&ring->rpos, memory_order_relaxed);
+    size_t w = atomic_load_explicit(&ring->wpos, memory_order_acquire);
+    if (len) *len = w - r;
+    return ring->data + (r & (ring->capacity - 1));
+}
+
+void ANB_ring_consume(ANB_Ring_t* ring, size_t n) {
+    if (!ring) abort();
+    size_t r = atomic_load_explicit(&ring->rpos, memory_order_relaxed);
+    size_t w = atomic_load_explicit(&ring->wpos, memory_order_acquire);
+    if (n > w - r) abort();
+    atomic_store_explicit(&ring->rpos, r + n, memory_order_release);
+}
+
+void ANB_ring_reset(ANB_Ring_t* ring) {
+    if (!ring) abort();
+    atomic_store_explicit(&ring->rpos, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->wpos, 0, memory_order_relaxed);
+}
@@ -0,0 +1,254 @@
+#include <stdint.h>
+#include "rope.h"
+#include "vmem.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Segment header; the data follows it in the same vmem buffer
+typedef struct ANB_RopeSeg {
+    struct ANB_RopeSeg *next;
+    size_t cap;                 // Data bytes after the header
+    size_t len;                 // Bytes written
+    unsigned state;             // vmem state word of the whole buffer
+} ANB_RopeSeg_t;
+
+// Header size rounded up so the data keeps malloc alignment
+#define ANB_R_HEAD ((sizeof(ANB_RopeSeg_t) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+
+struct ANB_Rope {
+    ANB_RopeSeg_t *head;        // Oldest segment; reading starts at rpos
+    ANB_RopeSeg_t *tail;        // Segment being filled
+    size_t rpos;                // Bytes of head already consumed
+    size_t len;                 // Unread bytes across all segments
+    size_t nsegs;
+    size_t seg_size;
+    unsigned flags;
+};
+
+static inline uint8_t *ANB_r_data(const ANB_RopeSeg_t *seg) {
+    return (uint8_t *)seg + ANB_R_HEAD;
+}
+
+static ANB_RopeSeg_t *ANB_r_seg_new(ANB_Rope_t *rope, size_t cap) {
+    if (cap > SIZE_MAX - ANB_R_HEAD) abort();
+    unsigned state = rope->flags;
+    ANB_RopeSeg_t *seg = (ANB_RopeSeg_t *)ANB_vmem_alloc(ANB_R_HEAD + cap, &state);
+    if (!seg) abort();
+    seg->next = NULL;
+    seg->cap = cap;
+    seg->len = 0;
+    seg->state = state;
+    return seg;
+}
+
+static void ANB_r_seg_free(ANB_RopeSeg_t *seg) {
+    unsigned state = seg->state;
+    ANB_vmem_free((uint8_t *)seg, ANB_R_HEAD + seg->cap, state);
+}
+
+// Link a new segment of cap bytes after the tail
+static ANB_RopeSeg_t *ANB_r_link(ANB_Rope_t *rope, size_t cap) {
+    ANB_RopeSeg_t *seg = ANB_r_seg_new(rope, cap);
+    if (rope->tail) rope->tail->next = seg;
+    else rope->head = seg;
+    rope->tail = seg;
+    rope->nsegs++;
+    return seg;
+}
+
+// Free every segment, keeping the head if it has the standard size
+static void ANB_r_drop(ANB_Rope_t *rope) {
+    ANB_RopeSeg_t *keep = rope->head && rope->head->cap == rope->seg_size ? rope->head : NULL;
+    ANB_RopeSeg_t *seg = keep ? keep->next : rope->head;
+    while (seg) {
+        ANB_RopeSeg_t *next = seg->next;
+        ANB_r_seg_free(seg);
+        seg = next;
+    }
+    if (keep) {
+        keep->next = NULL;
+        keep->len = 0;
+    }
+    rope->head = rope->tail = keep;
+    rope->nsegs = keep ? 1 : 0;
+    rope->rpos = 0;
+    rope->len = 0;
+}
+
+ANB_Rope_t* ANB_rope_create(size_t segment_size) {
+    return ANB_rope_create_ex(segment_size, 0);
+}
+
+ANB_Rope_t* ANB_rope_create_ex(size_t segment_size, unsigned flags) {
+    if (flags & ~ANB_MEM_FLAGS_ALL) abort();
+    ANB_Rope_t *rope = (ANB_Rope_t *)calloc(1, sizeof(*rope));
+    if (!rope) abort();
+    rope->seg_size = segment_size ? segment_size : ANB_ROPE_SEGMENT_DEFAULT;
+    rope->flags = flags;
+    return rope;
+}
+
+void ANB_rope_destroy(ANB_Rope_t* rope) {
+    if (!rope) return;
+    ANB_RopeSeg_t *seg = rope->head;
+    while (seg) {
+        ANB_RopeSeg_t *next = seg->next;
+        ANB_r_seg_free(seg);
+        seg = next;
+    }
+    free(rope);
+}
+
+size_t ANB_rope_data_len(ANB_Rope_t* rope) {
+    if (!rope) abort();
+    return rope->len;
+}
+
+size_t ANB_rope_segment_count(ANB_Rope_t* rope) {
+    if (!rope) abort();
+    return rope->nsegs;
+}
+
+void ANB_rope_push(ANB_Rope_t* rope, const uint8_t* bytes, size_t len) {
+    if (!rope) abort();
+    if (len && !bytes) abort();
+    rope->len += len;
+    while (len) {
+        ANB_RopeSeg_t *seg = rope->tail;
+        if (!seg || seg->len == seg->cap) seg = ANB_r_link(rope, rope->seg_size);
+        size_t n = seg->cap - seg->len;
+        if (n > len) n = len;
+        memcpy(ANB_r_data(seg) + seg->len, bytes, n);
+        seg->len += n;
+        bytes += n;
+        len -= n;
+    }
+}
+
+uint8_t *ANB_rope_reserve(ANB_Rope_t* rope, size_t min_len, size_t *avail) {
+    if (!rope) abort();
+    ANB_RopeSeg_t *seg = rope->tail;
+    size_t need = min_len ? min_len : 1;
+    if (!seg || seg->cap - seg->len < need) {
+        seg = ANB_r_link(rope, min_len > rope->seg_size ? min_len : rope->seg_size);
+    }
+    if (avail) *avail = seg->cap - seg->len;
+    return ANB_r_data(seg) + seg->len;
+}
+
+void ANB_rope_commit(ANB_Rope_t* rope, size_t n) {
+    if (!rope) abort();
+    if (!n) return;
+    ANB_RopeSeg_t *seg = rope->tail;
+    if (!seg || n > seg->cap - seg->len) abort();
+    seg->len += n;
+    rope->len += n;
+}
+
+uint8_t *ANB_rope_segment_iter(ANB_Rope_t* rope, ANB_RopeIter_t *iter, size_t *len) {
+    if (!rope || !iter) abort();
+    const ANB_RopeSeg_t *seg = iter->_seg ? ((const ANB_RopeSeg_t *)iter->_seg)->next : rope->head;
+    // Skip empty segments (a fully read head, an uncommitted tail)
+    for (; seg; seg = seg->next) {
+        size_t off = seg == rope->head ? rope->rpos : 0;
+        iter->_seg = seg;
+        if (seg->len > off) {
+            if (len) *len = seg->len - off;
+            return ANB_r_data(seg) + off;
+        }
+    }
+    if (len) *len = 0;
+    return NULL;
+}
+
+int ANB_rope_iovec(ANB_Rope_t* rope, struct iovec *iov, int max) {
+    if (!rope) abort();
+    if (max > 0 && !iov) abort();
+    int n = 0;
+    for (const ANB_RopeSeg_t *seg = rope->head; seg && n < max; seg = seg->next) {
+        size_t off = seg == rope->head ? rope->rpos : 0;
+        if (seg->len == off) continue;
+        iov[n].iov_base = ANB_r_data(seg) + off;
+        iov[n].iov_len = seg->len - off;
+        n++;
+    }
+    return n;
+}
+
+void ANB_rope_consume(ANB_Rope_t* rope, size_t n) {
+    if (!rope) abort();
+    if (n > rope->len) abort();
+    rope->len -= n;
+    while (n) {
+        ANB_RopeSeg_t *seg = rope->head;
+        size_t take = seg->len - rope->rpos;
+        if (take > n) take = n;
+        rope->rpos += take;
+        n -= take;
+        if (rope->rpos == seg->len && seg->next) {
+            rope->head = seg->next;
+            rope->rpos = 0;
+            rope->nsegs--;
+            ANB_r_seg_free(seg);
+        }
+    }
+    // Everything read: start over in the remaining segment
+    if (!rope->len) ANB_r_drop(rope);
+}
+
+void ANB_rope_reset(ANB_Rope_t* rope) {
+    if (!rope) abort();
+    ANB_r_drop(rope);
+}
+
+uint8_t *ANB_rope_flatten(ANB_Rope_t* rope, size_t *len) {
+    if (!rope) abort();
+    if (len) *len = rope->len;
+    if (!rope->len) return NULL;
+
+    // Already contiguous if the head holds every unread byte
+    ANB_RopeSeg_t *head = rope->head;
+    if (head->len - rope->rpos == rope->len) return ANB_r_data(head) + rope->rpos;
+
+    ANB_RopeSeg_t *flat = ANB_r_seg_new(rope, rope->len);
+    ANB_RopeIter_t it = {0};
+    size_t n;
+    uint8_t *p;
+    while ((p = ANB_rope_segment_iter(rope, &it, &n)) != NULL) {
+        memcpy(ANB_r_data(flat) + flat->len, p, n);
+        flat->len += n;
+    }
+    for (ANB_RopeSeg_t *seg = head; seg;) {
+        ANB_RopeSeg_t *next = seg->next;
+        ANB_r_seg_free(seg);
+        seg = next;
+    }
+    rope->head = rope->tail = flat;
+    rope->rpos = 0;
+    rope->nsegs = 1;
+    return ANB_r_data(flat);
+}
+
+size_t ANB_rope_copy_out(ANB_Rope_t* rope, size_t offset, uint8_t *dst, size_t len) {
+    if (!rope) abort();
+    if (offset >= rope->len || !len) return 0;
+    if (!dst) abort();
+    size_t copied = 0;
+    ANB_RopeIter_t it = {0};
+    size_t n;
+    uint8_t *p;
+    while (copied < len && (p = ANB_rope_segment_iter(rope, &it, &n)) != NULL) {
+        if (offset >= n) {
+            offset -= n;
+            continue;
+        }
+        p += offset;
+        n -= offset;
+        offset = 0;
+        if (n > len - copied) n = len - copied;
+        memcpy(dst + copied, p, n);
+        copied += n;
+    }
+    return copied;
+}
@@ -0,0 +1,376 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include <stdint.h>
+#include "shm_slab.h"
+#include "futex_internal.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define ANB_Q_ALIGN_UP(x) (((x) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+
+#define ANB_Q_MAGIC 0x51424E41u  // "ANBQ"
+
+#define ANB_Q_READY (1ull << 63) // Record is published
+#define ANB_Q_LEN   (ANB_Q_READY - 1)
+
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+               "queue positions must be lock-free to be shared between processes");
+
+// Segment header, at offset 0. Only plain values and offsets; never pointers.
+typedef struct ANB_ShmHead {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;          // Size of the data area, a power of two
+    uint64_t data_off;          // Offset of the data area from the segment start, a multiple of the page size
+    uint32_t flags;             // Creation flags
+    uint32_t reserved;
+
+    // Positions count bytes ever used, so they never wrap; the offset in the data area is pos & (capacity - 1)
+    _Alignas(64) _Atomic uint64_t claim; // End of the space handed out to producers
+    _Atomic uint64_t tail;      // Single producer: end of the published items
+    _Atomic uint64_t pushed;    // Items published
+    _Alignas(64) _Atomic uint64_t head;  // Start of the first item not popped; written by the consumer only
+    _Atomic uint64_t popped;    // Items popped
+    _Alignas(64) _Atomic uint32_t wake_seq; // Futex word, bumped to wake the consumer
+    _Atomic uint32_t waiters;   // Consumer is about to sleep or sleeping
+} ANB_ShmHead_t;
+
+// Precedes every item in the data area
+typedef struct ANB_ShmRec {
+    _Atomic uint64_t word;      // ANB_Q_READY | length
+    uint64_t pos;               // Queue position of this record
+} ANB_ShmRec_t;
+
+_Static_assert(sizeof(ANB_ShmRec_t) == ANB_Q_ALIGN_UP(sizeof(ANB_ShmRec_t)), "items must stay aligned");
+
+#define ANB_Q_REC(len) (sizeof(ANB_ShmRec_t) + ANB_Q_ALIGN_UP(len))
+
+struct ANB_ShmSlab {
+    ANB_ShmHead_t *hdr;         // Start of this process's mapping
+    uint8_t *data;              // Data area in this mapping, followed by a second view of it
+    size_t capacity;            // Checked copy of hdr->capacity; the shared value is not trusted again
+    size_t map_len;
+    unsigned flags;
+    int fd;
+    char *name;                 // Named segment this handle created, unlinked on destroy
+};
+
+static inline ANB_ShmRec_t *ANB_q_rec(ANB_ShmSlab_t* queue, uint64_t pos) {
+    return (ANB_ShmRec_t *)(queue->data + (pos & (queue->capacity - 1)));
+}
+
+static size_t ANB_q_page(void) {
+    long page = sysconf(_SC_PAGESIZE);
+    return page > 0 ? (size_t)page : 4096;
+}
+
+// Map the header and data area, then the data area again right after it, so an item
+// crossing the end of the data area is contiguous in memory
+static uint8_t *ANB_q_map_twice(int fd, size_t data_off, size_t cap) {
+    size_t len = data_off + 2 * cap;
+    uint8_t *base = (uint8_t *)mmap(NULL, len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == (uint8_t *)MAP_FAILED) return NULL;
+    if (mmap(base, data_off + cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+        mmap(base + data_off + cap, cap, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, (off_t)data_off) ==
+            MAP_FAILED) {
+        int err = errno;
+        munmap(base, len);
+        errno = err;
+        return NULL;
+    }
+    return base;
+}
+
+// Map fd and check that it holds a queue of this layout; NULL with errno set otherwise
+static ANB_ShmSlab_t* ANB_q_map(int fd, size_t expect_cap) {
+    size_t page = ANB_q_page();
+    struct stat st;
+    if (fstat(fd, &st) != 0) return NULL;
+    size_t len = (size_t)st.st_size;
+    size_t data_off = page;
+    size_t cap = expect_cap;
+    unsigned flags = 0;
+    if (!expect_cap) {
+        // Check a private copy of the header before trusting its sizes for the mapping
+        ANB_ShmHead_t head;
+        if (st.st_size < (off_t)sizeof(head) || pread(fd, &head, sizeof(head), 0) != (ssize_t)sizeof(head)) {
+            errno = EINVAL;
+            return NULL;
+        }
+        data_off = (size_t)head.data_off;
+        cap = (size_t)head.capacity;
+        flags = head.flags;
+        if (head.magic != ANB_Q_MAGIC || head.version != ANB_SHM_SLAB_VERSION || data_off % page ||
+            data_off < sizeof(ANB_ShmHead_t) || cap == 0 || (cap & (cap - 1)) || cap % page ||
+            (flags & ~(unsigned)ANB_SHM_MPSC)) {
+            errno = EINVAL;
+            return NULL;
+        }
+    }
+    if (st.st_size < 0 || len < data_off || len - data_off != cap || cap > (SIZE_MAX - data_off) / 2) {
+        errno = EINVAL;
+        return NULL;
+    }
+    uint8_t *map = ANB_q_map_twice(fd, data_off, cap);
+    if (!map) return NULL;
+
+    ANB_ShmSlab_t* queue = (ANB_ShmSlab_t*)calloc(1, sizeof(ANB_ShmSlab_t));
+    if (!queue) abort();
+    queue->hdr = (ANB_ShmHead_t *)map;
+    queue->data = map + data_off;
+    queue->capacity = cap;
+    queue->map_len = data_off + 2 * cap;
+    queue->flags = flags;
+    queue->fd = fd;
+    return queue;
+}
+
+ANB_ShmSlab_t* ANB_shm_slab_create(const char *name, size_t capacity, unsigned flags) {
+    if (capacity == 0) abort();
+    if (flags & ~(unsigned)ANB_SHM_MPSC) abort();
+    size_t page = ANB_q_page();
+    size_t cap = page;
+    while (cap < capacity) {
+        if (cap > SIZE_MAX / 4) abort();
+        cap <<= 1;
+    }
+
+    int fd;
+    if (name) {
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    } else {
+#if defined(__linux__)
+        fd = memfd_create("anb_shm_slab", MFD_CLOEXEC);
+#else
+        char tmp[64];
+        snprintf(tmp, sizeof(tmp), "/anb_shm_slab_%ld_%p", (long)getpid(), (void *)&tmp);
+        fd = shm_open(tmp, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) shm_unlink(tmp);
+#endif
+    }
+    if (fd < 0) return NULL;
+
+    ANB_ShmSlab_t* queue = NULL;
+    if (ftruncate(fd, (off_t)(page + cap)) == 0) queue = ANB_q_map(fd, cap);
+    if (!queue) {
+        int err = errno;
+        close(fd);
+        if (name) shm_unlink(name);
+        errno = err;
+        return NULL;
+    }
+    if (name) {
+        queue->name = strdup(name);
+        if (!queue->name) abort();
+    }
+
+    // The segment starts zeroed, so every record word reads as unpublished
+    ANB_ShmHead_t *hdr = queue->hdr;
+    hdr->version = ANB_SHM_SLAB_VERSION;
+    hdr->capacity = cap;
+    hdr->data_off = page;
+    hdr->flags = flags;
+    queue->flags = flags;
+    hdr->magic = ANB_Q_MAGIC;
+    return queue;
+}
+
+ANB_ShmSlab_t* ANB_shm_slab_open_fd(int fd) {
+    int own = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (own < 0) return NULL;
+    ANB_ShmSlab_t* queue = ANB_q_map(own, 0);
+    if (!queue) {
+        int err = errno;
+        close(own);
+        errno = err;
+    }
+    return queue;
+}
+
+ANB_ShmSlab_t* ANB_shm_slab_open(const char *name) {
+    if (!name) abort();
+    int fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0) return NULL;
+    ANB_ShmSlab_t* queue = ANB_q_map(fd, 0);
+    if (!queue) {
+        int err = errno;
+        close(fd);
+        errno = err;
+    }
+    return queue;
+}
+
+void ANB_shm_slab_destroy(ANB_ShmSlab_t* queue) {
+    if (queue) {
+        munmap(queue->hdr, queue->map_len);
+        close(queue->fd);
+        if (queue->name) {
+            shm_unlink(queue->name);
+            free(queue->name);
+        }
+        free(queue);
+    }
+}
+
+int ANB_shm_slab_fd(ANB_ShmSlab_t* queue) {
+    if (!queue) abort();
+    return queue->fd;
+}
+
+size_t ANB_shm_slab_capacity(ANB_ShmSlab_t* queue) {
+    if (!queue) abort();
+    return queue->capacity;
+}
+
+uint8_t *ANB_shm_slab_alloc_item(ANB_ShmSlab_t* queue, size_t data_len) {
+    if (!queue) abort();
+    ANB_ShmHead_t *hdr = queue->hdr;
+    size_t cap = queue->capacity;
+    if (data_len > cap - sizeof(ANB_ShmRec_t)) return NULL;
+    size_t need = ANB_Q_REC(data_len);
+    int mpsc = queue->flags & ANB_SHM_MPSC;
+
+    uint64_t t;
+    for (;;) {
+        // Head first: whatever it has reached was claimed before, so claim read after it is never behind
+        uint64_t h = atomic_load_explicit(&hdr->head, memory_order_acquire);
+        t = atomic_load_explicit(&hdr->claim, memory_order_relaxed);
+        // An item crossing the end of the data area continues in the second view, so free space is all that counts
+        if (t + need - h > cap) return NULL;
+        if (!mpsc) {
+            atomic_store_explicit(&hdr->claim, t + need, memory_order_relaxed);
+            break;
+        }
+        if (atomic_compare_exchange_weak_explicit(&hdr->claim, &t, t + need,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    ANB_ShmRec_t *rec = ANB_q_rec(queue, t);
+    rec->pos = t;
+    atomic_store_explicit(&rec->word, data_len, memory_order_relaxed);
+    return (uint8_t *)(rec + 1);
+}
+
+void ANB_shm_slab_publish(ANB_ShmSlab_t* queue, uint8_t *item) {
+    if (!queue || !item) abort();
+    ANB_ShmHead_t *hdr = queue->hdr;
+    ANB_ShmRec_t *rec = (ANB_ShmRec_t *)item - 1;
+    uint64_t word = atomic_load_explicit(&rec->word, memory_order_relaxed);
+    if (word & ANB_Q_READY) abort(); // Published twice
+
+    if (queue->flags & ANB_SHM_MPSC) {
+        atomic_store_explicit(&rec->word, word | ANB_Q_READY, memory_order_release);
+        atomic_fetch_add_explicit(&hdr->pushed, 1, memory_order_relaxed);
+    } else {
+        atomic_store_explicit(&rec->word, word | ANB_Q_READY, memory_order_relaxed);
+        atomic_store_explicit(&hdr->pushed, atomic_load_explicit(&hdr->pushed, memory_order_relaxed) + 1,
+                              memory_order_relaxed);
+        atomic_store_explicit(&hdr->tail, rec->pos + ANB_Q_REC(word & ANB_Q_LEN), memory_order_release);
+    }
+
+    // Pairs with the fence in ANB_shm_slab_wait: either it sees the item or we see the waiter
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&hdr->waiters, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&hdr->wake_seq, 1, memory_order_release);
+        ANB_futex_wake(&hdr->wake_seq, 1);
+    }
+}
+
+int ANB_shm_slab_push_item(ANB_ShmSlab_t* queue, const uint8_t *data, size_t data_len) {
+    uint8_t *dst = ANB_shm_slab_alloc_item(queue, data_len);
+    if (!dst) return -1;
+    if (data_len) memcpy(dst, data, data_len);
+    ANB_shm_slab_publish(queue, dst);
+    return 0;
+}
+
+// Published item at pos; NULL if there is none yet.
+// A record larger than the data area (a corrupted segment) also ends the queue.
+static ANB_ShmRec_t *ANB_q_item(ANB_ShmSlab_t* queue, uint64_t pos) {
+    ANB_ShmRec_t *rec = ANB_q_rec(queue, pos);
+    uint64_t word;
+    if (queue->flags & ANB_SHM_MPSC) {
+        word = atomic_load_explicit(&rec->word, memory_order_acquire);
+        if (!(word & ANB_Q_READY)) return NULL;
+    } else {
+        if (pos >= atomic_load_explicit(&queue->hdr->tail, memory_order_acquire)) return NULL;
+        word = atomic_load_explicit(&rec->word, memory_order_relaxed);
+    }
+    if ((word & ANB_Q_LEN) > queue->capacity - sizeof(ANB_ShmRec_t)) return NULL;
+    return rec;
+}
+
+uint8_t *ANB_shm_slab_peek_item_iter(ANB_ShmSlab_t* queue, ANB_ShmSlabIter_t *iter, size_t *out_size) {
+    if (!queue) abort();
+    uint64_t pos = atomic_load_explicit(&queue->hdr->head, memory_order_relaxed);
+    if (iter && iter->_pos > pos) pos = iter->_pos;
+    ANB_ShmRec_t *rec = ANB_q_item(queue, pos);
+    if (!rec) return NULL;
+    size_t len = (size_t)(atomic_load_explicit(&rec->word, memory_order_relaxed) & ANB_Q_LEN);
+    if (out_size) *out_size = len;
+    if (iter) iter->_pos = pos + ANB_Q_REC(len);
+    return (uint8_t *)(rec + 1);
+}
+
+int ANB_shm_slab_pop_item(ANB_ShmSlab_t* queue) {
+    if (!queue) abort();
+    ANB_ShmHead_t *hdr = queue->hdr;
+    uint64_t h = atomic_load_explicit(&hdr->head, memory_order_relaxed);
+    ANB_ShmRec_t *rec = ANB_q_item(queue, h);
+    if (!rec) return -1;
+    uint64_t end = h + ANB_Q_REC((size_t)(atomic_load_explicit(&rec->word, memory_order_relaxed) & ANB_Q_LEN));
+
+    if (queue->flags & ANB_SHM_MPSC) {
+        // Producers only mark a record published, so the next lap must find zeros where its headers land
+        memset(ANB_q_rec(queue, h), 0, (size_t)(end - h));
+    }
+    atomic_store_explicit(&hdr->popped, atomic_load_explicit(&hdr->popped, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+    atomic_store_explicit(&hdr->head, end, memory_order_release);
+    return 0;
+}
+
+size_t ANB_shm_slab_item_count(ANB_ShmSlab_t* queue) {
+    if (!queue) abort();
+    uint64_t popped = atomic_load_explicit(&queue->hdr->popped, memory_order_acquire);
+    uint64_t pushed = atomic_load_explicit(&queue->hdr->pushed, memory_order_acquire);
+    return pushed > popped ? (size_t)(pushed - popped) : 0;
+}
+
+static int ANB_q_ready(ANB_ShmSlab_t* queue) {
+    return ANB_q_item(queue, atomic_load_explicit(&queue->hdr->head, memory_order_relaxed)) != NULL;
+}
+
+int ANB_shm_slab_wait(ANB_ShmSlab_t* queue, int timeout_ms) {
+    if (!queue) abort();
+    if (ANB_q_ready(queue)) return 1;
+    if (timeout_ms == 0) return 0;
+
+    ANB_ShmHead_t *hdr = queue->hdr;
+    struct timespec deadline, rel;
+    if (timeout_ms > 0) ANB_deadline_set(&deadline, timeout_ms);
+    for (;;) {
+        uint32_t seq = atomic_load_explicit(&hdr->wake_seq, memory_order_acquire);
+        atomic_fetch_add_explicit(&hdr->waiters, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int ready = ANB_q_ready(queue);
+        int expired = !ready && timeout_ms > 0 && !ANB_deadline_left(&deadline, &rel);
+        // A publish that bumped wake_seq since the load makes this return at once
+        if (!ready && !expired) ANB_futex_wait(&hdr->wake_seq, seq, timeout_ms > 0 ? &rel : NULL, 1);
+        atomic_fetch_sub_explicit(&hdr->waiters, 1, memory_order_relaxed);
+        if (ready) return 1;
+        if (expired) return ANB_q_ready(queue);
+    }
+}
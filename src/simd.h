@@ -0,0 +1,45 @@
+#pragma once
+/**
+ * @file simd.h
+ * @brief Internal CPU feature checks for run-time dispatch of vector code paths.
+ *
+ * Vector kernels are compiled with a per-function target attribute
+ * (ANB_SIMD_TARGET) so the library itself keeps the baseline ISA. Each
+ * module picks its kernel once, on first use, from ANB_simd_has().
+ * ANB_SIMD_X86 is 0 on other architectures and compilers, where only the
+ * scalar paths exist.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ANB_SIMD_X86 1
+#define ANB_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ANB_SIMD_X86 0
+#define ANB_SIMD_TARGET(isa)
+#endif
+
+/** Feature bits for ANB_simd_has. */
+#define ANB_SIMD_SSE2  (1u << 0)
+#define ANB_SIMD_SSSE3 (1u << 1)
+#define ANB_SIMD_SSE42 (1u << 2)
+#define ANB_SIMD_AVX2  (1u << 3)
+
+/**
+ * @brief Check CPU features.
+ * @param features Bitwise OR of ANB_SIMD_* bits.
+ * @return Non-zero if the CPU supports all of them. Always 0 without ANB_SIMD_X86.
+ */
+static inline int ANB_simd_has(unsigned features) {
+#if ANB_SIMD_X86
+    unsigned have = 0;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) have |= ANB_SIMD_SSE2;
+    if (__builtin_cpu_supports("ssse3")) have |= ANB_SIMD_SSSE3;
+    if (__builtin_cpu_supports("sse4.2")) have |= ANB_SIMD_SSE42;
+    if (__builtin_cpu_supports("avx2")) have |= ANB_SIMD_AVX2;
+    return (have & features) == features;
+#else
+    (void)features;
+    return 0;
+#endif
+}
@@ -1,8 +1,22 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
 #include <stdint.h>
 #include "slab.h"
+#include "growth.h"
+#include "growth_internal.h"
+#include "futex_internal.h"
+#include "vmem.h"
+#include <fcntl.h>
+#include <stdatomic.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
 
 #define ANB_S_ALIGN_UP(x) (((x) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
 
@@ -23,68 +37,244 @@ struct ANB_Slab {
   size_t index_cap;    // Capacity (number of slots)
 
   uint64_t version;    // Incremented on buffer reset (all items consumed)
+  size_t head_idx;     // Every item before this index is deleted
+  size_t head_off;     // Byte offset of the item at head_idx
+
+  ANB_GrowthPolicy_t growth; // Applied to data growth; the index doubles
+
+  unsigned data_state;  // Backing store state of data (see vmem.h)
+  unsigned index_state; // Backing store state of index
+  unsigned meta_state;  // Backing store state of metadata
+
+  size_t min_size;            // Initial size, trim never goes below it
+  ANB_TrimPolicy_t trim;      // Automatic trim on reset, disabled by default
+  ANB_TrimState_t data_trim;  // Hysteresis for the data buffer
+  ANB_TrimState_t index_trim; // Hysteresis for the index, in bytes of index storage
+
+  int in_place;         // Struct lives in caller storage (ANB_slab_init_in), not freed on destroy
+
+  // Blocking waits. Waiters read these without the exclusive access push and pop need
+  _Atomic size_t ready;       // Copy of count, stored after every change
+  _Atomic int watched;        // Set once a waiter or event fd exists; only then pushes look for sleepers
+  _Atomic int sleeping;       // A thread may sleep on wake_seq; the first push after clears it and wakes
+  _Atomic uint32_t wake_seq;  // Futex word
+  _Atomic int armed;          // The next push writes to the event fd
+  _Atomic int event_fd;       // Readable end handed out by ANB_slab_event_fd, -1 until then
+  int event_wr;               // Writable end: the eventfd itself, or the other end of a pipe
 };
 
 
 ANB_Slab_t* ANB_slab_create(size_t initial_size) {
+    return ANB_slab_create_ex(initial_size, 0);
+}
+
+ANB_Slab_t* ANB_slab_create_ex(size_t initial_size, unsigned flags) {
     if (initial_size == 0) abort();
+    if (flags & ~ANB_MEM_FLAGS_ALL) abort();
     ANB_Slab_t* queue = (ANB_Slab_t*)calloc(1, sizeof(ANB_Slab_t));
     if (!queue) abort();
 
-    queue->data = (uint8_t *)malloc(initial_size);
+    // Creation flags apply to the data buffer; the index holds no payload and follows only for locking and prefaulting
+    queue->data_state = flags;
+    queue->index_state = flags & (ANB_MEM_PREFAULT | ANB_MEM_MLOCK);
+    queue->meta_state = queue->index_state;
+
+    queue->data = ANB_vmem_alloc(initial_size, &queue->data_state);
     if (!queue->data) abort();
 
     queue->size = initial_size;
+    queue->min_size = initial_size;
 
-    queue->index = (size_t *)calloc(ANB_S_INITIAL_INDEX_CAP, sizeof(size_t));
+    queue->index = (size_t *)ANB_vmem_alloc(ANB_S_INITIAL_INDEX_CAP * sizeof(size_t), &queue->index_state);
     if (!queue->index) abort();
-    queue->metadata = (uint8_t *)calloc(ANB_S_INITIAL_INDEX_CAP, sizeof(uint8_t));
+    queue->metadata = ANB_vmem_alloc(ANB_S_INITIAL_INDEX_CAP * sizeof(uint8_t), &queue->meta_state);
     if (!queue->metadata) abort();
+    memset(queue->metadata, 0, ANB_S_INITIAL_INDEX_CAP * sizeof(uint8_t));
     queue->index_cap = ANB_S_INITIAL_INDEX_CAP;
+    atomic_init(&queue->event_fd, -1);
+
+    ANB_slab_set_growth(queue, NULL);
+
+    return queue;
+}
+
+ANB_Slab_t* ANB_slab_init_in(void *buf, size_t len, unsigned flags) {
+    if (!buf) return NULL;
+    if (flags & ~(ANB_MEM_SPILL | ANB_MEM_SECURE)) return NULL;
+
+    // Layout: struct | index | metadata | data, each start max_align_t aligned
+    uint8_t *base = (uint8_t *)ANB_S_ALIGN_UP((uintptr_t)buf);
+    uint8_t *end = (uint8_t *)buf + len;
+    size_t head = ANB_S_ALIGN_UP(sizeof(ANB_Slab_t));
+    if (base > end || (size_t)(end - base) < head) return NULL;
+    size_t avail = (size_t)(end - base) - head;
+
+    // Enough slots for the smallest possible items, so the index never fills before the data
+    size_t slots = avail / (ANB_S_ALIGN_UP(1) + sizeof(size_t) + sizeof(uint8_t));
+    if (slots == 0) return NULL;
+    uint8_t *index = base + head;
+    uint8_t *metadata = index + slots * sizeof(size_t);
+    uint8_t *data = (uint8_t *)ANB_S_ALIGN_UP((uintptr_t)(metadata + slots));
+    if (data >= end) return NULL;
+
+    ANB_Slab_t* queue = (ANB_Slab_t*)base;
+    memset(queue, 0, sizeof(*queue));
+    queue->in_place = 1;
+
+    queue->data_state = flags | ANB_VMEM_EXTERNAL;
+    queue->index_state = (flags & ANB_MEM_SPILL) | ANB_VMEM_EXTERNAL;
+    queue->meta_state = queue->index_state;
+
+    queue->data = data;
+    queue->size = (size_t)(end - data);
+    if (queue->size > slots * ANB_S_ALIGN_UP(1)) queue->size = slots * ANB_S_ALIGN_UP(1);
+    queue->min_size = queue->size;
+    queue->index = (size_t *)index;
+    queue->metadata = metadata;
+    memset(queue->metadata, 0, slots * sizeof(uint8_t));
+    queue->index_cap = slots;
+    atomic_init(&queue->event_fd, -1);
+
+    ANB_slab_set_growth(queue, NULL);
 
     return queue;
 }
 
 void ANB_slab_destroy(ANB_Slab_t* queue) {
     if (queue) {
-        free(queue->data);
-        free(queue->index);
-        free(queue->metadata);
-        free(queue);
+        int fd = atomic_load_explicit(&queue->event_fd, memory_order_relaxed);
+        if (fd >= 0) {
+            close(fd);
+            if (queue->event_wr != fd) close(queue->event_wr);
+        }
+        ANB_vmem_free(queue->data, queue->size, queue->data_state);
+        ANB_vmem_free((uint8_t *)queue->index, queue->index_cap * sizeof(size_t), queue->index_state);
+        ANB_vmem_free(queue->metadata, queue->index_cap * sizeof(uint8_t), queue->meta_state);
+        if (!queue->in_place) free(queue);
     }
 }
 
-uint8_t *ANB_slab_alloc_item(ANB_Slab_t* queue, size_t data_len) {
+void ANB_slab_set_growth(ANB_Slab_t* queue, const ANB_GrowthPolicy_t *policy) {
     if (!queue) abort();
+    static const ANB_GrowthPolicy_t def = ANB_GROWTH_DEFAULT;
+    if (policy) ANB_growth_check(policy);
+    queue->growth = policy ? *policy : def;
+}
 
-    size_t aligned_len = ANB_S_ALIGN_UP(data_len);
+void ANB_slab_set_trim(ANB_Slab_t* queue, const ANB_TrimPolicy_t *policy) {
+    if (!queue) abort();
+    static const ANB_TrimPolicy_t off = { 0, 0, ANB_TRIM_SHRINK };
+    queue->trim = policy ? *policy : off;
+    memset(&queue->data_trim, 0, sizeof(queue->data_trim));
+    memset(&queue->index_trim, 0, sizeof(queue->index_trim));
+}
 
-    // Expand data buffer if needed
-    if (queue->write_pos + aligned_len > queue->size) {
-        size_t new_size = queue->size;
-        while (new_size < queue->write_pos + aligned_len) {
-          if (new_size >= SIZE_MAX / 2) abort();
-          new_size *= 2;
-        }
-        queue->data = (uint8_t *)realloc(queue->data, new_size);
+// Shrink data to data_target bytes and the index to index_target slots, never below what is in use
+static void ANB_s_shrink(ANB_Slab_t* queue, size_t data_target, size_t index_target, int mode) {
+    if (data_target < queue->min_size) data_target = queue->min_size;
+    if (data_target < queue->write_pos) data_target = queue->write_pos;
+    // Caller storage keeps its size; only spilled buffers can shrink
+    if (data_target < queue->size && !(queue->data_state & ANB_VMEM_EXTERNAL) &&
+        (mode != ANB_TRIM_RELEASE ||
+         ANB_vmem_release_tail(queue->data, queue->size, data_target, queue->data_state) != 0)) {
+        queue->data = ANB_vmem_resize(queue->data, queue->size, data_target, &queue->data_state);
         if (!queue->data) abort();
-        queue->size = new_size;
+        queue->size = data_target;
     }
 
-    uint8_t *ptr = queue->data + queue->write_pos;
-    queue->write_pos += aligned_len;
+    if (index_target < ANB_S_INITIAL_INDEX_CAP) index_target = ANB_S_INITIAL_INDEX_CAP;
+    if (index_target < queue->index_write) index_target = queue->index_write;
+    if (index_target < queue->index_cap && !(queue->index_state & ANB_VMEM_EXTERNAL)) {
+        queue->index = (size_t *)ANB_vmem_resize((uint8_t *)queue->index, queue->index_cap * sizeof(size_t),
+                                                 index_target * sizeof(size_t), &queue->index_state);
+        if (!queue->index) abort();
+        queue->metadata = ANB_vmem_resize(queue->metadata, queue->index_cap * sizeof(uint8_t),
+                                          index_target * sizeof(uint8_t), &queue->meta_state);
+        if (!queue->metadata) abort();
+        queue->index_cap = index_target;
+    }
+}
+
+void ANB_slab_trim(ANB_Slab_t* queue) {
+    if (!queue) abort();
+    ANB_s_shrink(queue, queue->write_pos, queue->index_write, ANB_TRIM_SHRINK);
+}
+
+// Make the new item count visible to waiters. Sequentially consistent so that, with the watched
+// load in ANB_s_signal, either a new waiter sees the item or the push sees the waiter
+static inline void ANB_s_publish(ANB_Slab_t* queue) {
+    atomic_store_explicit(&queue->ready, queue->count, memory_order_seq_cst);
+}
+
+static void ANB_s_event_write(ANB_Slab_t* queue) {
+    ssize_t r;
+#if defined(__linux__)
+    uint64_t one = 1;
+    r = write(queue->event_wr, &one, sizeof(one));
+#else
+    uint8_t one = 1;
+    r = write(queue->event_wr, &one, 1);
+#endif
+    (void)r; // Already readable if full
+}
 
-    // Expand index buffers if needed
+// After a push: publish the count and wake sleepers and the event fd, once per burst
+static void ANB_s_signal(ANB_Slab_t* queue) {
+    ANB_s_publish(queue);
+    if (!atomic_load_explicit(&queue->watched, memory_order_seq_cst)) return;
+    // Pairs with the fences in ANB_slab_wait_nonempty and ANB_slab_event_ack: they see the item or we see them
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&queue->sleeping, memory_order_relaxed) &&
+        atomic_exchange_explicit(&queue->sleeping, 0, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&queue->wake_seq, 1, memory_order_release);
+        ANB_futex_wake(&queue->wake_seq, 0);
+    }
+    if (atomic_load_explicit(&queue->armed, memory_order_relaxed) &&
+        atomic_exchange_explicit(&queue->armed, 0, memory_order_relaxed)) {
+        ANB_s_event_write(queue);
+    }
+}
+
+static uint8_t *ANB_s_alloc(ANB_Slab_t* queue, size_t data_len) {
+    if (!queue) abort();
+
+    size_t aligned_len = ANB_S_ALIGN_UP(data_len);
+
+    // Expand index buffers if needed. Done first so a full in-place slab fails with nothing changed
     if (queue->index_write >= queue->index_cap) {
+        // The index keeps doubling whatever the data policy: its sizes mean nothing to a custom fn
+        if (queue->index_cap > SIZE_MAX / (2 * sizeof(size_t))) abort();
         size_t new_cap = queue->index_cap * 2;
-        queue->index = (size_t *)realloc(queue->index, new_cap * sizeof(size_t));
-        if (!queue->index) abort();
-        queue->metadata = (uint8_t *)realloc(queue->metadata, new_cap * sizeof(uint8_t));
+        size_t *index = (size_t *)ANB_vmem_resize((uint8_t *)queue->index, queue->index_cap * sizeof(size_t),
+                                                  new_cap * sizeof(size_t), &queue->index_state);
+        if (!index) {
+            if (ANB_VMEM_IS_FIXED(queue->index_state)) return NULL;
+            abort();
+        }
+        queue->index = index;
+        queue->metadata = ANB_vmem_resize(queue->metadata, queue->index_cap * sizeof(uint8_t),
+                                          new_cap * sizeof(uint8_t), &queue->meta_state);
         if (!queue->metadata) abort();
         memset(queue->metadata + queue->index_cap, 0, (new_cap - queue->index_cap) * sizeof(uint8_t));
         queue->index_cap = new_cap;
     }
 
+    // Expand data buffer if needed
+    if (queue->write_pos + aligned_len > queue->size) {
+        if (aligned_len > SIZE_MAX - queue->write_pos) abort();
+        size_t new_size = ANB_growth_next(&queue->growth, queue->size, queue->write_pos + aligned_len);
+        uint8_t *data = ANB_vmem_resize(queue->data, queue->size, new_size, &queue->data_state);
+        if (!data) {
+            if (ANB_VMEM_IS_FIXED(queue->data_state)) return NULL;
+            abort();
+        }
+        queue->data = data;
+        queue->size = new_size;
+    }
+
+    uint8_t *ptr = queue->data + queue->write_pos;
+    queue->write_pos += aligned_len;
+
     // Record this entry's aligned size and padding (low nibble), flags zeroed
     queue->metadata[queue->index_write] = (uint8_t)(aligned_len - data_len);
     queue->index[queue->index_write++] = aligned_len;
@@ -93,10 +283,19 @@ uint8_t *ANB_slab_alloc_item(ANB_Slab_t* queue, size_t data_len) {
     return ptr;
 }
 
-void ANB_slab_push_item(ANB_Slab_t* queue, const uint8_t* data, size_t data_len) {
+uint8_t *ANB_slab_alloc_item(ANB_Slab_t* queue, size_t data_len) {
+    uint8_t *ptr = ANB_s_alloc(queue, data_len);
+    if (ptr) ANB_s_signal(queue);
+    return ptr;
+}
+
+int ANB_slab_push_item(ANB_Slab_t* queue, const uint8_t* data, size_t data_len) {
     if (!data) abort();
-    uint8_t *ptr = ANB_slab_alloc_item(queue, data_len);
+    uint8_t *ptr = ANB_s_alloc(queue, data_len);
+    if (!ptr) return -1;
     memcpy(ptr, data, data_len);
+    ANB_s_signal(queue);
+    return 0;
 }
 
 size_t ANB_slab_size(ANB_Slab_t* queue) {
@@ -104,6 +303,11 @@ size_t ANB_slab_size(ANB_Slab_t* queue) {
     return queue->write_pos;
 }
 
+size_t ANB_slab_capacity(ANB_Slab_t* queue) {
+    if (!queue) abort();
+    return queue->size;
+}
+
 size_t ANB_slab_item_count(ANB_Slab_t* queue) {
     if (!queue) abort();
     return queue->count;
@@ -115,6 +319,11 @@ uint8_t *ANB_slab_peek_item_iter(ANB_Slab_t* queue, ANB_SlabIter_t *iter, size_t
 
     if (iter->_idx == 0 && iter->_n_off == 0) {
         iter->_version = queue->version;
+        if (iter->_n_idx == 0) {
+            // Fresh iterator: start past the deleted prefix instead of rescanning it
+            iter->_n_idx = queue->head_idx;
+            iter->_n_off = queue->head_off;
+        }
     }
 
     for (;;) {
@@ -131,6 +340,10 @@ uint8_t *ANB_slab_peek_item_iter(ANB_Slab_t* queue, ANB_SlabIter_t *iter, size_t
       size_t idx = iter->_idx;
 
       if (queue->metadata[idx] & ANB_S_META_MASK) {
+          if (idx == queue->head_idx) { //deleted prefix grows, so FIFO pops stay O(1)
+              queue->head_idx = iter->_n_idx;
+              queue->head_off = iter->_n_off;
+          }
           continue; //item is deleted, skip
       }
 
@@ -142,6 +355,26 @@ uint8_t *ANB_slab_peek_item_iter(ANB_Slab_t* queue, ANB_SlabIter_t *iter, size_t
     }
 }
 
+// Rewind to an empty buffer once no item is live, then apply the trim policy
+static void ANB_s_reset(ANB_Slab_t* queue) {
+    size_t used = queue->write_pos;
+    size_t used_slots = queue->index_write;
+    if (queue->data_state & ANB_MEM_SECURE) ANB_secure_zero(queue->data, used);
+    queue->write_pos = 0;
+    queue->index_write = 0;
+    queue->head_idx = 0;
+    queue->head_off = 0;
+    queue->version++;
+
+    size_t data_target = ANB_trim_track(&queue->trim, &queue->data_trim, used, queue->size);
+    size_t index_target = ANB_trim_track(&queue->trim, &queue->index_trim, used_slots * sizeof(size_t),
+                                         queue->index_cap * sizeof(size_t)) / sizeof(size_t);
+    if (data_target || index_target) {
+        ANB_s_shrink(queue, data_target ? data_target : queue->size,
+                     index_target ? index_target : queue->index_cap, queue->trim.mode);
+    }
+}
+
 int ANB_slab_pop_item(ANB_Slab_t* queue, ANB_SlabIter_t *iter) {
     if (!queue) abort();
     if (queue->count == 0) {
@@ -157,16 +390,20 @@ int ANB_slab_pop_item(ANB_Slab_t* queue, ANB_SlabIter_t *iter) {
 
     queue->metadata[idx] = 0xF0; // Set high nibble - deleted
     queue->count--;
+    ANB_s_publish(queue);
     // If all data consumed, reset everything
-    if (queue->count == 0) {
-        queue->write_pos = 0;
-        queue->index_write = 0;
-        queue->version++;
-    }
+    if (queue->count == 0) ANB_s_reset(queue);
 
     return 0;
 }
 
+void ANB_slab_reset(ANB_Slab_t* queue) {
+    if (!queue) abort();
+    queue->count = 0;
+    ANB_s_publish(queue);
+    ANB_s_reset(queue);
+}
+
 int ANB_slab_securepop_item(ANB_Slab_t* queue, ANB_SlabIter_t *iter) {
     if (!queue) abort();
     if (queue->count == 0) {
@@ -185,9 +422,7 @@ int ANB_slab_securepop_item(ANB_Slab_t* queue, ANB_SlabIter_t *iter) {
         idx = temp_iter._idx;
     }
 
-    volatile uint8_t *p = (volatile uint8_t *)ptr;
-    size_t len = queue->index[idx];
-    while (len--) *p++ = 0;
+    ANB_secure_zero(ptr, queue->index[idx]);
 
     return ANB_slab_pop_item(queue, iter);
 }
@@ -212,3 +447,65 @@ uint8_t *ANB_slab_peek_item(ANB_Slab_t* queue, ANB_SlabIter_t *iter, size_t *out
     }
     return queue->data + iter->_off;
 }
+
+int ANB_slab_wait_nonempty(ANB_Slab_t* queue, int timeout_ms) {
+    if (!queue) abort();
+    if (atomic_load_explicit(&queue->ready, memory_order_acquire)) return 1;
+    if (timeout_ms == 0) return 0;
+
+    // Pairs with ANB_s_publish: a push that misses the flag stored its count before, so the check below sees it
+    atomic_store_explicit(&queue->watched, 1, memory_order_seq_cst);
+    struct timespec deadline, rel;
+    if (timeout_ms > 0) ANB_deadline_set(&deadline, timeout_ms);
+    for (;;) {
+        uint32_t seq = atomic_load_explicit(&queue->wake_seq, memory_order_acquire);
+        atomic_store_explicit(&queue->sleeping, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (atomic_load_explicit(&queue->ready, memory_order_acquire)) return 1;
+        if (timeout_ms > 0 && !ANB_deadline_left(&deadline, &rel)) return 0;
+
+        // A push that bumped wake_seq since the load makes this return at once
+        ANB_futex_wait(&queue->wake_seq, seq, timeout_ms > 0 ? &rel : NULL, 0);
+        if (atomic_load_explicit(&queue->ready, memory_order_acquire)) return 1;
+    }
+}
+
+int ANB_slab_event_fd(ANB_Slab_t* queue) {
+    if (!queue) abort();
+    int fd = atomic_load_explicit(&queue->event_fd, memory_order_acquire);
+    if (fd >= 0) return fd;
+#if defined(__linux__)
+    fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) return -1;
+    queue->event_wr = fd;
+#else
+    int ends[2];
+    if (pipe(ends) != 0) return -1;
+    for (int i = 0; i < 2; i++) {
+        fcntl(ends[i], F_SETFL, fcntl(ends[i], F_GETFL) | O_NONBLOCK);
+        fcntl(ends[i], F_SETFD, FD_CLOEXEC);
+    }
+    fd = ends[0];
+    queue->event_wr = ends[1];
+#endif
+    atomic_store_explicit(&queue->event_fd, fd, memory_order_release);
+    atomic_store_explicit(&queue->watched, 1, memory_order_seq_cst);
+    ANB_slab_event_ack(queue);
+    return fd;
+}
+
+void ANB_slab_event_ack(ANB_Slab_t* queue) {
+    if (!queue) abort();
+    int fd = atomic_load_explicit(&queue->event_fd, memory_order_acquire);
+    if (fd < 0) return;
+    uint64_t drain[8];
+    while (read(fd, drain, sizeof(drain)) > 0) {
+    }
+    atomic_store_explicit(&queue->armed, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    // Items pushed while the fd was disarmed, or left unpopped, make it readable again
+    if (atomic_load_explicit(&queue->ready, memory_order_acquire) &&
+        atomic_exchange_explicit(&queue->armed, 0, memory_order_relaxed)) {
+        ANB_s_event_write(queue);
+    }
+}
@@ -0,0 +1,288 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include <stdint.h>
+#include "vmem.h"
+#include "memflags.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#define ANB_VM_HAVE_MREMAP 1
+#else
+#define ANB_VM_HAVE_MREMAP 0
+#endif
+
+#define ANB_VM_HUGEPAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+// Creation flags that require an anonymous mapping
+#define ANB_VM_MAP_FLAGS (ANB_MEM_HUGEPAGE | ANB_MEM_PREFAULT | ANB_MEM_MLOCK | ANB_MEM_DONTDUMP)
+
+void ANB_secure_zero(void *ptr, size_t len) {
+    if (!len) return;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 25))
+    explicit_bzero(ptr, len);
+#elif defined(__STDC_LIB_EXT1__)
+    memset_s(ptr, len, 0, len);
+#elif defined(__GNUC__) || defined(__clang__)
+    memset(ptr, 0, len);
+    __asm__ __volatile__("" : : "r"(ptr) : "memory");
+#else
+    volatile uint8_t *p = (volatile uint8_t *)ptr;
+    while (len--) *p++ = 0;
+#endif
+}
+
+#if ANB_VM_HAVE_MREMAP
+static size_t ANB_vm_page_size(void) {
+    static size_t page;
+    if (!page) {
+        long p = sysconf(_SC_PAGESIZE);
+        page = p > 0 ? (size_t)p : 4096;
+    }
+    return page;
+}
+
+static size_t ANB_vm_align(unsigned state) {
+    return (state & ANB_MEM_HUGEPAGE) ? ANB_VM_HUGEPAGE_SIZE : ANB_vm_page_size();
+}
+
+static size_t ANB_vm_map_len(size_t size, unsigned state) {
+    size_t a = ANB_vm_align(state);
+    return (size + a - 1) & ~(a - 1);
+}
+
+// Map len bytes aligned to align; extra head/tail from over-allocation is trimmed
+static uint8_t *ANB_vm_map_aligned(size_t len, size_t align, int prot) {
+    size_t page = ANB_vm_page_size();
+    size_t extra = align > page ? align : 0;
+    uint8_t *p = (uint8_t *)mmap(NULL, len + extra, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == (uint8_t *)MAP_FAILED) return NULL;
+    if (extra) {
+        uint8_t *a = (uint8_t *)(((uintptr_t)p + align - 1) & ~(uintptr_t)(align - 1));
+        if (a > p) munmap(p, (size_t)(a - p));
+        if (extra - (size_t)(a - p)) munmap(a + len, extra - (size_t)(a - p));
+        p = a;
+    }
+    return p;
+}
+
+// Apply creation flags to the byte range [off, len) of a mapping
+static int ANB_vm_apply(uint8_t *p, size_t off, size_t len, unsigned state) {
+    if (off >= len) return 0;
+    if (state & ANB_MEM_HUGEPAGE) {
+        madvise(p, len, MADV_HUGEPAGE);
+    }
+#ifdef MADV_DONTDUMP
+    if (state & ANB_MEM_DONTDUMP) {
+        madvise(p + off, len - off, MADV_DONTDUMP);
+    }
+#endif
+    if (state & ANB_MEM_PREFAULT) {
+        int done = 0;
+#ifdef MADV_POPULATE_WRITE
+        done = madvise(p + off, len - off, MADV_POPULATE_WRITE) == 0;
+#endif
+        if (!done) {
+            // Fresh anonymous pages read as zero, so writing zero is harmless
+            size_t page = ANB_vm_page_size();
+            for (size_t i = off; i < len; i += page) ((volatile uint8_t *)p)[i] = 0;
+        }
+    }
+    if (state & ANB_MEM_MLOCK) {
+        if (mlock(p + off, len - off) != 0) return -1;
+    }
+    return 0;
+}
+
+static uint8_t *ANB_vm_map(size_t size, unsigned state) {
+    if (size > SIZE_MAX - ANB_vm_align(state)) return NULL;
+    size_t len = ANB_vm_map_len(size, state);
+    uint8_t *p = ANB_vm_map_aligned(len, ANB_vm_align(state), PROT_READ | PROT_WRITE);
+    if (!p) return NULL;
+    if (ANB_vm_apply(p, 0, len, state) != 0) {
+        munmap(p, len);
+        return NULL;
+    }
+    return p;
+}
+
+static uint8_t *ANB_vm_remap(uint8_t *ptr, size_t old_len, size_t new_len, unsigned state) {
+    if (!(state & ANB_MEM_HUGEPAGE) || new_len < old_len) {
+        void *p = mremap(ptr, old_len, new_len, MREMAP_MAYMOVE);
+        return p == MAP_FAILED ? NULL : (uint8_t *)p;
+    }
+    // Keep 2 MiB alignment: grow in place if possible, else move onto an aligned reservation
+    void *p = mremap(ptr, old_len, new_len, 0);
+    if (p != MAP_FAILED) return (uint8_t *)p;
+    uint8_t *dst = ANB_vm_map_aligned(new_len, ANB_VM_HUGEPAGE_SIZE, PROT_NONE);
+    if (!dst) return NULL;
+    p = mremap(ptr, old_len, new_len, MREMAP_MAYMOVE | MREMAP_FIXED, dst);
+    if (p == MAP_FAILED) {
+        munmap(dst, new_len);
+        return NULL;
+    }
+    return (uint8_t *)p;
+}
+#endif
+
+uint8_t *ANB_vmem_alloc(size_t size, unsigned *state) {
+    *state &= ~ANB_VMEM_MAPPED;
+#if ANB_VM_HAVE_MREMAP
+    if (size >= ANB_VMEM_MAP_THRESHOLD || (*state & ANB_VM_MAP_FLAGS)) {
+        uint8_t *p = ANB_vm_map(size, *state);
+        if (p) *state |= ANB_VMEM_MAPPED;
+        return p;
+    }
+#endif
+    return (uint8_t *)malloc(size);
+}
+
+uint8_t *ANB_vmem_map_file(int fd, size_t size, int random_access, unsigned *state) {
+    int readonly = (*state & ANB_VMEM_READONLY) != 0;
+    int prot = readonly ? PROT_READ : PROT_READ | PROT_WRITE;
+    int flags = readonly ? MAP_SHARED : MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (*state & ANB_MEM_PREFAULT) flags |= MAP_POPULATE;
+#endif
+    void *p = mmap(NULL, size, prot, flags, fd, 0);
+    if (p == MAP_FAILED) return NULL;
+    if (random_access) {
+        madvise(p, size, MADV_RANDOM);
+    } else {
+        // Read-ahead aggressively and start paging in now, in the background
+        madvise(p, size, MADV_SEQUENTIAL);
+        madvise(p, size, MADV_WILLNEED);
+    }
+    *state |= ANB_VMEM_FILE;
+    return (uint8_t *)p;
+}
+
+// Secure heap resize: allocate, copy, wipe, free, so no stale copy is left in freed memory
+static uint8_t *ANB_vm_secure_move(uint8_t *ptr, size_t old_size, size_t new_size, unsigned *state) {
+    unsigned st = *state;
+    uint8_t *p = ANB_vmem_alloc(new_size, &st);
+    if (!p) return NULL;
+    memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+    ANB_vmem_free(ptr, old_size, *state);
+    *state = st;
+    return p;
+}
+
+uint8_t *ANB_vmem_resize(uint8_t *ptr, size_t old_size, size_t new_size, unsigned *state) {
+    if (*state & ANB_VMEM_FILE) {
+        // A file view never changes size in place: copy what is kept to an owned buffer
+        unsigned st = *state & ~(ANB_VMEM_FILE | ANB_VMEM_READONLY);
+        uint8_t *p = ANB_vmem_alloc(new_size, &st);
+        if (!p) return NULL;
+        memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+        munmap(ptr, old_size);
+        *state = st;
+        return p;
+    }
+    if (*state & ANB_VMEM_EXTERNAL) {
+        // Caller storage cannot change size; growing moves to an owned buffer when allowed
+        if (!(*state & ANB_MEM_SPILL) || new_size <= old_size) return NULL;
+        unsigned st = *state & ~ANB_VMEM_EXTERNAL;
+        uint8_t *p = ANB_vmem_alloc(new_size, &st);
+        if (!p) return NULL;
+        memcpy(p, ptr, old_size);
+        if (*state & ANB_MEM_SECURE) ANB_secure_zero(ptr, old_size);
+        *state = st;
+        return p;
+    }
+    // A shrink discards the tail: wipe it first in secure mode
+    if ((*state & ANB_MEM_SECURE) && new_size < old_size) {
+        ANB_secure_zero(ptr + new_size, old_size - new_size);
+    }
+#if ANB_VM_HAVE_MREMAP
+    // mremap moves page table entries, so mapped buffers never leave a copy behind
+    if (*state & ANB_VMEM_MAPPED) {
+        if (new_size > SIZE_MAX - ANB_vm_align(*state)) return NULL;
+        size_t old_len = ANB_vm_map_len(old_size, *state);
+        size_t new_len = ANB_vm_map_len(new_size, *state);
+        // The rest of the last kept page survives the shrink; growing back must find zeros there
+        if (new_size < old_size && !(*state & ANB_MEM_SECURE)) {
+            memset(ptr + new_size, 0, (old_size < new_len ? old_size : new_len) - new_size);
+        }
+        if (old_len == new_len) return ptr;
+        uint8_t *p = ANB_vm_remap(ptr, old_len, new_len, *state);
+        if (!p) return NULL;
+        // The old pointer is gone once remapped, so a failed lock cannot be reported as NULL
+        if (ANB_vm_apply(p, old_len, new_len, *state) != 0) abort();
+        return p;
+    }
+    if (new_size >= ANB_VMEM_MAP_THRESHOLD) {
+        // Crossing the threshold: one last copy out of the heap
+        uint8_t *p = ANB_vm_map(new_size, *state);
+        if (!p) return NULL;
+        memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+        if (*state & ANB_MEM_SECURE) ANB_secure_zero(ptr, old_size);
+        free(ptr);
+        *state |= ANB_VMEM_MAPPED;
+        return p;
+    }
+#endif
+    if (*state & ANB_MEM_SECURE) return ANB_vm_secure_move(ptr, old_size, new_size, state);
+    return (uint8_t *)realloc(ptr, new_size);
+}
+
+void ANB_vmem_free(uint8_t *ptr, size_t size, unsigned state) {
+    if (!ptr) return;
+    if (state & ANB_MEM_SECURE) ANB_secure_zero(ptr, size);
+    if (state & ANB_VMEM_EXTERNAL) return;
+    if (state & ANB_VMEM_FILE) {
+        munmap(ptr, size);
+        return;
+    }
+#if ANB_VM_HAVE_MREMAP
+    if (state & ANB_VMEM_MAPPED) {
+        munmap(ptr, ANB_vm_map_len(size, state));
+        return;
+    }
+#else
+    (void)state;
+#endif
+    (void)size;
+    free(ptr);
+}
+
+int ANB_vmem_release_tail(uint8_t *ptr, size_t size, size_t keep, unsigned state) {
+#if ANB_VM_HAVE_MREMAP
+    if (!(state & ANB_VMEM_MAPPED)) return -1;
+    size_t from = ANB_vm_map_len(keep, state & ~ANB_MEM_HUGEPAGE);
+    size_t len = ANB_vm_map_len(size, state);
+    if (from >= len) return 0;
+#ifdef MADV_FREE
+    // MADV_FREE pages keep their contents until reclaimed; secure buffers discard immediately
+    if (!(state & ANB_MEM_SECURE) && madvise(ptr + from, len - from, MADV_FREE) == 0) return 0;
+#endif
+    return madvise(ptr + from, len - from, MADV_DONTNEED) == 0 ? 0 : -1;
+#else
+    (void)ptr;
+    (void)size;
+    (void)keep;
+    (void)state;
+    return -1;
+#endif
+}
+
+void ANB_vmem_zero(uint8_t *ptr, size_t len, unsigned state) {
+#if ANB_VM_HAVE_MREMAP
+    if (len >= ANB_VMEM_DISCARD_THRESHOLD && (state & ANB_VMEM_MAPPED) &&
+        !(state & (ANB_VMEM_FILE | ANB_MEM_PREFAULT | ANB_MEM_MLOCK))) {
+        // Whole pages (2 MiB ones for ANB_MEM_HUGEPAGE) go back to the kernel; the rest is written
+        size_t whole = len & ~(ANB_vm_align(state) - 1);
+        if (whole && madvise(ptr, whole, MADV_DONTNEED) == 0) {
+            memset(ptr + whole, 0, len - whole);
+            return;
+        }
+    }
+#else
+    (void)state;
+#endif
+    memset(ptr, 0, len);
+}
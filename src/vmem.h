@@ -0,0 +1,112 @@
+#pragma once
+/**
+ * @file vmem.h
+ * @brief Internal backing store for ANB_Slab and ANB_Blob buffers.
+ *
+ * Small buffers live on the malloc heap. Once a buffer reaches
+ * ANB_VMEM_MAP_THRESHOLD it moves to an anonymous private mapping, and
+ * every later resize goes through mremap(MREMAP_MAYMOVE), which moves page
+ * table entries instead of copying bytes. On platforms without mremap the
+ * heap path is used for all sizes.
+ *
+ * The owner keeps a state word next to each buffer pointer and passes it
+ * back on every call. Its low bits hold the ANB_MEM_* creation flags from
+ * memflags.h; any of them forces the mapped path regardless of size.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include "memflags.h"
+
+/** Buffers of at least this many bytes are backed by an anonymous mapping. */
+#define ANB_VMEM_MAP_THRESHOLD ((size_t)4 * 1024 * 1024)
+
+/** State bit: the buffer is an anonymous mapping rather than a heap block. */
+#define ANB_VMEM_MAPPED (1u << 16)
+
+/**
+ * State bit: the buffer is caller-provided storage (ANB_*_init_in). It is
+ * never freed, and a resize fails unless ANB_MEM_SPILL is set, in which case
+ * growth copies it to an owned buffer and clears this bit.
+ */
+#define ANB_VMEM_EXTERNAL (1u << 17)
+
+/**
+ * State bit: the buffer is a mapping of a file (ANB_blob_map_file), either
+ * shared read-only or private copy-on-write. Freeing unmaps it; any resize
+ * copies it to an owned buffer and clears this bit and ANB_VMEM_READONLY.
+ */
+#define ANB_VMEM_FILE (1u << 18)
+
+/** State bit: the buffer is mapped without PROT_WRITE and must be copied before any write. */
+#define ANB_VMEM_READONLY (1u << 19)
+
+/** True if the buffer is caller storage that may not spill, so a failed resize is reported, not fatal. */
+#define ANB_VMEM_IS_FIXED(state) (((state) & (ANB_VMEM_EXTERNAL | ANB_MEM_SPILL)) == ANB_VMEM_EXTERNAL)
+
+/**
+ * @brief Allocate an uninitialized buffer.
+ * @param size Size in bytes. Must be > 0.
+ * @param state In/out state word. Backing bits are set on success.
+ * @return The buffer, or NULL on allocation failure.
+ */
+uint8_t *ANB_vmem_alloc(size_t size, unsigned *state);
+
+/**
+ * @brief Map the first size bytes of a file.
+ * @param fd Open file descriptor; may be closed once this returns.
+ * @param size Bytes to map. Must be > 0.
+ * @param random_access Non-zero to madvise(MADV_RANDOM) instead of sequential read-ahead plus MADV_WILLNEED.
+ * @param state In/out state word. ANB_VMEM_READONLY selects a shared
+ *              read-only mapping, otherwise a private writable one;
+ *              ANB_MEM_PREFAULT populates it up front. ANB_VMEM_FILE is set
+ *              on success.
+ * @return The mapping, or NULL with errno set.
+ */
+uint8_t *ANB_vmem_map_file(int fd, size_t size, int random_access, unsigned *state);
+
+/**
+ * @brief Resize a buffer, preserving min(old_size, new_size) bytes.
+ * @param ptr Buffer from ANB_vmem_alloc / ANB_vmem_resize.
+ * @param old_size Current size in bytes.
+ * @param new_size New size in bytes. Must be > 0.
+ * @param state In/out state word for ptr.
+ * @return The (possibly moved) buffer, or NULL on failure, in which case
+ *         ptr and state are unchanged. External buffers always fail to
+ *         shrink and fail to grow unless they may spill.
+ * @note Aborts if ANB_MEM_MLOCK is set and the grown tail cannot be locked.
+ */
+uint8_t *ANB_vmem_resize(uint8_t *ptr, size_t old_size, size_t new_size, unsigned *state);
+
+/**
+ * @brief Release a buffer. Safe to pass NULL.
+ * @param ptr Buffer from ANB_vmem_alloc / ANB_vmem_resize.
+ * @param size Current size in bytes.
+ * @param state State word for ptr.
+ */
+void ANB_vmem_free(uint8_t *ptr, size_t size, unsigned state);
+
+/**
+ * @brief Hand the pages of [keep, size) back to the kernel without resizing.
+ * @param ptr Buffer from ANB_vmem_alloc / ANB_vmem_resize.
+ * @param size Current size in bytes.
+ * @param keep Leading bytes that must be preserved.
+ * @param state State word for ptr.
+ * @return 0 if released (contents of the tail become unspecified), -1 if the
+ *         buffer is not mapped or the kernel refused (e.g. locked pages).
+ */
+int ANB_vmem_release_tail(uint8_t *ptr, size_t size, size_t keep, unsigned state);
+
+/** Zeroing at least this many bytes of an anonymous mapping discards its pages instead of writing them. */
+#define ANB_VMEM_DISCARD_THRESHOLD ((size_t)1 * 1024 * 1024)
+
+/**
+ * @brief Zero the first len bytes of a buffer.
+ * @param ptr Buffer from ANB_vmem_alloc / ANB_vmem_resize.
+ * @param len Bytes to zero, at most the buffer size.
+ * @param state State word for ptr.
+ * @note Large ranges of anonymous mappings are dropped with MADV_DONTNEED, so
+ *       the kernel supplies zero pages on the next touch; only the partial
+ *       last page is written. Buffers with ANB_MEM_PREFAULT or ANB_MEM_MLOCK
+ *       keep their pages and are written instead.
+ */
+void ANB_vmem_zero(uint8_t *ptr, size_t len, unsigned state);
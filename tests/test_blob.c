@@ -1,7 +1,10 @@
 #include "unity.h"
 #include "blob.h"
+#include <errno.h>
+#include <stdio.h>
 #include <string.h>
 #include <stddef.h>
+#include <unistd.h>
 
 void setUp_blob(void) {}
 void tearDown_blob(void) {}
@@ -234,3 +237,709 @@ void test_push_multiple(void) {
 
     ANB_blob_destroy(b);
 }
+
+/* ------------------------------------------------------------------ */
+/* 14. Growth across the mapping threshold preserves contents         */
+/* ------------------------------------------------------------------ */
+void test_blob_large_growth(void) {
+    ANB_Blob_t *b = ANB_blob_create(4096);
+    uint8_t chunk[4096];
+
+    /* 12 MiB pushed in 4 KiB chunks crosses into mmap and grows via mremap */
+    for (size_t i = 0; i < 3072; i++) {
+        memset(chunk, (int)(i & 0xFF), sizeof(chunk));
+        ANB_blob_push(b, chunk, sizeof(chunk));
+    }
+    TEST_ASSERT_EQUAL_size_t(3072 * 4096, ANB_blob_data_len(b));
+
+    uint8_t *d = ANB_blob_data(b);
+    for (size_t i = 0; i < 3072; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i & 0xFF, d[i * 4096]);
+        TEST_ASSERT_EQUAL_UINT8(i & 0xFF, d[i * 4096 + 4095]);
+    }
+
+    /* Shrink keeps the prefix, grow again keeps it too */
+    ANB_blob_realloc(b, 8192);
+    ANB_blob_realloc(b, 64u << 20);
+    d = ANB_blob_data(b);
+    TEST_ASSERT_EQUAL_UINT8(0, d[0]);
+    TEST_ASSERT_EQUAL_UINT8(1, d[4096]);
+    TEST_ASSERT_EQUAL_UINT8(1, d[8191]);
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 15. Huge page blob stays 2 MiB aligned across growth               */
+/* ------------------------------------------------------------------ */
+void test_blob_create_ex_hugepage(void) {
+    ANB_Blob_t *b = ANB_blob_create_ex(1000, ANB_MEM_HUGEPAGE | ANB_MEM_PREFAULT);
+    TEST_ASSERT_EQUAL_size_t(1000, ANB_blob_capacity(b));
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)ANB_blob_data(b) & ((2u << 20) - 1));
+
+    uint8_t chunk[65536];
+    for (size_t i = 0; i < 80; i++) {
+        memset(chunk, (int)i, sizeof(chunk));
+        ANB_blob_push(b, chunk, sizeof(chunk));
+    }
+    uint8_t *d = ANB_blob_data(b);
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)d & ((2u << 20) - 1));
+    for (size_t i = 0; i < 80; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i, d[i * 65536]);
+    }
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 16. Locked blob is usable and grows                                */
+/* ------------------------------------------------------------------ */
+void test_blob_create_ex_mlock(void) {
+    ANB_Blob_t *b = ANB_blob_create_ex(64, ANB_MEM_MLOCK | ANB_MEM_PREFAULT);
+    uint8_t data[200];
+    memset(data, 0x3C, sizeof(data));
+
+    ANB_blob_push(b, data, sizeof(data));
+    TEST_ASSERT_EQUAL_size_t(200, ANB_blob_data_len(b));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, ANB_blob_data(b), 200);
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 17. Trim shrinks to data length, never below initial capacity      */
+/* ------------------------------------------------------------------ */
+void test_blob_trim(void) {
+    ANB_Blob_t *b = ANB_blob_create(32);
+    uint8_t data[1000];
+    memset(data, 0x11, sizeof(data));
+
+    ANB_blob_push(b, data, 1000);
+    TEST_ASSERT(ANB_blob_capacity(b) >= 1000);
+    ANB_blob_reset(b);
+    ANB_blob_push(b, data, 100);
+
+    ANB_blob_trim(b);
+    TEST_ASSERT_EQUAL_size_t(100, ANB_blob_capacity(b));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, ANB_blob_data(b), 100);
+
+    ANB_blob_reset(b);
+    ANB_blob_trim(b);
+    TEST_ASSERT_EQUAL_size_t(32, ANB_blob_capacity(b));
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 18. Automatic trim after N low-usage resets                        */
+/* ------------------------------------------------------------------ */
+void test_blob_auto_trim(void) {
+    ANB_Blob_t *b = ANB_blob_create(64);
+    ANB_TrimPolicy_t p = { 25, 3, ANB_TRIM_SHRINK };
+    ANB_blob_set_trim(b, &p);
+    uint8_t data[4096];
+    memset(data, 0x22, sizeof(data));
+
+    /* Spike */
+    ANB_blob_push(b, data, 4096);
+    ANB_blob_reset(b);
+    size_t peak_cap = ANB_blob_capacity(b);
+    TEST_ASSERT(peak_cap >= 4096);
+
+    /* Two low resets: not yet */
+    for (int i = 0; i < 2; i++) {
+        ANB_blob_push(b, data, 100 + i * 100);
+        ANB_blob_reset(b);
+    }
+    TEST_ASSERT_EQUAL_size_t(peak_cap, ANB_blob_capacity(b));
+
+    /* A high reset restarts the streak */
+    ANB_blob_push(b, data, 4000);
+    ANB_blob_reset(b);
+    for (int i = 0; i < 2; i++) {
+        ANB_blob_push(b, data, 100);
+        ANB_blob_reset(b);
+    }
+    TEST_ASSERT_EQUAL_size_t(peak_cap, ANB_blob_capacity(b));
+
+    /* Third consecutive low reset trims to the largest usage in the streak */
+    ANB_blob_push(b, data, 300);
+    ANB_blob_reset(b);
+    TEST_ASSERT_EQUAL_size_t(300, ANB_blob_capacity(b));
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 19. Release mode keeps capacity of mapped buffers                  */
+/* ------------------------------------------------------------------ */
+void test_blob_auto_trim_release(void) {
+    ANB_Blob_t *b = ANB_blob_create(64);
+    ANB_blob_realloc(b, 8u << 20);
+    ANB_TrimPolicy_t p = { 10, 1, ANB_TRIM_RELEASE };
+    ANB_blob_set_trim(b, &p);
+
+    memset(ANB_blob_data(b), 0x44, 8u << 20);
+    ANB_blob_push(b, (const uint8_t *)"keep", 4);
+    ANB_blob_reset(b);
+
+    TEST_ASSERT_EQUAL_size_t(8u << 20, ANB_blob_capacity(b));
+    TEST_ASSERT_EQUAL_STRING_LEN("keep", (const char *)ANB_blob_data(b), 4);
+
+    /* The released tail is still usable */
+    uint8_t *d = ANB_blob_data(b);
+    d[(8u << 20) - 1] = 0x55;
+    TEST_ASSERT_EQUAL_UINT8(0x55, d[(8u << 20) - 1]);
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 20. Secure blob wipes on reset and keeps data across growth        */
+/* ------------------------------------------------------------------ */
+void test_blob_secure(void) {
+    ANB_Blob_t *b = ANB_blob_create_ex(16, ANB_MEM_SECURE | ANB_MEM_DONTDUMP);
+    uint8_t secret[100];
+    memset(secret, 0xEE, sizeof(secret));
+
+    ANB_blob_push(b, secret, 10);
+    ANB_blob_push(b, secret, 90);   /* grows by allocate-copy-wipe-free */
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(secret, ANB_blob_data(b), 100);
+
+    uint8_t *d = ANB_blob_data(b);
+    ANB_blob_reset(b);
+    for (size_t i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, d[i]);
+    }
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 21. Secure zero wipes                                              */
+/* ------------------------------------------------------------------ */
+void test_secure_zero(void) {
+    uint8_t buf[257];
+    memset(buf, 0xFF, sizeof(buf));
+    ANB_secure_zero(buf + 1, 255);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, buf[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, buf[256]);
+    for (size_t i = 1; i < 256; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, buf[i]);
+    }
+    ANB_secure_zero(NULL, 0);
+}
+
+/* ------------------------------------------------------------------ */
+/* 22. Blob in caller storage fails when full                         */
+/* ------------------------------------------------------------------ */
+void test_blob_init_in(void) {
+    uint8_t buf[256];
+    TEST_ASSERT_NULL(ANB_blob_init_in(buf, 8, 0));
+    TEST_ASSERT_NULL(ANB_blob_init_in(buf, sizeof(buf), ANB_MEM_HUGEPAGE));
+
+    ANB_Blob_t *b = ANB_blob_init_in(buf + 1, sizeof(buf) - 1, 0);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_TRUE((uint8_t *)b >= buf && (uint8_t *)b < buf + sizeof(buf));
+    TEST_ASSERT_TRUE(ANB_blob_data(b) > (uint8_t *)b && ANB_blob_data(b) < buf + sizeof(buf));
+
+    size_t cap = ANB_blob_capacity(b);
+    uint8_t chunk[16];
+    memset(chunk, 0x5A, sizeof(chunk));
+    size_t pushed = 0;
+    while (ANB_blob_push(b, chunk, sizeof(chunk)) == 0) pushed += sizeof(chunk);
+    TEST_ASSERT_TRUE(pushed + sizeof(chunk) > cap);
+    TEST_ASSERT_EQUAL_size_t(pushed, ANB_blob_data_len(b));
+    TEST_ASSERT_EQUAL_INT(-1, ANB_blob_alloc(b, 0));
+    TEST_ASSERT_EQUAL_INT(-1, ANB_blob_realloc(b, cap + 1));
+    TEST_ASSERT_EQUAL_size_t(cap, ANB_blob_capacity(b));
+
+    ANB_blob_trim(b);
+    TEST_ASSERT_EQUAL_size_t(cap, ANB_blob_capacity(b));
+    ANB_blob_reset(b);
+
+    /* Resizing within the storage never fails */
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_realloc(b, cap / 2));
+    TEST_ASSERT_EQUAL_size_t(cap / 2, ANB_blob_capacity(b));
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_realloc(b, cap));
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_push(b, chunk, sizeof(chunk)));
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 23. Blob in caller storage spills to the heap                      */
+/* ------------------------------------------------------------------ */
+void test_blob_init_in_spill(void) {
+    uint8_t buf[256];
+    ANB_Blob_t *b = ANB_blob_init_in(buf, sizeof(buf), ANB_MEM_SPILL | ANB_MEM_SECURE);
+    TEST_ASSERT_NOT_NULL(b);
+    uint8_t *inline_data = ANB_blob_data(b);
+
+    uint8_t src[1000];
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)i;
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_push(b, src, 10));
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_push(b, src + 10, sizeof(src) - 10));
+    TEST_ASSERT_TRUE(ANB_blob_data(b) != inline_data);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src, ANB_blob_data(b), sizeof(src));
+    /* Secure spill wipes what it left behind */
+    for (size_t i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, inline_data[i]);
+    }
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 24. Small blobs live inline until they outgrow it                  */
+/* ------------------------------------------------------------------ */
+void test_blob_inline(void) {
+    ANB_Blob_t *b = ANB_blob_create(32);
+    uint8_t *d = ANB_blob_data(b);
+    TEST_ASSERT_TRUE(d > (uint8_t *)b && d < (uint8_t *)b + 512);
+    TEST_ASSERT_EQUAL_size_t(0, (uintptr_t)d % _Alignof(max_align_t));
+
+    uint8_t src[ANB_BLOB_INLINE_SIZE + 1];
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)(i * 7);
+
+    /* Growing within the inline buffer keeps the data in place */
+    ANB_blob_push(b, src, ANB_BLOB_INLINE_SIZE);
+    TEST_ASSERT_EQUAL_PTR(d, ANB_blob_data(b));
+    TEST_ASSERT_TRUE(ANB_blob_capacity(b) <= ANB_BLOB_INLINE_SIZE);
+
+    /* One more byte spills to the heap with the contents intact */
+    ANB_blob_push(b, src + ANB_BLOB_INLINE_SIZE, 1);
+    TEST_ASSERT_TRUE(ANB_blob_data(b) != d);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src, ANB_blob_data(b), sizeof(src));
+
+    ANB_blob_trim(b);
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), ANB_blob_capacity(b));
+    ANB_blob_destroy(b);
+
+    /* Mapping flags bypass the inline buffer */
+    b = ANB_blob_create_ex(32, ANB_MEM_PREFAULT);
+    d = ANB_blob_data(b);
+    TEST_ASSERT_TRUE(d < (uint8_t *)b || d > (uint8_t *)b + 512);
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 25. Compact create: handle and buffer in one block                 */
+/* ------------------------------------------------------------------ */
+void test_blob_create_compact(void) {
+    ANB_Blob_t *b = ANB_blob_create_compact(4096);
+    uint8_t *d = ANB_blob_data(b);
+    TEST_ASSERT_EQUAL_size_t(4096, ANB_blob_capacity(b));
+    TEST_ASSERT_TRUE(d > (uint8_t *)b && d < (uint8_t *)b + 512);
+
+    uint8_t src[6000];
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)i;
+    ANB_blob_push(b, src, 4096);
+    TEST_ASSERT_EQUAL_PTR(d, ANB_blob_data(b));
+    ANB_blob_push(b, src + 4096, sizeof(src) - 4096);
+    TEST_ASSERT_TRUE(ANB_blob_data(b) != d);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src, ANB_blob_data(b), sizeof(src));
+    ANB_blob_destroy(b);
+
+    b = ANB_blob_create_compact(16);
+    TEST_ASSERT_EQUAL_size_t(16, ANB_blob_capacity(b));
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 26. Reserve / commit writes in place                               */
+/* ------------------------------------------------------------------ */
+void test_blob_reserve_commit(void) {
+    ANB_Blob_t *b = ANB_blob_create(16);
+    ANB_blob_push(b, (const uint8_t *)"head", 4);
+
+    size_t avail = 0;
+    uint8_t *w = ANB_blob_reserve(b, 0, &avail);
+    TEST_ASSERT_EQUAL_PTR(ANB_blob_data(b) + 4, w);
+    TEST_ASSERT_EQUAL_size_t(12, avail);
+
+    /* Growing keeps what was pushed and exposes the whole tail */
+    w = ANB_blob_reserve(b, 100, &avail);
+    TEST_ASSERT_NOT_NULL(w);
+    TEST_ASSERT_TRUE(avail >= 100);
+    TEST_ASSERT_EQUAL_size_t(avail, ANB_blob_capacity(b) - 4);
+    TEST_ASSERT_EQUAL_MEMORY("head", ANB_blob_data(b), 4);
+    TEST_ASSERT_EQUAL_size_t(4, ANB_blob_data_len(b));
+
+    memset(w, 'x', 60);
+    ANB_blob_commit(b, 60);
+    TEST_ASSERT_EQUAL_size_t(64, ANB_blob_data_len(b));
+    TEST_ASSERT_EQUAL_UINT8('x', ANB_blob_data(b)[63]);
+
+    /* Push continues after committed bytes */
+    ANB_blob_push(b, (const uint8_t *)"!", 1);
+    TEST_ASSERT_EQUAL_UINT8('!', ANB_blob_data(b)[64]);
+    ANB_blob_commit(b, 0);
+    TEST_ASSERT_EQUAL_size_t(65, ANB_blob_data_len(b));
+    ANB_blob_destroy(b);
+
+    /* Full caller storage reports NULL */
+    uint8_t buf[512];
+    b = ANB_blob_init_in(buf, sizeof(buf), 0);
+    size_t cap = ANB_blob_capacity(b);
+    TEST_ASSERT_NOT_NULL(ANB_blob_reserve(b, cap, NULL));
+    ANB_blob_commit(b, cap);
+    TEST_ASSERT_NULL(ANB_blob_reserve(b, 1, &avail));
+    TEST_ASSERT_NOT_NULL(ANB_blob_reserve(b, 0, &avail));
+    TEST_ASSERT_EQUAL_size_t(0, avail);
+}
+
+/* ------------------------------------------------------------------ */
+/* 27. Read cursor: peek / consume / compact                          */
+/* ------------------------------------------------------------------ */
+void test_blob_consume(void) {
+    ANB_Blob_t *b = ANB_blob_create(100);
+    ANB_blob_push(b, (const uint8_t *)"0123456789", 10);
+
+    size_t len;
+    uint8_t *p = ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(10, len);
+    TEST_ASSERT_EQUAL_MEMORY("0123", p, 4);
+
+    ANB_blob_consume(b, 4);
+    p = ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(6, len);
+    TEST_ASSERT_EQUAL_MEMORY("456789", p, 6);
+    TEST_ASSERT_EQUAL_size_t(10, ANB_blob_data_len(b));
+
+    /* Explicit compaction moves the unread bytes to the front */
+    ANB_blob_compact(b);
+    TEST_ASSERT_EQUAL_size_t(6, ANB_blob_data_len(b));
+    TEST_ASSERT_EQUAL_MEMORY("456789", ANB_blob_data(b), 6);
+
+    /* Consuming everything rewinds without a copy */
+    ANB_blob_consume(b, 6);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_data_len(b));
+    ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(0, len);
+    ANB_blob_consume(b, 0);
+
+    /* Passing the threshold (50% of 100) compacts automatically */
+    uint8_t chunk[30];
+    memset(chunk, 'a', sizeof(chunk));
+    ANB_blob_push(b, chunk, 30);
+    ANB_blob_push(b, chunk, 30);
+    ANB_blob_consume(b, 40);
+    TEST_ASSERT_EQUAL_size_t(60, ANB_blob_data_len(b));
+    ANB_blob_consume(b, 10);
+    TEST_ASSERT_EQUAL_size_t(10, ANB_blob_data_len(b));
+    TEST_ASSERT_EQUAL_PTR(ANB_blob_data(b), ANB_blob_peek(b, &len));
+    TEST_ASSERT_EQUAL_size_t(10, len);
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 28. Pushes reclaim the consumed prefix before growing              */
+/* ------------------------------------------------------------------ */
+void test_blob_consume_reclaims(void) {
+    ANB_Blob_t *b = ANB_blob_create(64);
+    uint8_t frame[20];
+    memset(frame, 0xFF, sizeof(frame));
+    ANB_blob_push(b, frame, sizeof(frame));
+    for (int round = 0; round < 100; round++) {
+        /* Steady stream: one frame in, one frame out, one always pending */
+        memset(frame, round, sizeof(frame));
+        ANB_blob_push(b, frame, sizeof(frame));
+        size_t len;
+        uint8_t *p = ANB_blob_peek(b, &len);
+        TEST_ASSERT_EQUAL_size_t(2 * sizeof(frame), len);
+        TEST_ASSERT_EQUAL_UINT8((uint8_t)round, p[len - 1]);
+        ANB_blob_consume(b, sizeof(frame));
+    }
+    TEST_ASSERT_EQUAL_size_t(64, ANB_blob_capacity(b));
+
+    /* With compaction off the buffer grows instead */
+    ANB_blob_set_compact(b, 0);
+    for (int i = 0; i < 10; i++) {
+        ANB_blob_push(b, frame, sizeof(frame));
+        ANB_blob_consume(b, 1);
+    }
+    TEST_ASSERT_TRUE(ANB_blob_capacity(b) > 64);
+    ANB_blob_destroy(b);
+
+    /* Secure blobs wipe the bytes left behind by a compaction */
+    b = ANB_blob_create_ex(64, ANB_MEM_SECURE);
+    ANB_blob_push(b, (const uint8_t *)"secretpayload", 13);
+    ANB_blob_consume(b, 6);
+    ANB_blob_compact(b);
+    uint8_t *d = ANB_blob_data(b);
+    TEST_ASSERT_EQUAL_MEMORY("payload", d, 7);
+    for (size_t i = 7; i < 13; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, d[i]);
+    }
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 29. File view: read in place, copy on the first write              */
+/* ------------------------------------------------------------------ */
+static void blob_write_file(const char *path, const uint8_t *bytes, size_t len) {
+    FILE *f = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL_size_t(len, fwrite(bytes, 1, len, f));
+    fclose(f);
+}
+
+void test_blob_map_file(void) {
+    char path[] = "/tmp/anb_map_XXXXXX";
+    close(mkstemp(path));
+    static uint8_t src[3 * 4096 + 100];
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)(i * 31);
+    blob_write_file(path, src, sizeof(src));
+
+    ANB_Blob_t *b = ANB_blob_map_file(path, 0);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), ANB_blob_data_len(b));
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), ANB_blob_capacity(b));
+    uint8_t *view = ANB_blob_data(b);
+    TEST_ASSERT_EQUAL_MEMORY(src, view, sizeof(src));
+
+    /* Parsing the view never copies, even past the compaction threshold */
+    ANB_blob_consume(b, sizeof(src) - 10);
+    size_t len;
+    uint8_t *p = ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(10, len);
+    TEST_ASSERT_EQUAL_PTR(view + sizeof(src) - 10, p);
+
+    /* The first push moves to an owned buffer; the file is untouched */
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_push(b, (const uint8_t *)"tail", 4));
+    TEST_ASSERT_TRUE(ANB_blob_data(b) != view);
+    p = ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(14, len);
+    TEST_ASSERT_EQUAL_MEMORY(src + sizeof(src) - 10, p, 10);
+    TEST_ASSERT_EQUAL_MEMORY("tail", p + 10, 4);
+    ANB_blob_destroy(b);
+
+    /* Reset then push: a write inside the view also copies first */
+    b = ANB_blob_map_file(path, ANB_BLOB_MAP_RANDOM);
+    ANB_blob_reset(b);
+    ANB_blob_push(b, (const uint8_t *)"XY", 2);
+    TEST_ASSERT_EQUAL_MEMORY("XY", ANB_blob_data(b), 2);
+    TEST_ASSERT_EQUAL_MEMORY(src + 2, ANB_blob_data(b) + 2, 100);
+    ANB_blob_destroy(b);
+
+    /* Clear drops the view for zeroed memory of the same size; the file is untouched */
+    b = ANB_blob_map_file(path, 0);
+    view = ANB_blob_data(b);
+    ANB_blob_clear(b);
+    TEST_ASSERT_TRUE(ANB_blob_data(b) != view);
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), ANB_blob_capacity(b));
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_data_len(b));
+    for (size_t i = 0; i < sizeof(src); i++) TEST_ASSERT_EQUAL_UINT8(0, ANB_blob_data(b)[i]);
+    ANB_blob_push(b, (const uint8_t *)"XY", 2);
+    TEST_ASSERT_EQUAL_MEMORY("XY", ANB_blob_data(b), 2);
+    ANB_blob_destroy(b);
+
+    /* A private view is writable in place without reaching the file */
+    b = ANB_blob_map_file(path, ANB_BLOB_MAP_PRIVATE | ANB_MEM_PREFAULT);
+    view = ANB_blob_data(b);
+    view[0] = (uint8_t)~src[0];
+    ANB_blob_destroy(b);
+    b = ANB_blob_map_file(path, 0);
+    TEST_ASSERT_EQUAL_MEMORY(src, ANB_blob_data(b), sizeof(src));
+    ANB_blob_destroy(b);
+
+    unlink(path);
+}
+
+/* ------------------------------------------------------------------ */
+/* 30. File view errors and the empty file                            */
+/* ------------------------------------------------------------------ */
+void test_blob_map_file_errors(void) {
+    errno = 0;
+    TEST_ASSERT_NULL(ANB_blob_map_file("/nonexistent/anb", 0));
+    TEST_ASSERT_EQUAL_INT(ENOENT, errno);
+    TEST_ASSERT_NULL(ANB_blob_map_file("/tmp", 0));
+    TEST_ASSERT_EQUAL_INT(EINVAL, errno);
+
+    char path[] = "/tmp/anb_map_XXXXXX";
+    close(mkstemp(path));
+    TEST_ASSERT_NULL(ANB_blob_map_file(path, ANB_MEM_SECURE));
+    TEST_ASSERT_EQUAL_INT(EINVAL, errno);
+
+    ANB_Blob_t *b = ANB_blob_map_file(path, 0);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_data_len(b));
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_push(b, (const uint8_t *)"ok", 2));
+    ANB_blob_destroy(b);
+    unlink(path);
+}
+
+/* ------------------------------------------------------------------ */
+/* 31. find_byte / find_any: offsets are relative to the read cursor  */
+/* ------------------------------------------------------------------ */
+void test_blob_find_byte_any(void) {
+    ANB_Blob_t *b = ANB_blob_create(64);
+    const char *msg = "skip:GET / HTTP/1.1\r\nHost: x\r\n\r\nbody";
+    ANB_blob_push(b, (const uint8_t *)msg, strlen(msg));
+    ANB_blob_consume(b, 5);
+
+    TEST_ASSERT_EQUAL_size_t(3, ANB_blob_find_byte(b, 0, ' '));
+    TEST_ASSERT_EQUAL_size_t(5, ANB_blob_find_byte(b, 4, ' '));
+    TEST_ASSERT_EQUAL_size_t(ANB_BLOB_NPOS, ANB_blob_find_byte(b, 0, '#'));
+    TEST_ASSERT_EQUAL_size_t(ANB_BLOB_NPOS, ANB_blob_find_byte(b, 1000, 'G'));
+
+    const uint8_t crlf[2] = {'\r', '\n'};
+    TEST_ASSERT_EQUAL_size_t(14, ANB_blob_find_any(b, 0, crlf, 2));
+    TEST_ASSERT_EQUAL_size_t(15, ANB_blob_find_any(b, 15, crlf, 2));
+    TEST_ASSERT_EQUAL_size_t(ANB_BLOB_NPOS, ANB_blob_find_any(b, 0, crlf, 0));
+    size_t len;
+    ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(ANB_BLOB_NPOS, ANB_blob_find_any(b, len, crlf, 2));
+
+    /* Sets beyond the vector limit use the table path */
+    const uint8_t many[10] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    TEST_ASSERT_EQUAL_size_t(11, ANB_blob_find_any(b, 0, many, 10));
+    TEST_ASSERT_EQUAL_size_t(11, ANB_blob_find_any(b, 0, many + 1, 8));
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 32. find: pattern search incl. empty, overlong and tail matches    */
+/* ------------------------------------------------------------------ */
+void test_blob_find_pattern(void) {
+    ANB_Blob_t *b = ANB_blob_create(64);
+    const char *msg = "GET / HTTP/1.1\r\nHost: x\r\n\r\nbody\r\n\r\n";
+    ANB_blob_push(b, (const uint8_t *)msg, strlen(msg));
+    const uint8_t *end = (const uint8_t *)"\r\n\r\n";
+
+    TEST_ASSERT_EQUAL_size_t(23, ANB_blob_find(b, 0, end, 4));
+    TEST_ASSERT_EQUAL_size_t(31, ANB_blob_find(b, 24, end, 4));
+    TEST_ASSERT_EQUAL_size_t(ANB_BLOB_NPOS, ANB_blob_find(b, 32, end, 4));
+    TEST_ASSERT_EQUAL_size_t(7, ANB_blob_find(b, 7, end, 0));
+    TEST_ASSERT_EQUAL_size_t(ANB_BLOB_NPOS, ANB_blob_find(b, 100, end, 0));
+    TEST_ASSERT_EQUAL_size_t(6, ANB_blob_find(b, 0, (const uint8_t *)"HTTP", 4));
+    TEST_ASSERT_EQUAL_size_t(ANB_BLOB_NPOS, ANB_blob_find(b, 0, (const uint8_t *)"HTTPS", 5));
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_find(b, 0, (const uint8_t *)msg, strlen(msg)));
+    TEST_ASSERT_EQUAL_size_t(ANB_BLOB_NPOS, ANB_blob_find(b, 1, (const uint8_t *)msg, strlen(msg)));
+    TEST_ASSERT_EQUAL_size_t(2, ANB_blob_find(b, 0, (const uint8_t *)"T", 1));
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 33. find functions agree with a byte loop across vector boundaries */
+/* ------------------------------------------------------------------ */
+static size_t find_reference(const uint8_t *h, size_t n, size_t off, const uint8_t *p, size_t m) {
+    for (size_t i = off; i + m <= n; i++) {
+        if (memcmp(h + i, p, m) == 0) return i;
+    }
+    return ANB_BLOB_NPOS;
+}
+
+void test_blob_find_random(void) {
+    uint8_t hay[300];
+    uint64_t rng = 7;
+    for (size_t i = 0; i < sizeof(hay); i++) {
+        rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        hay[i] = (uint8_t)('a' + (rng >> 33) % 3);      /* small alphabet: many partial matches */
+    }
+    ANB_Blob_t *b = ANB_blob_create(sizeof(hay));
+    for (size_t n = 0; n <= sizeof(hay); n += 7) {
+        ANB_blob_reset(b);
+        ANB_blob_push(b, hay, n);
+        for (size_t off = 0; off <= n; off += 5) {
+            for (size_t m = 1; m <= 40; m += 3) {
+                size_t start = (off * 13 + m) % sizeof(hay);
+                const uint8_t *pat = start + m <= sizeof(hay) ? hay + start : hay;
+                TEST_ASSERT_EQUAL_size_t(find_reference(hay, n, off, pat, m), ANB_blob_find(b, off, pat, m));
+            }
+            const uint8_t set[3] = {'c', 'x', 'y'};
+            TEST_ASSERT_EQUAL_size_t(find_reference(hay, n, off, set, 1), ANB_blob_find_any(b, off, set, 3));
+            TEST_ASSERT_EQUAL_size_t(find_reference(hay, n, off, set, 1), ANB_blob_find_byte(b, off, 'c'));
+        }
+    }
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 34. clear zeroes everything ever written, across moves and growth  */
+/* ------------------------------------------------------------------ */
+static int blob_all_zero(ANB_Blob_t *b) {
+    const uint8_t *d = ANB_blob_data(b);
+    for (size_t i = 0; i < ANB_blob_capacity(b); i++) {
+        if (d[i]) return 0;
+    }
+    return 1;
+}
+
+void test_blob_clear_dirty(void) {
+    static const size_t sizes[] = {64, 4096, (size_t)8 * 1024 * 1024};
+    uint8_t ff[5000];
+    memset(ff, 0xFF, sizeof(ff));
+    for (int s = 0; s < 3; s++) {
+        ANB_Blob_t *b = ANB_blob_create(sizes[s]);
+        // A fresh heap buffer is not zero yet; the first clear covers it
+        ANB_blob_clear(b);
+        TEST_ASSERT_TRUE(blob_all_zero(b));
+
+        // Written bytes past the current write position still count
+        ANB_blob_push(b, ff, 3000);
+        ANB_blob_reset(b);
+        ANB_blob_push(b, ff, 10);
+        ANB_blob_clear(b);
+        TEST_ASSERT_TRUE(blob_all_zero(b));
+
+        // Compaction moves the write position back; commit is tracked like push
+        ANB_blob_push(b, ff, 2000);
+        ANB_blob_consume(b, 1500);
+        ANB_blob_compact(b);
+        size_t avail;
+        uint8_t *tail = ANB_blob_reserve(b, 100, &avail);
+        memset(tail, 0xFF, 100);
+        ANB_blob_commit(b, 100);
+        ANB_blob_clear(b);
+        TEST_ASSERT_TRUE(blob_all_zero(b));
+
+        // Growth (realloc, or the move into a mapping) and a shrink in between
+        for (int i = 0; i < 3; i++) ANB_blob_push(b, ff, sizeof(ff));
+        ANB_blob_realloc(b, ANB_blob_capacity(b) / 2 + 1);
+        ANB_blob_realloc(b, ANB_blob_capacity(b) * 3);
+        ANB_blob_clear(b);
+        TEST_ASSERT_TRUE(blob_all_zero(b));
+
+        // Large mapped range: discarded pages read back as zero, the blob keeps working
+        if (sizes[s] >= 4096) {
+            size_t big = (size_t)6 * 1024 * 1024 + 123;
+            ANB_blob_realloc(b, big + 1000);
+            tail = ANB_blob_reserve(b, big, NULL);
+            memset(tail, 0xAB, big);
+            ANB_blob_commit(b, big);
+            ANB_blob_clear(b);
+            TEST_ASSERT_TRUE(blob_all_zero(b));
+            ANB_blob_push(b, ff, 10);
+            TEST_ASSERT_EQUAL_UINT8(0xFF, ANB_blob_data(b)[9]);
+            TEST_ASSERT_EQUAL_UINT8(0, ANB_blob_data(b)[10]);
+        }
+        ANB_blob_destroy(b);
+    }
+
+    // Shrinking a mapping keeps the rest of its last page (or huge page); growing back must not expose it
+    static const unsigned shrink_flags[] = {0, ANB_MEM_HUGEPAGE};
+    for (int f = 0; f < 2; f++) {
+        size_t big = (size_t)8 * 1024 * 1024;
+        ANB_Blob_t *b = ANB_blob_create_ex(big, shrink_flags[f]);
+        uint8_t *tail = ANB_blob_reserve(b, big, NULL);
+        memset(tail, 0xFF, big);
+        ANB_blob_commit(b, big);
+        ANB_blob_reset(b);
+        ANB_blob_realloc(b, big - 100);
+        ANB_blob_realloc(b, big);
+        ANB_blob_clear(b);
+        TEST_ASSERT_TRUE(blob_all_zero(b));
+        ANB_blob_destroy(b);
+    }
+
+    // Caller storage starts out with whatever the caller left in it
+    _Alignas(max_align_t) uint8_t buf[1024];
+    memset(buf, 0x5A, sizeof(buf));
+    ANB_Blob_t *b = ANB_blob_init_in(buf, sizeof(buf), 0);
+    ANB_blob_clear(b);
+    TEST_ASSERT_TRUE(blob_all_zero(b));
+}
@@ -0,0 +1,233 @@
+#include "unity.h"
+#include "blob_codec.h"
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/* 1. Fixed-width fields land in the requested byte order             */
+/* ------------------------------------------------------------------ */
+void test_codec_fixed_width(void) {
+    ANB_Blob_t *b = ANB_blob_create(8);
+    ANB_BlobWriter_t w;
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_writer_begin(&w, b, 64));
+    ANB_blob_put_u8(&w, 0xAB);
+    ANB_blob_put_u16le(&w, 0x0102);
+    ANB_blob_put_u16be(&w, 0x0102);
+    ANB_blob_put_u32le(&w, 0x01020304);
+    ANB_blob_put_u32be(&w, 0x01020304);
+    ANB_blob_put_u64le(&w, 0x0102030405060708ULL);
+    ANB_blob_put_u64be(&w, 0x0102030405060708ULL);
+    ANB_blob_put_f32le(&w, 1.5f);
+    ANB_blob_put_f64be(&w, -2.25);
+    TEST_ASSERT_EQUAL_size_t(41, ANB_blob_writer_end(&w));
+    TEST_ASSERT_EQUAL_size_t(41, ANB_blob_data_len(b));
+
+    static const uint8_t expect[31] = {
+        0xAB, 0x02, 0x01, 0x01, 0x02, 0x04, 0x03, 0x02, 0x01, 0x01, 0x02, 0x03, 0x04,
+        0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        0x00, 0x00,
+    };
+    TEST_ASSERT_EQUAL_MEMORY(expect, ANB_blob_data(b), sizeof(expect));
+    static const uint8_t f64be[8] = {0xC0, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    TEST_ASSERT_EQUAL_MEMORY(f64be, ANB_blob_data(b) + 33, 8);
+
+    ANB_BlobReader_t r;
+    ANB_blob_reader_begin(&r, b);
+    TEST_ASSERT_TRUE(ANB_blob_reader_need(&r, 41));
+    TEST_ASSERT_EQUAL_HEX8(0xAB, ANB_blob_get_u8(&r));
+    TEST_ASSERT_EQUAL_HEX32(0x0102, ANB_blob_get_u16le(&r));
+    TEST_ASSERT_EQUAL_HEX32(0x0102, ANB_blob_get_u16be(&r));
+    TEST_ASSERT_EQUAL_HEX32(0x01020304, ANB_blob_get_u32le(&r));
+    TEST_ASSERT_EQUAL_HEX32(0x01020304, ANB_blob_get_u32be(&r));
+    TEST_ASSERT_TRUE(ANB_blob_get_u64le(&r) == 0x0102030405060708ULL);
+    TEST_ASSERT_TRUE(ANB_blob_get_u64be(&r) == 0x0102030405060708ULL);
+    TEST_ASSERT_TRUE(ANB_blob_get_f32le(&r) == 1.5f);
+    TEST_ASSERT_TRUE(ANB_blob_get_f64be(&r) == -2.25);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_reader_left(&r));
+    TEST_ASSERT_EQUAL_INT(41, (int)ANB_blob_reader_end(&r));
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_data_len(b));
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Varints, zigzag and length-prefixed strings round-trip          */
+/* ------------------------------------------------------------------ */
+void test_codec_varint(void) {
+    static const uint64_t u[] = {0, 1, 127, 128, 300, 16383, 16384, 0xFFFFFFFFULL, UINT64_MAX};
+    static const int64_t s[] = {0, -1, 1, -64, 64, INT64_MIN, INT64_MAX};
+    size_t nu = sizeof(u) / sizeof(u[0]), ns = sizeof(s) / sizeof(s[0]);
+
+    ANB_Blob_t *b = ANB_blob_create(16);
+    ANB_BlobWriter_t w;
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_writer_begin(&w, b, (nu + ns + 1) * ANB_CODEC_VARINT_MAX + 5));
+    for (size_t i = 0; i < nu; i++) ANB_blob_put_varint(&w, u[i]);
+    for (size_t i = 0; i < ns; i++) ANB_blob_put_svarint(&w, s[i]);
+    ANB_blob_put_lpbytes(&w, "hello", 5);
+    ANB_blob_writer_end(&w);
+
+    /* Known encodings: 300 = AC 02, -1 zigzags to 1 */
+    const uint8_t *d = ANB_blob_data(b);
+    TEST_ASSERT_EQUAL_HEX8(0x00, d[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x80, d[3]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, d[4]);
+    TEST_ASSERT_EQUAL_HEX8(0xAC, d[5]);
+    TEST_ASSERT_EQUAL_HEX8(0x02, d[6]);
+
+    ANB_BlobReader_t r;
+    ANB_blob_reader_begin(&r, b);
+    for (size_t i = 0; i < nu; i++) TEST_ASSERT_TRUE(ANB_blob_get_varint(&r) == u[i]);
+    for (size_t i = 0; i < ns; i++) TEST_ASSERT_TRUE(ANB_blob_get_svarint(&r) == s[i]);
+    size_t len;
+    const uint8_t *str = ANB_blob_get_lpbytes(&r, &len);
+    TEST_ASSERT_NOT_NULL(str);
+    TEST_ASSERT_EQUAL_size_t(5, len);
+    TEST_ASSERT_EQUAL_MEMORY("hello", str, 5);
+    TEST_ASSERT_FALSE(ANB_blob_reader_failed(&r));
+    TEST_ASSERT_TRUE(ANB_blob_reader_end(&r) > 0);
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. Truncated input sets the sticky error and consumes nothing      */
+/* ------------------------------------------------------------------ */
+void test_codec_truncated(void) {
+    ANB_Blob_t *b = ANB_blob_create(16);
+    ANB_blob_push(b, (const uint8_t *)"\x05" "abc", 4);  /* claims 5 bytes, has 3 */
+
+    ANB_BlobReader_t r;
+    ANB_blob_reader_begin(&r, b);
+    size_t len = 99;
+    TEST_ASSERT_NULL(ANB_blob_get_lpbytes(&r, &len));
+    TEST_ASSERT_EQUAL_size_t(0, len);
+    TEST_ASSERT_TRUE(ANB_blob_reader_failed(&r));
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_blob_reader_end(&r));
+    TEST_ASSERT_EQUAL_size_t(4, ANB_blob_data_len(b));
+
+    /* The rest arrives: the same parse now succeeds */
+    ANB_blob_push(b, (const uint8_t *)"de", 2);
+    ANB_blob_reader_begin(&r, b);
+    TEST_ASSERT_NOT_NULL(ANB_blob_get_lpbytes(&r, &len));
+    TEST_ASSERT_EQUAL_INT(6, (int)ANB_blob_reader_end(&r));
+
+    /* Unterminated and overlong varints */
+    ANB_blob_push(b, (const uint8_t *)"\x80\x80", 2);
+    ANB_blob_reader_begin(&r, b);
+    TEST_ASSERT_TRUE(ANB_blob_get_varint(&r) == 0);
+    TEST_ASSERT_TRUE(ANB_blob_reader_failed(&r));
+    TEST_ASSERT_FALSE(ANB_blob_reader_need(&r, 3));
+    ANB_blob_reader_end(&r);
+    ANB_blob_reset(b);
+    uint8_t longv[11];
+    memset(longv, 0x80, sizeof(longv));
+    ANB_blob_push(b, longv, sizeof(longv));
+    ANB_blob_reader_begin(&r, b);
+    ANB_blob_get_varint(&r);
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_blob_reader_end(&r));
+
+    /* Ten bytes whose last one overflows 64 bits, directly and under the wrappers */
+    static const uint8_t wide[10] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02};
+    ANB_blob_reset(b);
+    ANB_blob_push(b, wide, sizeof(wide));
+    ANB_blob_reader_begin(&r, b);
+    TEST_ASSERT_TRUE(ANB_blob_get_varint(&r) == 0);
+    TEST_ASSERT_TRUE(ANB_blob_reader_failed(&r));
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_blob_reader_end(&r));
+    ANB_blob_reader_begin(&r, b);
+    TEST_ASSERT_TRUE(ANB_blob_get_svarint(&r) == 0);
+    TEST_ASSERT_TRUE(ANB_blob_reader_failed(&r));
+    ANB_blob_reader_end(&r);
+    ANB_blob_reader_begin(&r, b);
+    TEST_ASSERT_NULL(ANB_blob_get_lpbytes(&r, &len));
+    TEST_ASSERT_TRUE(ANB_blob_reader_failed(&r));
+    ANB_blob_reader_end(&r);
+
+    /* UINT64_MAX itself still decodes */
+    ANB_blob_reset(b);
+    ANB_blob_push(b, wide, 9);
+    ANB_blob_push(b, (const uint8_t *)"\x01", 1);
+    ANB_blob_reader_begin(&r, b);
+    TEST_ASSERT_TRUE(ANB_blob_get_varint(&r) == UINT64_MAX);
+    TEST_ASSERT_EQUAL_INT(10, (int)ANB_blob_reader_end(&r));
+
+    /* A writer on full caller storage fails up front */
+    uint8_t buf[256];
+    ANB_Blob_t *fixed = ANB_blob_init_in(buf, sizeof(buf), 0);
+    TEST_ASSERT_NOT_NULL(fixed);
+    size_t cap = ANB_blob_capacity(fixed);
+    ANB_BlobWriter_t w;
+    TEST_ASSERT_EQUAL_INT(-1, ANB_blob_writer_begin(&w, fixed, cap + 1));
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_data_len(fixed));
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_writer_begin(&w, fixed, 8));
+    ANB_blob_put_u64le(&w, 1);
+    TEST_ASSERT_EQUAL_size_t(8, ANB_blob_writer_end(&w));
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Stream VByte matches a byte-by-byte reference at every length   */
+/* ------------------------------------------------------------------ */
+static size_t svb_reference(const uint32_t *in, size_t count, uint8_t *out) {
+    size_t nctrl = (count + 3) / 4, pos = nctrl;
+    memset(out, 0, nctrl);
+    for (size_t i = 0; i < count; i++) {
+        unsigned len = in[i] > 0xFFFFFF ? 4 : in[i] > 0xFFFF ? 3 : in[i] > 0xFF ? 2 : 1;
+        out[i / 4] |= (uint8_t)((len - 1) << (2 * (i % 4)));
+        for (unsigned k = 0; k < len; k++) out[pos++] = (uint8_t)(in[i] >> (8 * k));
+    }
+    return pos;
+}
+
+void test_codec_svb(void) {
+    enum { MAXN = 257 };
+    uint32_t in[MAXN], got[MAXN];
+    uint8_t enc[ANB_CODEC_SVB_BOUND(MAXN)], ref[ANB_CODEC_SVB_BOUND(MAXN)];
+    uint64_t rng = 42;
+    for (size_t i = 0; i < MAXN; i++) {
+        rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint32_t v = (uint32_t)(rng >> 32);
+        in[i] = v >> (8 * ((rng >> 20) & 3));   /* mix of 1- to 4-byte values */
+    }
+    for (size_t n = 0; n <= MAXN; n++) {
+        size_t elen = ANB_codec_svb_encode(in, n, enc);
+        TEST_ASSERT_EQUAL_size_t(svb_reference(in, n, ref), elen);
+        if (!n) continue;
+        TEST_ASSERT_EQUAL_MEMORY(ref, enc, elen);
+        memset(got, 0, sizeof(got));
+        TEST_ASSERT_EQUAL_size_t(elen, ANB_codec_svb_decode(enc, elen, got, n));
+        TEST_ASSERT_EQUAL_MEMORY(in, got, n * sizeof(uint32_t));
+        TEST_ASSERT_EQUAL_size_t(0, ANB_codec_svb_decode(enc, elen - 1, got, n));
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. Stream VByte arrays through writer and reader                   */
+/* ------------------------------------------------------------------ */
+void test_codec_svb_blob(void) {
+    uint32_t in[1000], out[1000];
+    for (uint32_t i = 0; i < 1000; i++) in[i] = i * i * 37;
+
+    ANB_Blob_t *b = ANB_blob_create(64);
+    ANB_BlobWriter_t w;
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_writer_begin(&w, b, ANB_CODEC_VARINT_MAX + ANB_CODEC_SVB_BOUND(1000)));
+    ANB_blob_put_varint(&w, 1000);
+    ANB_blob_put_svb(&w, in, 1000);
+    size_t written = ANB_blob_writer_end(&w);
+    TEST_ASSERT_TRUE(written < 1000 * 4);
+
+    ANB_BlobReader_t r;
+    ANB_blob_reader_begin(&r, b);
+    uint64_t n = ANB_blob_get_varint(&r);
+    TEST_ASSERT_TRUE(n == 1000);
+    TEST_ASSERT_TRUE(ANB_blob_get_svb(&r, out, (size_t)n));
+    TEST_ASSERT_EQUAL_MEMORY(in, out, sizeof(in));
+    TEST_ASSERT_EQUAL_INT((int)written, (int)ANB_blob_reader_end(&r));
+
+    /* Truncated block */
+    ANB_blob_writer_begin(&w, b, ANB_CODEC_SVB_BOUND(1000));
+    ANB_blob_put_svb(&w, in, 1000);
+    ANB_blob_writer_end(&w);
+    ANB_blob_reader_begin(&r, b);
+    TEST_ASSERT_FALSE(ANB_blob_get_svb(&r, out, 1001));
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_blob_reader_end(&r));
+    ANB_blob_destroy(b);
+}
@@ -0,0 +1,151 @@
+#include "unity.h"
+#include "blob_digest.h"
+#include "blob_codec.h"
+#include "blob_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *g_nobody = "Nobody inspects the spammish repetition";
+
+/* ------------------------------------------------------------------ */
+/* 1. Published test vectors                                          */
+/* ------------------------------------------------------------------ */
+void test_digest_vectors(void) {
+    ANB_DigestSpec_t crc = {ANB_DIGEST_CRC32C, 0, NULL, NULL};
+    ANB_DigestSpec_t xxh = {ANB_DIGEST_XXH64, 0, NULL, NULL};
+    uint8_t buf[32];
+
+    TEST_ASSERT_EQUAL_HEX32(0xE3069283u, (uint32_t)ANB_digest(&crc, (const uint8_t *)"123456789", 9));
+    TEST_ASSERT_EQUAL_HEX32(0, (uint32_t)ANB_digest(&crc, NULL, 0));
+    memset(buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL_HEX32(0x8A9136AAu, (uint32_t)ANB_digest(&crc, buf, 32));    // RFC 3720 B.4
+    memset(buf, 0xFF, sizeof(buf));
+    TEST_ASSERT_EQUAL_HEX32(0x62A8AB43u, (uint32_t)ANB_digest(&crc, buf, 32));
+    for (int i = 0; i < 32; i++) buf[i] = (uint8_t)i;
+    TEST_ASSERT_EQUAL_HEX32(0x46DD794Eu, (uint32_t)ANB_digest(&crc, buf, 32));
+
+    TEST_ASSERT_TRUE(ANB_digest(&xxh, NULL, 0) == 0xEF46DB3751D8E999ULL);
+    TEST_ASSERT_TRUE(ANB_digest(&xxh, (const uint8_t *)"abc", 3) == 0x44BC2CF5AD770999ULL);
+    TEST_ASSERT_TRUE(ANB_digest(&xxh, (const uint8_t *)g_nobody, strlen(g_nobody)) == 0xFBCEA83C8A378BF1ULL);
+
+    // CRC32C chains through the seed
+    crc.seed = ANB_digest(&crc, (const uint8_t *)"12345", 5);
+    TEST_ASSERT_EQUAL_HEX32(0xE3069283u, (uint32_t)ANB_digest(&crc, (const uint8_t *)"6789", 4));
+
+    ANB_DigestSpec_t none = {0};
+    TEST_ASSERT_TRUE(ANB_digest(&none, (const uint8_t *)"abc", 3) == 0);
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Push in pieces gives the one-shot value for every split         */
+/* ------------------------------------------------------------------ */
+void test_digest_blob_stream(void) {
+    uint8_t data[300];
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 131 + 7);
+    static const int kinds[] = {ANB_DIGEST_CRC32C, ANB_DIGEST_XXH64};
+
+    for (int k = 0; k < 2; k++) {
+        ANB_DigestSpec_t spec = {kinds[k], 12345, NULL, NULL};
+        ANB_Blob_t *b = ANB_blob_create(64);
+        ANB_blob_set_digest(b, &spec);
+        for (size_t len = 0; len <= sizeof(data); len += 37) {
+            uint64_t expect = ANB_digest(&spec, data, len);
+            for (size_t step = 1; step <= 70; step += 23) {
+                ANB_blob_reset(b);
+                for (size_t off = 0; off < len; off += step) {
+                    size_t n = len - off < step ? len - off : step;
+                    ANB_blob_push(b, data + off, n);
+                    // Consuming everything rewinds the blob but not the digest
+                    ANB_blob_consume(b, n);
+                }
+                TEST_ASSERT_TRUE(ANB_blob_digest(b) == expect);
+            }
+        }
+        ANB_blob_destroy(b);
+    }
+
+    // Large one-shot buffers take the interleaved CRC32C blocks; small pushes do not
+    size_t big = 3 * 8192 * 2 + 3 * 256 + 100;
+    uint8_t *src = (uint8_t *)malloc(big);
+    TEST_ASSERT_NOT_NULL(src);
+    for (size_t i = 0; i < big; i++) src[i] = (uint8_t)(i * 2654435761u >> 11);
+    for (int k = 0; k < 2; k++) {
+        ANB_DigestSpec_t spec = {kinds[k], 0, NULL, NULL};
+        ANB_Blob_t *b = ANB_blob_create(64);
+        ANB_blob_set_digest(b, &spec);
+        for (size_t off = 0; off < big; off += 100) ANB_blob_push(b, src + off, big - off < 100 ? big - off : 100);
+        TEST_ASSERT_TRUE(ANB_blob_digest(b) == ANB_digest(&spec, src, big));
+        ANB_blob_destroy(b);
+    }
+    free(src);
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. Reserve/commit and codec writes are covered; reset restarts     */
+/* ------------------------------------------------------------------ */
+void test_digest_blob_paths(void) {
+    ANB_DigestSpec_t spec = {ANB_DIGEST_XXH64, 0, NULL, NULL};
+    ANB_Blob_t *b = ANB_blob_create(16);
+    ANB_blob_push(b, (const uint8_t *)"before", 6);
+    TEST_ASSERT_TRUE(ANB_blob_digest(b) == 0);
+    ANB_blob_set_digest(b, &spec);
+
+    size_t avail;
+    uint8_t *tail = ANB_blob_reserve(b, 10, &avail);
+    memcpy(tail, "Nobody ins", 10);
+    ANB_blob_commit(b, 10);
+    ANB_BlobWriter_t w;
+    ANB_blob_writer_begin(&w, b, 64);
+    ANB_blob_put_bytes(&w, g_nobody + 10, strlen(g_nobody) - 10);
+    ANB_blob_writer_end(&w);
+    TEST_ASSERT_TRUE(ANB_blob_digest(b) == 0xFBCEA83C8A378BF1ULL);
+
+    ANB_blob_reset(b);
+    TEST_ASSERT_TRUE(ANB_blob_digest(b) == 0xEF46DB3751D8E999ULL);
+    ANB_blob_push(b, (const uint8_t *)"abc", 3);
+    TEST_ASSERT_TRUE(ANB_blob_digest(b) == 0x44BC2CF5AD770999ULL);
+    ANB_blob_clear(b);
+    TEST_ASSERT_TRUE(ANB_blob_digest(b) == 0xEF46DB3751D8E999ULL);
+
+    ANB_blob_set_digest(b, NULL);
+    ANB_blob_push(b, (const uint8_t *)"abc", 3);
+    TEST_ASSERT_TRUE(ANB_blob_digest(b) == 0);
+    ANB_blob_destroy(b);
+
+    // The pool hands blobs out without a digest
+    ANB_BlobPool_t *pool = ANB_blob_pool_create(4096, 1 << 20, 0);
+    b = ANB_blob_pool_acquire(pool, 1024);
+    ANB_Blob_t *first = b;
+    ANB_blob_set_digest(b, &spec);
+    ANB_blob_pool_release(pool, b);
+    b = ANB_blob_pool_acquire(pool, 1024);
+    TEST_ASSERT_EQUAL_PTR(first, b);
+    ANB_blob_push(b, (const uint8_t *)"abc", 3);
+    TEST_ASSERT_TRUE(ANB_blob_digest(b) == 0);
+    ANB_blob_pool_release(pool, b);
+    ANB_blob_pool_destroy(pool);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. A caller hook folds every write                                 */
+/* ------------------------------------------------------------------ */
+static uint64_t digest_fnv1a(void *ctx, uint64_t state, const uint8_t *data, size_t len) {
+    (*(int *)ctx)++;
+    for (size_t i = 0; i < len; i++) state = (state ^ data[i]) * 0x100000001B3ULL;
+    return state;
+}
+
+void test_digest_hook(void) {
+    int calls = 0;
+    ANB_DigestSpec_t spec = {ANB_DIGEST_HOOK, 0xCBF29CE484222325ULL, digest_fnv1a, &calls};
+    ANB_Blob_t *b = ANB_blob_create(64);
+    ANB_blob_set_digest(b, &spec);
+    ANB_blob_push(b, (const uint8_t *)"foo", 3);
+    ANB_blob_push(b, (const uint8_t *)"bar", 3);
+    ANB_blob_push(b, (const uint8_t *)"", 0);
+    TEST_ASSERT_EQUAL_INT(2, calls);
+    TEST_ASSERT_TRUE(ANB_blob_digest(b) == 0x85944171F73967E8ULL);   // FNV-1a 64 of "foobar"
+    ANB_blob_reset(b);
+    TEST_ASSERT_TRUE(ANB_blob_digest(b) == 0xCBF29CE484222325ULL);
+    ANB_blob_destroy(b);
+}
@@ -0,0 +1,269 @@
+#include "unity.h"
+#include "blob_io.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static void io_fill(uint8_t *buf, size_t len, uint8_t seed) {
+    for (size_t i = 0; i < len; i++) buf[i] = (uint8_t)(seed + i * 7);
+}
+
+static void io_nonblock(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+/* ------------------------------------------------------------------ */
+/* 1. Read from a pipe: data, EAGAIN, then EOF                        */
+/* ------------------------------------------------------------------ */
+void test_blob_io_read_pipe(void) {
+    int p[2];
+    TEST_ASSERT_EQUAL_INT(0, pipe(p));
+    io_nonblock(p[0]);
+
+    uint8_t src[1000];
+    io_fill(src, sizeof(src), 1);
+    TEST_ASSERT_EQUAL_INT((int)sizeof(src), (int)write(p[1], src, sizeof(src)));
+
+    ANB_Blob_t *b = ANB_blob_create(16);
+    TEST_ASSERT_EQUAL_INT((int)sizeof(src), (int)ANB_blob_read_fd(b, p[0], 0));
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), ANB_blob_data_len(b));
+    TEST_ASSERT_EQUAL_MEMORY(src, ANB_blob_data(b), sizeof(src));
+
+    errno = 0;
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_blob_read_fd(b, p[0], 0));
+    TEST_ASSERT_EQUAL_INT(EAGAIN, errno);
+
+    close(p[1]);
+    TEST_ASSERT_EQUAL_INT(0, (int)ANB_blob_read_fd(b, p[0], 0));
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), ANB_blob_data_len(b));
+
+    close(p[0]);
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. max caps the read; the rest stays in the fd                     */
+/* ------------------------------------------------------------------ */
+void test_blob_io_read_max(void) {
+    int p[2];
+    TEST_ASSERT_EQUAL_INT(0, pipe(p));
+    io_nonblock(p[0]);
+    uint8_t src[300];
+    io_fill(src, sizeof(src), 3);
+    TEST_ASSERT_EQUAL_INT((int)sizeof(src), (int)write(p[1], src, sizeof(src)));
+
+    ANB_Blob_t *b = ANB_blob_create(1024);
+    TEST_ASSERT_EQUAL_INT(100, (int)ANB_blob_read_fd(b, p[0], 100));
+    TEST_ASSERT_EQUAL_INT(200, (int)ANB_blob_read_fd(b, p[0], 0));
+    TEST_ASSERT_EQUAL_MEMORY(src, ANB_blob_data(b), sizeof(src));
+
+    close(p[0]);
+    close(p[1]);
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. A small blob grows to take a large socket backlog               */
+/* ------------------------------------------------------------------ */
+void test_blob_io_read_grows(void) {
+    int sv[2];
+    TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+    io_nonblock(sv[0]);
+    io_nonblock(sv[1]);
+
+    static uint8_t src[150000];
+    io_fill(src, sizeof(src), 5);
+    size_t sent = 0;
+    ANB_Blob_t *b = ANB_blob_create(8);
+
+    // Interleave writes and reads so neither side needs a huge socket buffer
+    while (sent < sizeof(src) || ANB_blob_data_len(b) < sizeof(src)) {
+        if (sent < sizeof(src)) {
+            ssize_t w = write(sv[1], src + sent, sizeof(src) - sent);
+            if (w > 0) sent += (size_t)w;
+        }
+        ssize_t r = ANB_blob_read_fd(b, sv[0], 0);
+        TEST_ASSERT_TRUE(r > 0 || (r == -1 && errno == EAGAIN));
+    }
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), ANB_blob_data_len(b));
+    TEST_ASSERT_EQUAL_MEMORY(src, ANB_blob_data(b), sizeof(src));
+
+    close(sv[0]);
+    close(sv[1]);
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Caller storage: reads stop at capacity, nothing is lost         */
+/* ------------------------------------------------------------------ */
+void test_blob_io_read_fixed(void) {
+    int p[2];
+    TEST_ASSERT_EQUAL_INT(0, pipe(p));
+    io_nonblock(p[0]);
+    uint8_t src[2000];
+    io_fill(src, sizeof(src), 9);
+    TEST_ASSERT_EQUAL_INT((int)sizeof(src), (int)write(p[1], src, sizeof(src)));
+
+    uint8_t storage[1024];
+    ANB_Blob_t *b = ANB_blob_init_in(storage, sizeof(storage), 0);
+    size_t cap = ANB_blob_capacity(b);
+    TEST_ASSERT_EQUAL_INT((int)cap, (int)ANB_blob_read_fd(b, p[0], 0));
+    errno = 0;
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_blob_read_fd(b, p[0], 0));
+    TEST_ASSERT_EQUAL_INT(ENOBUFS, errno);
+
+    // Consuming frees room; the read compacts and continues where it stopped
+    ANB_blob_consume(b, 100);
+    TEST_ASSERT_EQUAL_INT(100, (int)ANB_blob_read_fd(b, p[0], 0));
+    size_t len;
+    uint8_t *d = ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(cap, len);
+    TEST_ASSERT_EQUAL_MEMORY(src + 100, d, cap);
+
+    close(p[0]);
+    close(p[1]);
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. Write consumes what the fd took; leftovers stay unread          */
+/* ------------------------------------------------------------------ */
+void test_blob_io_write_partial(void) {
+    int p[2];
+    TEST_ASSERT_EQUAL_INT(0, pipe(p));
+    io_nonblock(p[1]);
+    io_nonblock(p[0]);
+
+    static uint8_t src[1 << 20]; // More than a default pipe holds
+    io_fill(src, sizeof(src), 11);
+    ANB_Blob_t *b = ANB_blob_create(sizeof(src));
+    ANB_blob_push(b, src, sizeof(src));
+
+    ssize_t w = ANB_blob_write_fd(b, p[1]);
+    TEST_ASSERT_TRUE(w > 0 && (size_t)w < sizeof(src));
+    size_t len;
+    ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(sizeof(src) - (size_t)w, len);
+    errno = 0;
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_blob_write_fd(b, p[1]));
+    TEST_ASSERT_EQUAL_INT(EAGAIN, errno);
+
+    // Drain and finish; the reader sees the original bytes in order
+    ANB_Blob_t *out = ANB_blob_create(64);
+    while (ANB_blob_data_len(out) < sizeof(src)) {
+        ANB_blob_read_fd(out, p[0], 0);
+        ANB_blob_write_fd(b, p[1]);
+    }
+    ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(0, len);
+    TEST_ASSERT_EQUAL_MEMORY(src, ANB_blob_data(out), sizeof(src));
+    TEST_ASSERT_EQUAL_INT(0, (int)ANB_blob_write_fd(b, p[1]));
+
+    close(p[0]);
+    close(p[1]);
+    ANB_blob_destroy(b);
+    ANB_blob_destroy(out);
+}
+
+/* ------------------------------------------------------------------ */
+/* 6. writev sends several blobs in order                             */
+/* ------------------------------------------------------------------ */
+void test_blob_io_writev(void) {
+    int p[2];
+    TEST_ASSERT_EQUAL_INT(0, pipe(p));
+    io_nonblock(p[0]);
+
+    ANB_Blob_t *hdr = ANB_blob_create(16);
+    ANB_Blob_t *empty = ANB_blob_create(16);
+    ANB_Blob_t *body = ANB_blob_create(16);
+    ANB_blob_push(hdr, (const uint8_t *)"HDR:", 4);
+    ANB_blob_push(body, (const uint8_t *)"payload", 7);
+    ANB_blob_consume(body, 3); // Only the unread part goes out
+
+    ANB_Blob_t *parts[] = { hdr, empty, body };
+    TEST_ASSERT_EQUAL_INT(8, (int)ANB_blob_writev_fd(parts, 3, p[1]));
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_data_len(hdr));
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_data_len(body));
+
+    char got[16] = {0};
+    TEST_ASSERT_EQUAL_INT(8, (int)read(p[0], got, sizeof(got)));
+    TEST_ASSERT_EQUAL_STRING("HDR:load", got);
+
+    close(p[0]);
+    close(p[1]);
+    ANB_blob_destroy(hdr);
+    ANB_blob_destroy(empty);
+    ANB_blob_destroy(body);
+}
+
+/* ------------------------------------------------------------------ */
+/* 7. splice: file -> pipe, pipe -> file, socket -> socket            */
+/* ------------------------------------------------------------------ */
+static int io_tmpfile(void) {
+    FILE *f = tmpfile();
+    TEST_ASSERT_NOT_NULL(f);
+    int fd = dup(fileno(f)); // tmpfile is unlinked; the dup keeps it alive
+    fclose(f);
+    return fd;
+}
+
+void test_blob_io_splice(void) {
+    static uint8_t src[200000];
+    io_fill(src, sizeof(src), 13);
+    ANB_Blob_t *bounce = ANB_blob_create(64);
+
+    // File -> pipe (splice), bounded by the pipe: loop with a reader
+    int in = io_tmpfile();
+    TEST_ASSERT_EQUAL_INT((int)sizeof(src), (int)pwrite(in, src, sizeof(src), 0));
+    int p[2];
+    TEST_ASSERT_EQUAL_INT(0, pipe(p));
+    io_nonblock(p[0]);
+    io_nonblock(p[1]);
+    ANB_Blob_t *sink = ANB_blob_create(64);
+    size_t moved = 0;
+    for (;;) {
+        ssize_t n = ANB_blob_splice_fd(bounce, in, p[1], 0);
+        if (n > 0) moved += (size_t)n;
+        ANB_blob_read_fd(sink, p[0], 0);
+        if (n == 0) break;
+    }
+    ANB_blob_read_fd(sink, p[0], 0);
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), moved);
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), ANB_blob_data_len(sink));
+    TEST_ASSERT_EQUAL_MEMORY(src, ANB_blob_data(sink), sizeof(src));
+    close(in);
+
+    // Pipe -> file (splice) with a byte limit
+    int out = io_tmpfile();
+    TEST_ASSERT_EQUAL_INT(5000, (int)write(p[1], src, 5000));
+    TEST_ASSERT_EQUAL_INT(1000, (int)ANB_blob_splice_fd(bounce, p[0], out, 1000));
+    TEST_ASSERT_EQUAL_INT(4000, (int)ANB_blob_splice_fd(bounce, p[0], out, 0));
+    uint8_t back[5000];
+    TEST_ASSERT_EQUAL_INT(5000, (int)pread(out, back, sizeof(back), 0));
+    TEST_ASSERT_EQUAL_MEMORY(src, back, sizeof(back));
+    close(out);
+    close(p[0]);
+    close(p[1]);
+
+    // Socket -> socket takes the userspace path through the bounce blob
+    int a[2], c[2];
+    TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, a));
+    TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, c));
+    TEST_ASSERT_EQUAL_INT(3000, (int)write(a[1], src, 3000));
+    shutdown(a[1], SHUT_WR);
+    TEST_ASSERT_EQUAL_INT(3000, (int)ANB_blob_splice_fd(bounce, a[0], c[0], 0));
+    TEST_ASSERT_EQUAL_INT(0, (int)ANB_blob_splice_fd(bounce, a[0], c[0], 0));
+    uint8_t got[3000];
+    TEST_ASSERT_EQUAL_INT(3000, (int)recv(c[1], got, sizeof(got), MSG_WAITALL));
+    TEST_ASSERT_EQUAL_MEMORY(src, got, sizeof(got));
+    close(a[0]);
+    close(a[1]);
+    close(c[0]);
+    close(c[1]);
+
+    ANB_blob_destroy(sink);
+    ANB_blob_destroy(bounce);
+}
@@ -0,0 +1,160 @@
+#include "unity.h"
+#include "blob_pool.h"
+#include <pthread.h>
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/* 1. Acquire rounds up to a class; release recycles the same blob    */
+/* ------------------------------------------------------------------ */
+void test_blob_pool_recycle(void) {
+    ANB_BlobPool_t *pool = ANB_blob_pool_create(64 * 1024, 1 << 20, 0);
+
+    ANB_Blob_t *b = ANB_blob_pool_acquire(pool, 1000);
+    TEST_ASSERT_EQUAL_size_t(1024, ANB_blob_capacity(b));
+    ANB_Blob_t *small = ANB_blob_pool_acquire(pool, 0);
+    TEST_ASSERT_EQUAL_size_t(ANB_BLOB_POOL_MIN_CLASS, ANB_blob_capacity(small));
+
+    ANB_blob_push(b, (const uint8_t *)"request", 7);
+    ANB_blob_consume(b, 3);
+    ANB_blob_set_compact(b, 0);
+    ANB_blob_pool_release(pool, b);
+    TEST_ASSERT_EQUAL_size_t(1024, ANB_blob_pool_retained(pool));
+
+    /* Same class comes back empty, contents left in place (reset, not clear) */
+    ANB_Blob_t *again = ANB_blob_pool_acquire(pool, 700);
+    TEST_ASSERT_EQUAL_PTR(b, again);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_data_len(again));
+    size_t len;
+    ANB_blob_peek(again, &len);
+    TEST_ASSERT_EQUAL_size_t(0, len);
+    TEST_ASSERT_EQUAL_MEMORY("request", ANB_blob_data(again), 7);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_pool_retained(pool));
+
+    ANB_blob_pool_release(pool, again);
+    ANB_blob_pool_release(pool, small);
+    ANB_blob_pool_release(pool, NULL);
+    ANB_blob_pool_destroy(pool);
+    ANB_blob_pool_destroy(NULL);
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Oversize blobs and blobs that grew past the top class are freed */
+/* ------------------------------------------------------------------ */
+void test_blob_pool_oversize(void) {
+    ANB_BlobPool_t *pool = ANB_blob_pool_create(4096, 1 << 20, 0);
+
+    ANB_Blob_t *big = ANB_blob_pool_acquire(pool, 10000);
+    TEST_ASSERT_EQUAL_size_t(10000, ANB_blob_capacity(big));
+    ANB_blob_pool_release(pool, big);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_pool_retained(pool));
+
+    ANB_Blob_t *b = ANB_blob_pool_acquire(pool, 4096);
+    uint8_t chunk[5000] = {0};
+    ANB_blob_push(b, chunk, sizeof(chunk));
+    ANB_blob_pool_release(pool, b);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_blob_pool_retained(pool));
+
+    ANB_blob_pool_destroy(pool);
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. Grown blobs are filed under the class they cover                */
+/* ------------------------------------------------------------------ */
+void test_blob_pool_grown(void) {
+    ANB_BlobPool_t *pool = ANB_blob_pool_create(64 * 1024, 1 << 20, 0);
+
+    ANB_Blob_t *b = ANB_blob_pool_acquire(pool, 256);
+    uint8_t chunk[3000] = {0};
+    ANB_blob_push(b, chunk, sizeof(chunk));
+    size_t cap = ANB_blob_capacity(b);
+    TEST_ASSERT_TRUE(cap >= 3000);
+    ANB_blob_pool_release(pool, b);
+    TEST_ASSERT_EQUAL_size_t(cap, ANB_blob_pool_retained(pool));
+
+    /* Not handed out for a smaller class... */
+    ANB_Blob_t *other = ANB_blob_pool_acquire(pool, 256);
+    TEST_ASSERT_TRUE(other != b);
+    /* ...but for the largest power of two its capacity covers */
+    size_t cls = 2048;
+    while (cls * 2 <= cap) cls *= 2;
+    TEST_ASSERT_EQUAL_PTR(b, ANB_blob_pool_acquire(pool, cls));
+
+    ANB_blob_pool_release(pool, b);
+    ANB_blob_pool_release(pool, other);
+    ANB_blob_pool_destroy(pool);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Retention is capped per class beyond the thread cache           */
+/* ------------------------------------------------------------------ */
+void test_blob_pool_retain_cap(void) {
+    ANB_BlobPool_t *pool = ANB_blob_pool_create(64 * 1024, 2048, 0);
+
+    /* More releases than a thread cache holds: the shared list keeps two */
+    ANB_Blob_t *b[20];
+    for (int i = 0; i < 20; i++) b[i] = ANB_blob_pool_acquire(pool, 1024);
+    for (int i = 0; i < 20; i++) ANB_blob_pool_release(pool, b[i]);
+    size_t retained = ANB_blob_pool_retained(pool);
+    TEST_ASSERT_TRUE(retained >= 2048);
+    TEST_ASSERT_TRUE(retained <= 2048 + ANB_BLOB_POOL_THREAD_CACHE * 1024);
+
+    /* Other classes have their own budget */
+    ANB_Blob_t *s = ANB_blob_pool_acquire(pool, 256);
+    ANB_blob_pool_release(pool, s);
+    TEST_ASSERT_EQUAL_size_t(retained + 256, ANB_blob_pool_retained(pool));
+
+    /* A blob larger than the limit is never kept */
+    ANB_Blob_t *big = ANB_blob_pool_acquire(pool, 4096);
+    ANB_blob_pool_release(pool, big);
+    TEST_ASSERT_EQUAL_size_t(retained + 256, ANB_blob_pool_retained(pool));
+
+    ANB_blob_pool_destroy(pool);
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. Many threads; caches of exited threads return to the pool       */
+/* ------------------------------------------------------------------ */
+#define POOL_THREADS 4
+#define POOL_ROUNDS 20000
+
+static void *pool_worker(void *arg) {
+    ANB_BlobPool_t *pool = (ANB_BlobPool_t *)arg;
+    uint64_t rng = (uint64_t)(uintptr_t)&rng;
+    ANB_Blob_t *held[4] = {0};
+    for (int i = 0; i < POOL_ROUNDS; i++) {
+        rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        int slot = (int)((rng >> 33) % 4);
+        size_t want = 1 + (size_t)((rng >> 40) % 8000);
+        ANB_blob_pool_release(pool, held[slot]);
+        held[slot] = ANB_blob_pool_acquire(pool, want);
+        if (ANB_blob_capacity(held[slot]) < want) return (void *)1;
+        ANB_blob_push(held[slot], (const uint8_t *)&rng, sizeof(rng));
+    }
+    for (int i = 0; i < 4; i++) ANB_blob_pool_release(pool, held[i]);
+    return NULL;
+}
+
+void test_blob_pool_threads(void) {
+    ANB_BlobPool_t *pool = ANB_blob_pool_create(8192, 64 * 1024, 0);
+    pthread_t t[POOL_THREADS];
+    for (int i = 0; i < POOL_THREADS; i++) pthread_create(&t[i], NULL, pool_worker, pool);
+    int failed = 0;
+    for (int i = 0; i < POOL_THREADS; i++) {
+        void *r;
+        pthread_join(t[i], &r);
+        failed |= r != NULL;
+    }
+    TEST_ASSERT_FALSE(failed);
+
+    /* Six classes (256 .. 8192); exited threads' caches went to the shared lists */
+    size_t retained = ANB_blob_pool_retained(pool);
+    TEST_ASSERT_TRUE(retained > 0);
+    TEST_ASSERT_TRUE(retained <= 6 * 64 * 1024);
+
+    /* The exited threads' blobs are reachable from here */
+    ANB_Blob_t *b = ANB_blob_pool_acquire(pool, 4096);
+    TEST_ASSERT_TRUE(ANB_blob_pool_retained(pool) < retained);
+    ANB_blob_pool_release(pool, b);
+
+    ANB_blob_pool_destroy(pool);
+}
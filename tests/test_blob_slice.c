@@ -0,0 +1,198 @@
+#include "unity.h"
+#include "blob_slice.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/* ------------------------------------------------------------------ */
+/* 1. Slices keep their bytes through reset, push and destroy         */
+/* ------------------------------------------------------------------ */
+void test_blob_slice_cow(void) {
+    ANB_Blob_t *b = ANB_blob_create(1024);
+    ANB_blob_push(b, (const uint8_t *)"hello world", 11);
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_is_shared(b));
+
+    ANB_BlobSlice_t all, word;
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_slice(b, 0, 11, &all));
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_slice(b, 6, 5, &word));
+    TEST_ASSERT_EQUAL_INT(1, ANB_blob_is_shared(b));
+    TEST_ASSERT_EQUAL_size_t(3, ANB_blob_slice_refs(&all));
+
+    // Shared in place: no copy was made
+    size_t len;
+    TEST_ASSERT_EQUAL_PTR(ANB_blob_data(b), ANB_blob_slice_data(&all, &len));
+    TEST_ASSERT_EQUAL_size_t(11, len);
+
+    // The next write copies; the slices keep the old bytes
+    ANB_blob_reset(b);
+    ANB_blob_push(b, (const uint8_t *)"HELLO", 5);
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_is_shared(b));
+    TEST_ASSERT_EQUAL_size_t(1024, ANB_blob_capacity(b));
+    TEST_ASSERT_EQUAL_size_t(2, ANB_blob_slice_refs(&all));
+    TEST_ASSERT_EQUAL_MEMORY("hello world", ANB_blob_slice_data(&all, NULL), 11);
+    TEST_ASSERT_EQUAL_MEMORY("HELLO", ANB_blob_data(b), 5);
+
+    ANB_blob_destroy(b);
+    TEST_ASSERT_EQUAL_MEMORY("world", ANB_blob_slice_data(&word, &len), 5);
+    TEST_ASSERT_EQUAL_size_t(5, len);
+
+    ANB_BlobSlice_t sub;
+    ANB_blob_slice_sub(&word, 1, 3, &sub);
+    TEST_ASSERT_EQUAL_MEMORY("orl", ANB_blob_slice_data(&sub, NULL), 3);
+    TEST_ASSERT_EQUAL_size_t(3, ANB_blob_slice_refs(&sub));
+
+    ANB_blob_slice_release(&all);
+    ANB_blob_slice_release(&word);
+    TEST_ASSERT_NULL(ANB_blob_slice_data(&word, &len));
+    TEST_ASSERT_EQUAL_size_t(0, len);
+    ANB_blob_slice_release(&word);        // already empty
+    ANB_blob_slice_release(&sub);
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. With every slice released, the blob takes its buffer back       */
+/* ------------------------------------------------------------------ */
+void test_blob_slice_reclaim(void) {
+    ANB_Blob_t *b = ANB_blob_create(4096);
+    ANB_blob_push(b, (const uint8_t *)"abcdef", 6);
+    ANB_blob_consume(b, 2);
+    uint8_t *before = ANB_blob_data(b);
+
+    ANB_BlobSlice_t s;
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_slice(b, 1, 3, &s));
+    TEST_ASSERT_EQUAL_MEMORY("def", ANB_blob_slice_data(&s, NULL), 3);
+    ANB_blob_slice_release(&s);
+    TEST_ASSERT_EQUAL_INT(1, ANB_blob_is_shared(b));
+
+    ANB_blob_push(b, (const uint8_t *)"gh", 2);
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_is_shared(b));
+    TEST_ASSERT_EQUAL_PTR(before, ANB_blob_data(b));
+    size_t len;
+    uint8_t *p = ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(6, len);
+    TEST_ASSERT_EQUAL_MEMORY("cdefgh", p, 6);
+
+    // Growth while shared copies into the larger buffer
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_slice(b, 0, 6, &s));
+    uint8_t big[8192];
+    memset(big, 'x', sizeof(big));
+    ANB_blob_push(b, big, sizeof(big));
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_is_shared(b));
+    p = ANB_blob_peek(b, &len);
+    TEST_ASSERT_EQUAL_size_t(6 + sizeof(big), len);
+    TEST_ASSERT_EQUAL_MEMORY("cdefgh", p, 6);
+    TEST_ASSERT_EQUAL_MEMORY("cdefgh", ANB_blob_slice_data(&s, NULL), 6);
+    TEST_ASSERT_EQUAL_size_t(1, ANB_blob_slice_refs(&s));
+    ANB_blob_slice_release(&s);
+
+    // Clear and trim leave shared bytes alone
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_slice(b, 0, 6, &s));
+    ANB_blob_trim(b);
+    ANB_blob_clear(b);
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_is_shared(b));
+    for (size_t i = 0; i < ANB_blob_capacity(b); i++) TEST_ASSERT_EQUAL_UINT8(0, ANB_blob_data(b)[i]);
+    TEST_ASSERT_EQUAL_MEMORY("cdefgh", ANB_blob_slice_data(&s, NULL), 6);
+    ANB_blob_slice_release(&s);
+
+    ANB_blob_destroy(b);
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. Inline, caller and file storage                                 */
+/* ------------------------------------------------------------------ */
+void test_blob_slice_storage(void) {
+    // Inline storage lives in the handle and is copied out once
+    ANB_Blob_t *b = ANB_blob_create(64);
+    ANB_blob_push(b, (const uint8_t *)"inline", 6);
+    ANB_BlobSlice_t s;
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_slice(b, 0, 6, &s));
+    ANB_blob_destroy(b);
+    TEST_ASSERT_EQUAL_MEMORY("inline", ANB_blob_slice_data(&s, NULL), 6);
+    ANB_blob_slice_release(&s);
+
+    // Caller storage that may not spill cannot be shared
+    _Alignas(max_align_t) uint8_t buf[512];
+    b = ANB_blob_init_in(buf, sizeof(buf), 0);
+    ANB_blob_push(b, (const uint8_t *)"fixed", 5);
+    TEST_ASSERT_EQUAL_INT(-1, ANB_blob_slice(b, 0, 5, &s));
+    TEST_ASSERT_NULL(ANB_blob_slice_data(&s, NULL));
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_is_shared(b));
+
+    b = ANB_blob_init_in(buf, sizeof(buf), ANB_MEM_SPILL | ANB_MEM_SECURE);
+    ANB_blob_push(b, (const uint8_t *)"spill", 5);
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_slice(b, 0, 5, &s));
+    ANB_blob_reset(b);
+    ANB_blob_push(b, (const uint8_t *)"again", 5);
+    ANB_blob_destroy(b);
+    TEST_ASSERT_EQUAL_MEMORY("spill", ANB_blob_slice_data(&s, NULL), 5);
+    ANB_blob_slice_release(&s);
+
+    // A file view is shared without copying and outlives its blob
+    char path[] = "/tmp/anb_slice_XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(9, (int)write(fd, "file data", 9));
+    close(fd);
+    b = ANB_blob_map_file(path, 0);
+    unlink(path);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_INT(0, ANB_blob_slice(b, 5, 4, &s));
+    TEST_ASSERT_EQUAL_PTR(ANB_blob_data(b) + 5, ANB_blob_slice_data(&s, NULL));
+    ANB_blob_push(b, (const uint8_t *)"!", 1);
+    TEST_ASSERT_EQUAL_MEMORY("file data!", ANB_blob_data(b), 10);
+    ANB_blob_destroy(b);
+    TEST_ASSERT_EQUAL_MEMORY("data", ANB_blob_slice_data(&s, NULL), 4);
+    ANB_blob_slice_release(&s);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Fan-out: slices released on other threads                       */
+/* ------------------------------------------------------------------ */
+#define SLICE_THREADS 4
+#define SLICE_ROUNDS 200
+
+typedef struct {
+    ANB_BlobSlice_t slices[SLICE_ROUNDS];
+    size_t sum;
+} SliceWork;
+
+static void *slice_reader(void *arg) {
+    SliceWork *w = (SliceWork *)arg;
+    for (int i = 0; i < SLICE_ROUNDS; i++) {
+        size_t len;
+        const uint8_t *p = ANB_blob_slice_data(&w->slices[i], &len);
+        for (size_t j = 0; j < len; j++) w->sum += p[j];
+        ANB_blob_slice_release(&w->slices[i]);
+    }
+    return NULL;
+}
+
+void test_blob_slice_threads(void) {
+    static SliceWork work[SLICE_THREADS];
+    ANB_Blob_t *b = ANB_blob_create(256);
+    size_t expect = 0;
+    uint8_t msg[100];
+    for (int i = 0; i < SLICE_ROUNDS; i++) {
+        // A new payload each round; every thread gets its own reference
+        memset(msg, i, sizeof(msg));
+        ANB_blob_reset(b);
+        ANB_blob_push(b, msg, sizeof(msg));
+        ANB_BlobSlice_t s;
+        TEST_ASSERT_EQUAL_INT(0, ANB_blob_slice(b, 0, sizeof(msg), &s));
+        for (int t = 0; t < SLICE_THREADS; t++) ANB_blob_slice_sub(&s, 0, sizeof(msg), &work[t].slices[i]);
+        ANB_blob_slice_release(&s);
+        expect += (size_t)(i & 0xFF) * sizeof(msg);
+    }
+    ANB_blob_destroy(b);
+
+    pthread_t th[SLICE_THREADS];
+    for (int t = 0; t < SLICE_THREADS; t++) {
+        work[t].sum = 0;
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&th[t], NULL, slice_reader, &work[t]));
+    }
+    for (int t = 0; t < SLICE_THREADS; t++) {
+        pthread_join(th[t], NULL);
+        TEST_ASSERT_EQUAL_size_t(expect, work[t].sum);
+    }
+}
@@ -0,0 +1,237 @@
+#include "unity.h"
+#include "anb.hpp"
+#include "anb_pmr.hpp"
+#include <algorithm>
+#include <cstring>
+#include <ranges>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <utility>
+
+static_assert(std::ranges::forward_range<anb::Slab>);
+static_assert(std::ranges::forward_range<anb::TypedSlab<int>>);
+static_assert(std::ranges::contiguous_range<anb::Blob>);
+static_assert(!std::is_copy_constructible_v<anb::Slab>);
+static_assert(std::is_nothrow_move_constructible_v<anb::Slab>);
+static_assert(std::is_nothrow_move_constructible_v<anb::Blob>);
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/* ------------------------------------------------------------------ */
+/* 1. Slab push / range-for / pop                                     */
+/* ------------------------------------------------------------------ */
+void test_cpp_slab_iterate(void) {
+    anb::Slab s(64);
+    const char *words[] = {"alpha", "beta", "gamma"};
+    for (const char *w : words) s.push(w, std::strlen(w) + 1);
+
+    TEST_ASSERT_EQUAL_size_t(3, s.size());
+    size_t i = 0;
+    for (anb::Item it : s) {
+        TEST_ASSERT_EQUAL_STRING(words[i], (const char *)it.data);
+        TEST_ASSERT_EQUAL_size_t(std::strlen(words[i]) + 1, it.size);
+        i++;
+    }
+    TEST_ASSERT_EQUAL_size_t(3, i);
+    TEST_ASSERT_EQUAL_INT(3, std::ranges::distance(s));
+
+    TEST_ASSERT_TRUE(s.pop());
+    TEST_ASSERT_EQUAL_STRING("beta", (const char *)(*s.begin()).data);
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Pop through an iterator while walking                           */
+/* ------------------------------------------------------------------ */
+void test_cpp_slab_pop_iter(void) {
+    anb::Slab s(64);
+    for (int v = 0; v < 10; v++) s.push(&v, sizeof v);
+
+    for (auto it = s.begin(); it != s.end(); ++it) {
+        int v;
+        std::memcpy(&v, (*it).data, sizeof v);
+        if (v % 2) s.pop(it);
+    }
+    TEST_ASSERT_EQUAL_size_t(5, s.size());
+    int expect = 0;
+    for (anb::Item it : s) {
+        int v;
+        std::memcpy(&v, it.data, sizeof v);
+        TEST_ASSERT_EQUAL_INT(expect, v);
+        expect += 2;
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. Move-only ownership                                             */
+/* ------------------------------------------------------------------ */
+void test_cpp_move(void) {
+    anb::Slab a(64);
+    a.push("x", 2);
+    anb::Slab b = std::move(a);
+    TEST_ASSERT_FALSE((bool)a);
+    TEST_ASSERT_EQUAL_size_t(1, b.size());
+
+    ANB_Slab_t *raw = b.release();
+    anb::Slab c = anb::Slab::adopt(raw);
+    TEST_ASSERT_EQUAL_PTR(raw, c.get());
+
+    anb::Blob x(16);
+    x.push("abc", 3);
+    anb::Blob y(8);
+    y = std::move(x);
+    TEST_ASSERT_EQUAL_size_t(3, y.size());
+    TEST_ASSERT_EQUAL_MEMORY("abc", y.data(), 3);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. TypedSlab emplace / iterate / destroy                           */
+/* ------------------------------------------------------------------ */
+struct Point {
+    double x, y;
+    Point(double x_, double y_) : x(x_), y(y_) {}
+};
+
+void test_cpp_typed_emplace(void) {
+    anb::TypedSlab<Point> pts(2);
+    for (int i = 0; i < 100; i++) pts.emplace(i, -i);
+
+    TEST_ASSERT_EQUAL_size_t(100, pts.size());
+    int i = 0;
+    for (Point &p : pts) {
+        TEST_ASSERT_EQUAL_DOUBLE(i, p.x);
+        TEST_ASSERT_EQUAL_DOUBLE(-i, p.y);
+        i++;
+    }
+    auto it = std::ranges::find_if(pts, [](const Point &p) { return p.x == 42; });
+    TEST_ASSERT_TRUE(it != pts.end());
+    TEST_ASSERT_EQUAL_DOUBLE(-42, it->y);
+
+    TEST_ASSERT_TRUE(pts.pop());
+    TEST_ASSERT_EQUAL_DOUBLE(1, pts.front().x);
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. TypedSlab runs destructors on pop and on destruction            */
+/* ------------------------------------------------------------------ */
+struct Counted {
+    static int live;
+    int v;
+    explicit Counted(int v_) : v(v_) { live++; }
+    ~Counted() { live--; }
+};
+int Counted::live = 0;
+
+template <>
+struct anb::is_relocatable<Counted> : std::true_type {};
+
+void test_cpp_typed_destructors(void) {
+    {
+        anb::TypedSlab<Counted> s(1);
+        for (int i = 0; i < 20; i++) s.emplace(i);
+        TEST_ASSERT_EQUAL_INT(20, Counted::live);
+
+        auto it = s.begin();
+        ++it;
+        s.pop(it);
+        s.pop();
+        TEST_ASSERT_EQUAL_INT(18, Counted::live);
+        TEST_ASSERT_EQUAL_INT(2, s.front().v);
+    }
+    TEST_ASSERT_EQUAL_INT(0, Counted::live);
+}
+
+/* ------------------------------------------------------------------ */
+/* 6. Blob as a contiguous byte range                                 */
+/* ------------------------------------------------------------------ */
+void test_cpp_blob_range(void) {
+    anb::Blob b(4);
+    std::string_view s = "hello, world";
+    b.push(s.data(), s.size());
+
+    TEST_ASSERT_EQUAL_size_t(s.size(), b.size());
+    TEST_ASSERT_TRUE(std::ranges::equal(b, s, [](std::uint8_t a, char c) { return a == (std::uint8_t)c; }));
+    TEST_ASSERT_EQUAL_size_t(s.size(), b.bytes().size());
+
+    auto tail = b.reserve(64);
+    TEST_ASSERT_TRUE(tail.size() >= 64);
+    std::memcpy(tail.data(), "!!", 2);
+    b.commit(2);
+    TEST_ASSERT_EQUAL_size_t(s.size() + 2, b.size());
+    TEST_ASSERT_EQUAL_MEMORY("hello, world!!", b.data(), s.size() + 2);
+
+    b.reset();
+    TEST_ASSERT_TRUE(b.empty());
+    TEST_ASSERT_TRUE(b.capacity() >= s.size());
+}
+
+/* ------------------------------------------------------------------ */
+/* 7. pmr containers on a SlabResource, released in one shot          */
+/* ------------------------------------------------------------------ */
+void test_cpp_slab_resource(void) {
+    anb::SlabResource res(256);
+
+    for (int round = 0; round < 3; round++) {
+        {
+            std::pmr::vector<int> v(&res);
+            std::pmr::unordered_map<int, std::pmr::string> m(&res);
+            for (int i = 0; i < 200; i++) {
+                v.push_back(i);
+                m.emplace(i, std::pmr::string(40, (char)('a' + i % 26), &res));
+            }
+            TEST_ASSERT_EQUAL_INT(199, v.back());
+            TEST_ASSERT_EQUAL_INT('a' + 150 % 26, m.at(150)[39]);
+            TEST_ASSERT_TRUE(res.bytes_used() > 0);
+        }
+        if (round > 0) TEST_ASSERT_EQUAL_size_t(1, res.slab_count());
+        res.release();
+        TEST_ASSERT_EQUAL_size_t(0, res.bytes_used());
+    }
+
+    void *p = res.allocate(100, 256);
+    TEST_ASSERT_EQUAL_size_t(0, (std::uintptr_t)p % 256);
+}
+
+/* ------------------------------------------------------------------ */
+/* 8. SlabPoolResource recycles blocks and falls back upstream        */
+/* ------------------------------------------------------------------ */
+void test_cpp_slab_pool_resource(void) {
+    anb::SlabPoolResource pool(48, 4);
+    TEST_ASSERT_EQUAL_size_t(48, pool.block_size());
+
+    void *a[4];
+    for (auto &p : a) p = pool.allocate(40);
+    for (int i = 1; i < 4; i++) TEST_ASSERT_EQUAL_PTR((char *)a[0] + 48 * i, a[i]);
+
+    void *big = pool.allocate(1000);
+    void *extra = pool.allocate(16);
+    TEST_ASSERT_TRUE(extra < a[0] || extra > a[3]);
+    pool.deallocate(big, 1000);
+    pool.deallocate(extra, 16);
+
+    pool.deallocate(a[2], 40);
+    TEST_ASSERT_EQUAL_PTR(a[2], pool.allocate(8));
+
+    pool.release();
+    TEST_ASSERT_EQUAL_PTR(a[0], pool.allocate(48));
+
+    std::pmr::polymorphic_allocator<int> alloc(&pool);
+    int *x = alloc.allocate(1);
+    alloc.deallocate(x, 1);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_cpp_slab_iterate);
+    RUN_TEST(test_cpp_slab_pop_iter);
+    RUN_TEST(test_cpp_move);
+    RUN_TEST(test_cpp_typed_emplace);
+    RUN_TEST(test_cpp_typed_destructors);
+    RUN_TEST(test_cpp_blob_range);
+    RUN_TEST(test_cpp_slab_resource);
+    RUN_TEST(test_cpp_slab_pool_resource);
+    return UNITY_END();
+}
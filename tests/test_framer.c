@@ -0,0 +1,248 @@
+#include "unity.h"
+#include "framer.h"
+#include <errno.h>
+#include <string.h>
+
+static size_t framer_unread(ANB_Blob_t *b) {
+    size_t len;
+    ANB_blob_peek(b, &len);
+    return len;
+}
+
+// Pop every item of q into out as "payload|payload|..."; returns the item count
+static size_t framer_drain(ANB_Slab_t *q, char *out) {
+    size_t count = 0, n;
+    uint8_t *p;
+    out[0] = '\0';
+    for (;;) {
+        ANB_SlabIter_t it = {0};
+        if ((p = ANB_slab_peek_item_iter(q, &it, &n)) == NULL) break;
+        if (count) strcat(out, "|");
+        strncat(out, (const char *)p, n);
+        ANB_slab_pop_item(q, NULL);
+        count++;
+    }
+    return count;
+}
+
+/* ------------------------------------------------------------------ */
+/* 1. Length prefixes of every width and byte order, fed bytewise     */
+/* ------------------------------------------------------------------ */
+void test_framer_length(void) {
+    static const unsigned widths[] = {1, 2, 4};
+    for (unsigned w = 0; w < 3; w++) {
+        for (int be = 0; be < 2; be++) {
+            ANB_FrameSpec_t spec = {0};
+            spec.mode = ANB_FRAME_LENGTH;
+            spec.prefix_bytes = widths[w];
+            spec.big_endian = be;
+            ANB_Framer_t *f = ANB_framer_create(&spec);
+            ANB_Blob_t *in = ANB_blob_create(64);
+            ANB_Slab_t *out = ANB_slab_create(256);
+
+            // "abc", an empty frame, then "hello"
+            uint8_t wire[32];
+            size_t n = 0;
+            const char *payloads[] = {"abc", "", "hello"};
+            for (int i = 0; i < 3; i++) {
+                size_t len = strlen(payloads[i]);
+                for (unsigned b = 0; b < widths[w]; b++) {
+                    unsigned shift = be ? 8 * (widths[w] - 1 - b) : 8 * b;
+                    wire[n++] = (uint8_t)(len >> shift);
+                }
+                memcpy(wire + n, payloads[i], len);
+                n += len;
+            }
+
+            // One byte per call: partial prefixes and payloads carry over
+            ssize_t frames = 0;
+            for (size_t i = 0; i < n; i++) {
+                ANB_blob_push(in, wire + i, 1);
+                ssize_t r = ANB_framer_run(f, in, out);
+                TEST_ASSERT_TRUE(r >= 0);
+                frames += r;
+            }
+            TEST_ASSERT_EQUAL_INT(3, (int)frames);
+            TEST_ASSERT_EQUAL_size_t(0, framer_unread(in));
+
+            char got[64];
+            TEST_ASSERT_EQUAL_size_t(3, framer_drain(out, got));
+            TEST_ASSERT_EQUAL_STRING("abc||hello", got);
+
+            ANB_slab_destroy(out);
+            ANB_blob_destroy(in);
+            ANB_framer_destroy(f);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Delimiter split across pushes; delimiter bytes are not copied   */
+/* ------------------------------------------------------------------ */
+void test_framer_delimiter(void) {
+    char delim[] = "\r\n";
+    ANB_FrameSpec_t spec = {0};
+    spec.mode = ANB_FRAME_DELIMITER;
+    spec.delim = (const uint8_t *)delim;
+    spec.delim_len = 2;
+    ANB_Framer_t *f = ANB_framer_create(&spec);
+    delim[0] = 'x';              // the framer keeps its own copy
+
+    ANB_Blob_t *in = ANB_blob_create(64);
+    ANB_Slab_t *out = ANB_slab_create(256);
+    char got[128];
+
+    ANB_blob_push(in, (const uint8_t *)"GET / HTTP/1.1\r", 15);
+    TEST_ASSERT_EQUAL_INT(0, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_size_t(15, framer_unread(in));
+
+    ANB_blob_push(in, (const uint8_t *)"\nHost: x\r\n\r\nte", 14);
+    TEST_ASSERT_EQUAL_INT(3, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_size_t(2, framer_unread(in));
+    TEST_ASSERT_EQUAL_size_t(3, framer_drain(out, got));
+    TEST_ASSERT_EQUAL_STRING("GET / HTTP/1.1|Host: x|", got);
+
+    // A lone CR inside a frame is payload
+    ANB_blob_push(in, (const uint8_t *)"st\rok", 5);
+    TEST_ASSERT_EQUAL_INT(0, (int)ANB_framer_run(f, in, out));
+    ANB_blob_push(in, (const uint8_t *)"\r\n", 2);
+    TEST_ASSERT_EQUAL_INT(1, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_size_t(1, framer_drain(out, got));
+    TEST_ASSERT_EQUAL_STRING("test\rok", got);
+
+    // After a reset behind the framer's back
+    ANB_blob_push(in, (const uint8_t *)"zzzzzzzz", 8);
+    TEST_ASSERT_EQUAL_INT(0, (int)ANB_framer_run(f, in, out));
+    ANB_blob_reset(in);
+    ANB_framer_reset(f);
+    ANB_blob_push(in, (const uint8_t *)"a\r\n", 3);
+    TEST_ASSERT_EQUAL_INT(1, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_size_t(1, framer_drain(out, got));
+    TEST_ASSERT_EQUAL_STRING("a", got);
+
+    ANB_slab_destroy(out);
+    ANB_blob_destroy(in);
+    ANB_framer_destroy(f);
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. Fixed-size frames leave the remainder unread                    */
+/* ------------------------------------------------------------------ */
+void test_framer_fixed(void) {
+    ANB_FrameSpec_t spec = {0};
+    spec.mode = ANB_FRAME_FIXED;
+    spec.frame_size = 4;
+    ANB_Framer_t *f = ANB_framer_create(&spec);
+    ANB_Blob_t *in = ANB_blob_create(64);
+    ANB_Slab_t *out = ANB_slab_create(256);
+    char got[64];
+
+    ANB_blob_push(in, (const uint8_t *)"aaaabbbbcc", 10);
+    TEST_ASSERT_EQUAL_INT(2, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_size_t(2, framer_unread(in));
+    ANB_blob_push(in, (const uint8_t *)"cc", 2);
+    TEST_ASSERT_EQUAL_INT(1, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_INT(0, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_size_t(3, framer_drain(out, got));
+    TEST_ASSERT_EQUAL_STRING("aaaa|bbbb|cccc", got);
+
+    ANB_slab_destroy(out);
+    ANB_blob_destroy(in);
+    ANB_framer_destroy(f);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Oversized frames fail with EMSGSIZE after the good ones         */
+/* ------------------------------------------------------------------ */
+void test_framer_max_frame(void) {
+    ANB_FrameSpec_t spec = {0};
+    spec.mode = ANB_FRAME_LENGTH;
+    spec.prefix_bytes = 2;
+    spec.big_endian = 1;
+    spec.max_frame = 8;
+    ANB_Framer_t *f = ANB_framer_create(&spec);
+    ANB_Blob_t *in = ANB_blob_create(64);
+    ANB_Slab_t *out = ANB_slab_create(256);
+
+    // The prefix alone is enough to reject the second frame
+    ANB_blob_push(in, (const uint8_t *)"\x00\x02hi\x00\x09", 6);
+    TEST_ASSERT_EQUAL_INT(1, (int)ANB_framer_run(f, in, out));
+    errno = 0;
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_INT(EMSGSIZE, errno);
+    TEST_ASSERT_EQUAL_size_t(2, framer_unread(in));
+    TEST_ASSERT_EQUAL_size_t(1, ANB_slab_item_count(out));
+    ANB_framer_destroy(f);
+
+    // Delimiter mode: no terminator within max_frame + delim_len bytes
+    spec.mode = ANB_FRAME_DELIMITER;
+    spec.delim = (const uint8_t *)"\n";
+    spec.delim_len = 1;
+    spec.max_frame = 4;
+    f = ANB_framer_create(&spec);
+    ANB_blob_reset(in);
+    ANB_blob_push(in, (const uint8_t *)"abcd", 4);
+    TEST_ASSERT_EQUAL_INT(0, (int)ANB_framer_run(f, in, out));
+    ANB_blob_push(in, (const uint8_t *)"\n", 1);
+    TEST_ASSERT_EQUAL_INT(1, (int)ANB_framer_run(f, in, out));
+    ANB_blob_push(in, (const uint8_t *)"abcde", 5);
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_INT(EMSGSIZE, errno);
+    ANB_blob_reset(in);
+    ANB_framer_reset(f);
+    ANB_blob_push(in, (const uint8_t *)"abcde\n", 6);
+    TEST_ASSERT_EQUAL_INT(-1, (int)ANB_framer_run(f, in, out));
+    TEST_ASSERT_EQUAL_INT(EMSGSIZE, errno);
+    TEST_ASSERT_EQUAL_size_t(2, ANB_slab_item_count(out));
+
+    ANB_slab_destroy(out);
+    ANB_blob_destroy(in);
+    ANB_framer_destroy(f);
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. Full caller storage: ENOBUFS, then resume after popping         */
+/* ------------------------------------------------------------------ */
+void test_framer_full_slab(void) {
+    ANB_FrameSpec_t spec = {0};
+    spec.mode = ANB_FRAME_FIXED;
+    spec.frame_size = 64;
+    ANB_Framer_t *f = ANB_framer_create(&spec);
+    ANB_Blob_t *in = ANB_blob_create(64);
+    _Alignas(max_align_t) static uint8_t storage[1024];
+    ANB_Slab_t *out = ANB_slab_init_in(storage, sizeof(storage), 0);
+    TEST_ASSERT_NOT_NULL(out);
+
+    uint8_t frame[64];
+    for (unsigned i = 0; i < 64; i++) {
+        memset(frame, (int)i, sizeof(frame));
+        ANB_blob_push(in, frame, sizeof(frame));
+    }
+
+    unsigned next = 0, rounds = 0;
+    while (next < 64) {
+        ssize_t r = ANB_framer_run(f, in, out);
+        if (r < 0) {
+            TEST_ASSERT_EQUAL_INT(ENOBUFS, errno);
+            TEST_ASSERT_TRUE(ANB_slab_item_count(out) > 0);
+        }
+        TEST_ASSERT_EQUAL_size_t((64 - next - ANB_slab_item_count(out)) * 64, framer_unread(in));
+        size_t n;
+        uint8_t *p;
+        for (;;) {
+            ANB_SlabIter_t it = {0};
+            if ((p = ANB_slab_peek_item_iter(out, &it, &n)) == NULL) break;
+            TEST_ASSERT_EQUAL_size_t(64, n);
+            TEST_ASSERT_EQUAL_UINT8(next, p[0]);
+            TEST_ASSERT_EQUAL_UINT8(next, p[63]);
+            ANB_slab_pop_item(out, NULL);
+            next++;
+        }
+        rounds++;
+    }
+    TEST_ASSERT_TRUE(rounds > 1);
+    TEST_ASSERT_EQUAL_size_t(0, framer_unread(in));
+
+    ANB_blob_destroy(in);
+    ANB_framer_destroy(f);
+}
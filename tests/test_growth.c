@@ -0,0 +1,122 @@
+#include "unity.h"
+#include "growth.h"
+#include "slab.h"
+#include "blob.h"
+#include <string.h>
+#include <stddef.h>
+
+/* ------------------------------------------------------------------ */
+/* 1. Default policy doubles until the requirement is met             */
+/* ------------------------------------------------------------------ */
+void test_growth_default_doubles(void) {
+    TEST_ASSERT_EQUAL_size_t(64, ANB_growth_next(NULL, 64, 10));
+    TEST_ASSERT_EQUAL_size_t(128, ANB_growth_next(NULL, 64, 65));
+    TEST_ASSERT_EQUAL_size_t(512, ANB_growth_next(NULL, 64, 300));
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Exact fit grows only to the required size                       */
+/* ------------------------------------------------------------------ */
+void test_growth_exact_fit(void) {
+    ANB_GrowthPolicy_t p = ANB_GROWTH_EXACT;
+    TEST_ASSERT_EQUAL_size_t(65, ANB_growth_next(&p, 64, 65));
+    TEST_ASSERT_EQUAL_size_t(1000, ANB_growth_next(&p, 64, 1000));
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. Per-step cap bounds growth of huge buffers                      */
+/* ------------------------------------------------------------------ */
+void test_growth_max_step(void) {
+    ANB_GrowthPolicy_t p = { 200, 1024, 0, NULL, NULL };
+    /* Small buffers still double */
+    TEST_ASSERT_EQUAL_size_t(512, ANB_growth_next(&p, 256, 257));
+    /* Large buffers add at most one capped step */
+    TEST_ASSERT_EQUAL_size_t(8192 + 1024, ANB_growth_next(&p, 8192, 8193));
+    /* A requirement beyond one step jumps straight to it */
+    TEST_ASSERT_EQUAL_size_t(20000, ANB_growth_next(&p, 8192, 20000));
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Rounding to page size                                           */
+/* ------------------------------------------------------------------ */
+void test_growth_round(void) {
+    ANB_GrowthPolicy_t p = { 150, 0, ANB_GROWTH_ROUND_PAGE, NULL, NULL };
+    TEST_ASSERT_EQUAL_size_t(4096, ANB_growth_next(&p, 100, 101));
+    TEST_ASSERT_EQUAL_size_t(8192, ANB_growth_next(&p, 4096, 4097));
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. Custom growth function                                          */
+/* ------------------------------------------------------------------ */
+static size_t grow_plus_ctx(void *ctx, size_t current, size_t required) {
+    size_t add = *(size_t *)ctx;
+    (void)current;
+    return required + add;
+}
+
+typedef struct {
+    size_t last;    /* Capacity handed out by the previous call */
+    size_t calls;
+    int broken;     /* Set when a call did not continue from the previous capacity */
+} GrowChain_t;
+
+static size_t grow_chain(void *ctx, size_t current, size_t required) {
+    GrowChain_t *c = (GrowChain_t *)ctx;
+    if (current != c->last) c->broken = 1;
+    c->calls++;
+    c->last = required;
+    return required;
+}
+
+void test_growth_custom_fn(void) {
+    size_t add = 7;
+    ANB_GrowthPolicy_t p = { 0, 0, 0, grow_plus_ctx, &add };
+    TEST_ASSERT_EQUAL_size_t(107, ANB_growth_next(&p, 50, 100));
+
+    /* A slab only asks about its data buffer: every call continues from the last data capacity */
+    GrowChain_t chain = { 16, 0, 0 };
+    ANB_GrowthPolicy_t cp = { 0, 0, 0, grow_chain, &chain };
+    ANB_Slab_t *q = ANB_slab_create(16);
+    ANB_slab_set_growth(q, &cp);
+    uint8_t buf[16] = {0};
+    for (size_t i = 0; i < 1000; i++) ANB_slab_push_item(q, buf, 1);
+    TEST_ASSERT_FALSE(chain.broken);
+    TEST_ASSERT_EQUAL_size_t(999, chain.calls);
+    TEST_ASSERT_EQUAL_size_t(1000 * _Alignof(max_align_t), chain.last);
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 6. Slab and blob honor their configured policy                     */
+/* ------------------------------------------------------------------ */
+void test_growth_slab_blob_policy(void) {
+    ANB_GrowthPolicy_t exact = ANB_GROWTH_EXACT;
+    uint8_t buf[100];
+    memset(buf, 0x5A, sizeof(buf));
+
+    ANB_Blob_t *b = ANB_blob_create(16);
+    ANB_blob_set_growth(b, &exact);
+    ANB_blob_push(b, buf, 100);
+    TEST_ASSERT_EQUAL_size_t(100, ANB_blob_capacity(b));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buf, ANB_blob_data(b), 100);
+    ANB_blob_destroy(b);
+
+    /* Slab with exact fit: many pushes still grow index and data correctly */
+    ANB_Slab_t *q = ANB_slab_create(16);
+    ANB_slab_set_growth(q, &exact);
+    for (size_t i = 0; i < 200; i++) {
+        ANB_slab_push_item(q, buf, 1 + (i % 100));
+    }
+    TEST_ASSERT_EQUAL_size_t(200, ANB_slab_item_count(q));
+
+    ANB_SlabIter_t iter = {0};
+    size_t sz, i = 0;
+    uint8_t *data;
+    while ((data = ANB_slab_peek_item_iter(q, &iter, &sz)) != NULL) {
+        TEST_ASSERT_EQUAL_size_t(1 + (i % 100), sz);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(buf, data, sz);
+        i++;
+    }
+    TEST_ASSERT_EQUAL_size_t(200, i);
+    ANB_slab_destroy(q);
+}
@@ -0,0 +1,144 @@
+#include "unity.h"
+#include "ring.h"
+#include <pthread.h>
+#include <string.h>
+#include <stddef.h>
+
+/* ------------------------------------------------------------------ */
+/* 1. Create rounds capacity and starts empty                         */
+/* ------------------------------------------------------------------ */
+void test_ring_create(void) {
+    ANB_Ring_t *r = ANB_ring_create(5000);
+    size_t cap = ANB_ring_capacity(r);
+    TEST_ASSERT_TRUE(cap >= 5000);
+    TEST_ASSERT_EQUAL_size_t(0, cap & (cap - 1));
+    TEST_ASSERT_EQUAL_size_t(0, ANB_ring_data_len(r));
+
+    size_t avail;
+    TEST_ASSERT_NOT_NULL(ANB_ring_reserve(r, cap, &avail));
+    TEST_ASSERT_EQUAL_size_t(cap, avail);
+    TEST_ASSERT_NULL(ANB_ring_reserve(r, cap + 1, &avail));
+
+    ANB_ring_destroy(r);
+    ANB_ring_destroy(NULL);
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Both halves are the same memory                                 */
+/* ------------------------------------------------------------------ */
+void test_ring_double_mapped(void) {
+    ANB_Ring_t *r = ANB_ring_create(1);
+    size_t cap = ANB_ring_capacity(r);
+    uint8_t *w = ANB_ring_reserve(r, 0, NULL);
+
+    w[0] = 0x11;
+    TEST_ASSERT_EQUAL_UINT8(0x11, w[cap]);
+    w[cap + 7] = 0x22;
+    TEST_ASSERT_EQUAL_UINT8(0x22, w[7]);
+
+    ANB_ring_destroy(r);
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. Windows stay contiguous across the wrap point                   */
+/* ------------------------------------------------------------------ */
+void test_ring_wraparound(void) {
+    ANB_Ring_t *r = ANB_ring_create(1);
+    size_t cap = ANB_ring_capacity(r);
+
+    /* Move the cursors close to the end of the buffer */
+    size_t avail;
+    ANB_ring_reserve(r, cap - 10, &avail);
+    ANB_ring_commit(r, cap - 10);
+    ANB_ring_consume(r, cap - 10);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_ring_data_len(r));
+
+    /* A 100-byte write crosses the wrap as one window */
+    uint8_t src[100];
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)(i + 1);
+    uint8_t *w = ANB_ring_reserve(r, sizeof(src), &avail);
+    TEST_ASSERT_EQUAL_size_t(cap, avail);
+    memcpy(w, src, sizeof(src));
+    ANB_ring_commit(r, sizeof(src));
+
+    size_t len;
+    uint8_t *p = ANB_ring_peek(r, &len);
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), len);
+    TEST_ASSERT_EQUAL_PTR(w, p);
+    TEST_ASSERT_EQUAL_MEMORY(src, p, sizeof(src));
+
+    /* Consuming past the wrap lands at the start of the buffer */
+    ANB_ring_consume(r, 10);
+    p = ANB_ring_peek(r, &len);
+    TEST_ASSERT_EQUAL_size_t(90, len);
+    TEST_ASSERT_EQUAL_UINT8(11, p[0]);
+    TEST_ASSERT_TRUE(p < w);
+
+    ANB_ring_destroy(r);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Push fails when full, reset empties                             */
+/* ------------------------------------------------------------------ */
+void test_ring_full(void) {
+    ANB_Ring_t *r = ANB_ring_create(1);
+    size_t cap = ANB_ring_capacity(r);
+    uint8_t chunk[64];
+    memset(chunk, 0xAB, sizeof(chunk));
+
+    size_t pushed = 0;
+    while (ANB_ring_push(r, chunk, sizeof(chunk)) == 0) pushed += sizeof(chunk);
+    TEST_ASSERT_EQUAL_size_t(cap, pushed);
+    TEST_ASSERT_EQUAL_size_t(cap, ANB_ring_data_len(r));
+
+    ANB_ring_consume(r, 64);
+    TEST_ASSERT_EQUAL_INT(0, ANB_ring_push(r, chunk, sizeof(chunk)));
+    TEST_ASSERT_EQUAL_INT(-1, ANB_ring_push(r, chunk, 1));
+
+    ANB_ring_reset(r);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_ring_data_len(r));
+    ANB_ring_destroy(r);
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. One producer and one consumer thread                            */
+/* ------------------------------------------------------------------ */
+#define RING_SPSC_TOTAL (4u * 1024 * 1024)
+
+static void *ring_producer(void *arg) {
+    ANB_Ring_t *r = (ANB_Ring_t *)arg;
+    uint32_t next = 0;
+    while (next < RING_SPSC_TOTAL) {
+        size_t avail;
+        uint8_t *w = ANB_ring_reserve(r, 0, &avail);
+        size_t n = avail / 4;
+        if (n > RING_SPSC_TOTAL - next) n = RING_SPSC_TOTAL - next;
+        for (size_t i = 0; i < n; i++, next++) memcpy(w + 4 * i, &next, 4);
+        ANB_ring_commit(r, n * 4);
+    }
+    return NULL;
+}
+
+void test_ring_spsc(void) {
+    ANB_Ring_t *r = ANB_ring_create(4096);
+    pthread_t t;
+    pthread_create(&t, NULL, ring_producer, r);
+
+    uint32_t expect = 0;
+    int ok = 1;
+    while (expect < RING_SPSC_TOTAL) {
+        size_t len;
+        uint8_t *p = ANB_ring_peek(r, &len);
+        len &= ~(size_t)3;
+        for (size_t i = 0; i < len; i += 4, expect++) {
+            uint32_t v;
+            memcpy(&v, p + i, 4);
+            if (v != expect) ok = 0;
+        }
+        ANB_ring_consume(r, len);
+    }
+    pthread_join(t, NULL);
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_ring_data_len(r));
+    ANB_ring_destroy(r);
+}
@@ -0,0 +1,191 @@
+#include "unity.h"
+#include "rope.h"
+#include <string.h>
+#include <unistd.h>
+
+static void rope_fill(uint8_t *buf, size_t len, uint8_t seed) {
+    for (size_t i = 0; i < len; i++) buf[i] = (uint8_t)(seed + i * 7);
+}
+
+/* ------------------------------------------------------------------ */
+/* 1. Push spreads over segments; iteration sees every byte in order  */
+/* ------------------------------------------------------------------ */
+void test_rope_push_iter(void) {
+    ANB_Rope_t *r = ANB_rope_create(16);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_rope_segment_count(r));
+
+    uint8_t src[100];
+    rope_fill(src, sizeof(src), 1);
+    ANB_rope_push(r, src, 10);
+    ANB_rope_push(r, src + 10, 90);
+    TEST_ASSERT_EQUAL_size_t(100, ANB_rope_data_len(r));
+    TEST_ASSERT_EQUAL_size_t(7, ANB_rope_segment_count(r));
+
+    uint8_t out[100];
+    size_t off = 0, n;
+    int segs = 0;
+    ANB_RopeIter_t it = {0};
+    uint8_t *p;
+    while ((p = ANB_rope_segment_iter(r, &it, &n)) != NULL) {
+        TEST_ASSERT_TRUE(n <= 16);
+        memcpy(out + off, p, n);
+        off += n;
+        segs++;
+    }
+    TEST_ASSERT_EQUAL_INT(7, segs);
+    TEST_ASSERT_EQUAL_size_t(100, off);
+    TEST_ASSERT_EQUAL_MEMORY(src, out, 100);
+
+    /* A finished iterator picks up segments linked afterwards */
+    ANB_rope_push(r, src, 20);
+    p = ANB_rope_segment_iter(r, &it, &n);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_EQUAL_size_t(8, n);
+    TEST_ASSERT_EQUAL_MEMORY(src + 12, p, 8);
+
+    ANB_rope_destroy(r);
+    ANB_rope_destroy(NULL);
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Reserve/commit writes in place; large reserves get own segment  */
+/* ------------------------------------------------------------------ */
+void test_rope_reserve_commit(void) {
+    ANB_Rope_t *r = ANB_rope_create(64);
+    size_t avail;
+    uint8_t *w = ANB_rope_reserve(r, 0, &avail);
+    TEST_ASSERT_EQUAL_size_t(64, avail);
+    memcpy(w, "abc", 3);
+    ANB_rope_commit(r, 3);
+
+    w = ANB_rope_reserve(r, 10, &avail);
+    TEST_ASSERT_EQUAL_size_t(61, avail);
+    TEST_ASSERT_EQUAL_size_t(1, ANB_rope_segment_count(r));
+    ANB_rope_commit(r, 0);
+
+    /* Does not fit the remaining 61 bytes: a segment sized to the request */
+    w = ANB_rope_reserve(r, 200, &avail);
+    TEST_ASSERT_EQUAL_size_t(200, avail);
+    TEST_ASSERT_EQUAL_size_t(2, ANB_rope_segment_count(r));
+    memset(w, 'x', 200);
+    ANB_rope_commit(r, 200);
+    TEST_ASSERT_EQUAL_size_t(203, ANB_rope_data_len(r));
+
+    uint8_t out[203];
+    TEST_ASSERT_EQUAL_size_t(203, ANB_rope_copy_out(r, 0, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY("abc", out, 3);
+    TEST_ASSERT_EQUAL_UINT8('x', out[202]);
+
+    ANB_rope_destroy(r);
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. iovec export drives writev; consume frees read segments         */
+/* ------------------------------------------------------------------ */
+void test_rope_iovec_consume(void) {
+    ANB_Rope_t *r = ANB_rope_create(32);
+    uint8_t src[100];
+    rope_fill(src, sizeof(src), 3);
+    ANB_rope_push(r, src, sizeof(src));
+
+    struct iovec iov[8];
+    TEST_ASSERT_EQUAL_INT(2, ANB_rope_iovec(r, iov, 2));
+    int cnt = ANB_rope_iovec(r, iov, 8);
+    TEST_ASSERT_EQUAL_INT(4, cnt);
+
+    int p[2];
+    TEST_ASSERT_EQUAL_INT(0, pipe(p));
+    ssize_t w = writev(p[1], iov, cnt);
+    TEST_ASSERT_EQUAL_INT(100, (int)w);
+    uint8_t got[100];
+    TEST_ASSERT_EQUAL_INT(100, (int)read(p[0], got, sizeof(got)));
+    TEST_ASSERT_EQUAL_MEMORY(src, got, 100);
+    close(p[0]);
+    close(p[1]);
+
+    /* Partial consume mid-segment, then across a boundary */
+    ANB_rope_consume(r, 40);
+    TEST_ASSERT_EQUAL_size_t(3, ANB_rope_segment_count(r));
+    cnt = ANB_rope_iovec(r, iov, 8);
+    TEST_ASSERT_EQUAL_INT(3, cnt);
+    TEST_ASSERT_EQUAL_size_t(24, iov[0].iov_len);
+    TEST_ASSERT_EQUAL_MEMORY(src + 40, iov[0].iov_base, 24);
+
+    uint8_t out[10];
+    TEST_ASSERT_EQUAL_size_t(10, ANB_rope_copy_out(r, 20, out, 10));
+    TEST_ASSERT_EQUAL_MEMORY(src + 60, out, 10);
+    TEST_ASSERT_EQUAL_size_t(5, ANB_rope_copy_out(r, 55, out, 10));
+    TEST_ASSERT_EQUAL_size_t(0, ANB_rope_copy_out(r, 60, out, 10));
+
+    /* Consuming everything keeps one segment for the next write */
+    ANB_rope_consume(r, 60);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_rope_data_len(r));
+    TEST_ASSERT_EQUAL_size_t(1, ANB_rope_segment_count(r));
+    TEST_ASSERT_EQUAL_INT(0, ANB_rope_iovec(r, iov, 8));
+    ANB_RopeIter_t it = {0};
+    TEST_ASSERT_NULL(ANB_rope_segment_iter(r, &it, NULL));
+
+    ANB_rope_push(r, src, 5);
+    TEST_ASSERT_EQUAL_size_t(1, ANB_rope_segment_count(r));
+    TEST_ASSERT_EQUAL_size_t(5, ANB_rope_copy_out(r, 0, out, 10));
+    TEST_ASSERT_EQUAL_MEMORY(src, out, 5);
+
+    ANB_rope_destroy(r);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Flatten copies only when the bytes span several segments        */
+/* ------------------------------------------------------------------ */
+void test_rope_flatten(void) {
+    ANB_Rope_t *r = ANB_rope_create(32);
+    size_t len;
+    TEST_ASSERT_NULL(ANB_rope_flatten(r, &len));
+    TEST_ASSERT_EQUAL_size_t(0, len);
+
+    uint8_t src[200];
+    rope_fill(src, sizeof(src), 9);
+    ANB_rope_push(r, src, 20);
+    ANB_RopeIter_t it = {0};
+    uint8_t *first = ANB_rope_segment_iter(r, &it, NULL);
+    TEST_ASSERT_EQUAL_PTR(first, ANB_rope_flatten(r, &len));
+    TEST_ASSERT_EQUAL_size_t(20, len);
+
+    ANB_rope_push(r, src + 20, 180);
+    ANB_rope_consume(r, 5);
+    uint8_t *flat = ANB_rope_flatten(r, &len);
+    TEST_ASSERT_EQUAL_size_t(195, len);
+    TEST_ASSERT_EQUAL_MEMORY(src + 5, flat, 195);
+    TEST_ASSERT_EQUAL_size_t(1, ANB_rope_segment_count(r));
+
+    /* Flattening again is free; appends go behind it */
+    TEST_ASSERT_EQUAL_PTR(flat, ANB_rope_flatten(r, NULL));
+    ANB_rope_push(r, src, 10);
+    TEST_ASSERT_EQUAL_size_t(2, ANB_rope_segment_count(r));
+    TEST_ASSERT_EQUAL_MEMORY(src + 5, flat, 195);
+
+    /* The oversized flat segment is not kept for reuse */
+    ANB_rope_consume(r, 195);
+    TEST_ASSERT_EQUAL_size_t(1, ANB_rope_segment_count(r));
+    ANB_rope_reset(r);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_rope_data_len(r));
+    TEST_ASSERT_EQUAL_size_t(1, ANB_rope_segment_count(r));
+
+    ANB_rope_destroy(r);
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. Creation flags apply to every segment, including mapped ones    */
+/* ------------------------------------------------------------------ */
+void test_rope_flags(void) {
+    ANB_Rope_t *r = ANB_rope_create_ex(0, ANB_MEM_SECURE | ANB_MEM_DONTDUMP);
+    static uint8_t src[ANB_ROPE_SEGMENT_DEFAULT * 3 + 17];
+    rope_fill(src, sizeof(src), 11);
+    ANB_rope_push(r, src, sizeof(src));
+    TEST_ASSERT_EQUAL_size_t(4, ANB_rope_segment_count(r));
+
+    size_t len;
+    uint8_t *flat = ANB_rope_flatten(r, &len);
+    TEST_ASSERT_EQUAL_size_t(sizeof(src), len);
+    TEST_ASSERT_EQUAL_MEMORY(src, flat, sizeof(src));
+    ANB_rope_destroy(r);
+}
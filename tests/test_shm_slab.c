@@ -0,0 +1,268 @@
+#include "unity.h"
+#include "shm_slab.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* ------------------------------------------------------------------ */
+/* 1. A second mapping at another address sees the same queue         */
+/* ------------------------------------------------------------------ */
+void test_shm_slab_open_fd(void) {
+    ANB_ShmSlab_t *q = ANB_shm_slab_create(NULL, 5000, 0);
+    TEST_ASSERT_NOT_NULL(q);
+    TEST_ASSERT_EQUAL_size_t(8192, ANB_shm_slab_capacity(q));
+    ANB_ShmSlab_t *other = ANB_shm_slab_open_fd(ANB_shm_slab_fd(q));
+    TEST_ASSERT_NOT_NULL(other);
+    TEST_ASSERT_EQUAL_size_t(8192, ANB_shm_slab_capacity(other));
+
+    TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_push_item(q, (const uint8_t *)"hello", 5));
+    uint8_t *w = ANB_shm_slab_alloc_item(q, 3);
+    TEST_ASSERT_EQUAL_size_t(0, (uintptr_t)w % _Alignof(max_align_t));
+    memcpy(w, "abc", 3);
+    TEST_ASSERT_EQUAL_size_t(1, ANB_shm_slab_item_count(other));
+    ANB_shm_slab_publish(q, w);
+    TEST_ASSERT_EQUAL_size_t(2, ANB_shm_slab_item_count(other));
+
+    size_t n;
+    uint8_t *mine = ANB_shm_slab_peek_item_iter(q, NULL, &n);
+    uint8_t *theirs = ANB_shm_slab_peek_item_iter(other, NULL, &n);
+    TEST_ASSERT_TRUE(mine != theirs);
+    TEST_ASSERT_EQUAL_size_t(5, n);
+    TEST_ASSERT_EQUAL_MEMORY("hello", theirs, 5);
+    TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_pop_item(other));
+    theirs = ANB_shm_slab_peek_item_iter(other, NULL, &n);
+    TEST_ASSERT_EQUAL_size_t(3, n);
+    TEST_ASSERT_EQUAL_MEMORY("abc", theirs, 3);
+    TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_pop_item(other));
+    TEST_ASSERT_EQUAL_INT(-1, ANB_shm_slab_pop_item(q));
+    TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_wait(q, 0));
+    ANB_shm_slab_destroy(other);
+
+    // A segment with another layout version is refused
+    uint32_t *raw = (uint32_t *)mmap(NULL, 64, PROT_READ | PROT_WRITE, MAP_SHARED, ANB_shm_slab_fd(q), 0);
+    TEST_ASSERT_TRUE(raw != MAP_FAILED);
+    TEST_ASSERT_EQUAL_UINT32(ANB_SHM_SLAB_VERSION, raw[1]);
+    raw[1] = ANB_SHM_SLAB_VERSION + 1;
+    TEST_ASSERT_NULL(ANB_shm_slab_open_fd(ANB_shm_slab_fd(q)));
+    raw[1] = ANB_SHM_SLAB_VERSION;
+    munmap(raw, 64);
+    TEST_ASSERT_NULL(ANB_shm_slab_open_fd(-1));
+
+    ANB_shm_slab_destroy(q);
+    ANB_shm_slab_destroy(NULL);
+}
+
+/* ------------------------------------------------------------------ */
+/* 2. Items stay contiguous across the end of the data area           */
+/* ------------------------------------------------------------------ */
+void test_shm_slab_wrap(void) {
+    ANB_ShmSlab_t *q = ANB_shm_slab_create(NULL, 4096, 0);
+    size_t cap = ANB_shm_slab_capacity(q);
+    uint8_t src[1000];
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)(i * 7 + 1);
+
+    TEST_ASSERT_NULL(ANB_shm_slab_alloc_item(q, cap));
+    TEST_ASSERT_NOT_NULL(ANB_shm_slab_alloc_item(q, cap - 16));
+    TEST_ASSERT_NULL(ANB_shm_slab_alloc_item(q, 0));
+    ANB_shm_slab_destroy(q);
+
+    q = ANB_shm_slab_create(NULL, 4096, 0);
+    int pushed = 0, popped = 0;
+    for (int round = 0; round < 50; round++) {
+        size_t len = 300 + (size_t)round * 13 % 700;
+        while (ANB_shm_slab_push_item(q, src, len) == 0) pushed++;
+        TEST_ASSERT_TRUE(ANB_shm_slab_item_count(q) > 0);
+
+        // Walk all items, then drop all but the last one
+        ANB_ShmSlabIter_t it = {0};
+        size_t n, seen = 0;
+        uint8_t *p;
+        while ((p = ANB_shm_slab_peek_item_iter(q, &it, &n)) != NULL) {
+            TEST_ASSERT_EQUAL_size_t(0, (uintptr_t)p % _Alignof(max_align_t));
+            TEST_ASSERT_EQUAL_MEMORY(src, p, n);
+            seen++;
+        }
+        TEST_ASSERT_EQUAL_size_t(ANB_shm_slab_item_count(q), seen);
+        while (ANB_shm_slab_item_count(q) > 1) {
+            TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_pop_item(q));
+            popped++;
+        }
+    }
+    TEST_ASSERT_TRUE(pushed > 100);
+    TEST_ASSERT_EQUAL_size_t((size_t)(pushed - popped), ANB_shm_slab_item_count(q));
+    TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_push_item(q, NULL, 0));
+    ANB_shm_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 3. Producer in a child process, consumer sleeping on the futex     */
+/* ------------------------------------------------------------------ */
+#define SHM_FORK_ITEMS 20000
+
+void test_shm_slab_fork(void) {
+    ANB_ShmSlab_t *q = ANB_shm_slab_create(NULL, 16384, 0);
+    pid_t pid = fork();
+    TEST_ASSERT_TRUE(pid >= 0);
+    if (pid == 0) {
+        // The child maps the inherited descriptor again, at an address of its own
+        ANB_ShmSlab_t *c = ANB_shm_slab_open_fd(ANB_shm_slab_fd(q));
+        if (!c) _exit(1);
+        for (uint32_t i = 0; i < SHM_FORK_ITEMS; i++) {
+            size_t len = 4 + i % 200;
+            uint8_t *w;
+            while ((w = ANB_shm_slab_alloc_item(c, len)) == NULL) sched_yield();
+            memset(w, (int)(i & 0xFF), len);
+            memcpy(w, &i, 4);
+            ANB_shm_slab_publish(c, w);
+            if (i % 5000 == 0) usleep(20000); // Let the consumer fall asleep
+        }
+        _exit(0);
+    }
+
+    int ok = 1;
+    for (uint32_t i = 0; i < SHM_FORK_ITEMS && ok; i++) {
+        if (!ANB_shm_slab_wait(q, 5000)) {
+            ok = 0;
+            break;
+        }
+        size_t n;
+        uint8_t *p = ANB_shm_slab_peek_item_iter(q, NULL, &n);
+        uint32_t v;
+        memcpy(&v, p, 4);
+        if (v != i || n != 4 + i % 200 || (n > 4 && p[n - 1] != (uint8_t)i)) ok = 0;
+        ANB_shm_slab_pop_item(q);
+    }
+    int status = -1;
+    waitpid(pid, &status, 0);
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_shm_slab_item_count(q));
+    ANB_shm_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 4. Several producers, each with its own mapping                    */
+/* ------------------------------------------------------------------ */
+#define SHM_MPSC_THREADS 4
+#define SHM_MPSC_ITEMS 20000
+
+typedef struct {
+    int fd;
+    uint32_t id;
+} ShmProducer_t;
+
+static void *shm_producer(void *arg) {
+    ShmProducer_t *p = (ShmProducer_t *)arg;
+    ANB_ShmSlab_t *q = ANB_shm_slab_open_fd(p->fd);
+    for (uint32_t i = 0; i < SHM_MPSC_ITEMS; i++) {
+        uint32_t msg[2] = {p->id, i};
+        size_t len = sizeof(msg) + (i % 3) * 40;
+        uint8_t *w;
+        while ((w = ANB_shm_slab_alloc_item(q, len)) == NULL) sched_yield();
+        memcpy(w, msg, sizeof(msg));
+        ANB_shm_slab_publish(q, w);
+    }
+    ANB_shm_slab_destroy(q);
+    return NULL;
+}
+
+void test_shm_slab_mpsc(void) {
+    ANB_ShmSlab_t *q = ANB_shm_slab_create(NULL, 8192, ANB_SHM_MPSC);
+    pthread_t th[SHM_MPSC_THREADS];
+    ShmProducer_t prod[SHM_MPSC_THREADS];
+    for (uint32_t t = 0; t < SHM_MPSC_THREADS; t++) {
+        prod[t].fd = ANB_shm_slab_fd(q);
+        prod[t].id = t;
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&th[t], NULL, shm_producer, &prod[t]));
+    }
+
+    uint32_t next[SHM_MPSC_THREADS] = {0};
+    int ok = 1;
+    for (uint32_t got = 0; got < SHM_MPSC_THREADS * SHM_MPSC_ITEMS && ok; got++) {
+        if (!ANB_shm_slab_wait(q, 5000)) {
+            ok = 0;
+            break;
+        }
+        size_t n;
+        uint32_t msg[2];
+        memcpy(msg, ANB_shm_slab_peek_item_iter(q, NULL, &n), sizeof(msg));
+        if (msg[0] >= SHM_MPSC_THREADS || msg[1] != next[msg[0]]++ || n != sizeof(msg) + (msg[1] % 3) * 40) ok = 0;
+        ANB_shm_slab_pop_item(q);
+    }
+    for (int t = 0; t < SHM_MPSC_THREADS; t++) pthread_join(th[t], NULL);
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_shm_slab_item_count(q));
+    TEST_ASSERT_NULL(ANB_shm_slab_peek_item_iter(q, NULL, NULL));
+    ANB_shm_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 5. Named segments and timeouts                                     */
+/* ------------------------------------------------------------------ */
+void test_shm_slab_named(void) {
+    char name[64];
+    snprintf(name, sizeof(name), "/anb_test_shm_slab_%ld", (long)getpid());
+    ANB_ShmSlab_t *q = ANB_shm_slab_create(name, 1, ANB_SHM_MPSC);
+    TEST_ASSERT_NOT_NULL(q);
+    TEST_ASSERT_NULL(ANB_shm_slab_create(name, 1, 0));
+
+    ANB_ShmSlab_t *other = ANB_shm_slab_open(name);
+    TEST_ASSERT_NOT_NULL(other);
+    TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_wait(other, 20));
+    ANB_shm_slab_push_item(q, (const uint8_t *)"x", 1);
+    TEST_ASSERT_EQUAL_INT(1, ANB_shm_slab_wait(other, -1));
+
+    // The creator unlinks the name; the other mapping keeps working
+    ANB_shm_slab_destroy(q);
+    TEST_ASSERT_NULL(ANB_shm_slab_open(name));
+    size_t n;
+    TEST_ASSERT_EQUAL_MEMORY("x", ANB_shm_slab_peek_item_iter(other, NULL, &n), 1);
+    ANB_shm_slab_destroy(other);
+}
+
+/* ------------------------------------------------------------------ */
+/* 6. An item as large as the queue fits after a wrap                 */
+/* ------------------------------------------------------------------ */
+void test_shm_slab_big_item(void) {
+    static const unsigned flags[] = {0, ANB_SHM_MPSC};
+    uint8_t src[4096];
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)(i * 13 + 5);
+
+    for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+        ANB_ShmSlab_t *q = ANB_shm_slab_create(NULL, 4096, flags[f]);
+        size_t cap = ANB_shm_slab_capacity(q);
+        TEST_ASSERT_EQUAL_size_t(4096, cap);
+
+        // Leave the queue empty with its positions in the middle of the data area
+        TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_push_item(q, src, 2000));
+        TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_pop_item(q));
+        TEST_ASSERT_EQUAL_size_t(0, ANB_shm_slab_item_count(q));
+
+        TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_push_item(q, src, 3000));
+        TEST_ASSERT_EQUAL_INT(-1, ANB_shm_slab_push_item(q, src, 1100));
+        size_t n;
+        uint8_t *p = ANB_shm_slab_peek_item_iter(q, NULL, &n);
+        TEST_ASSERT_EQUAL_size_t(3000, n);
+        TEST_ASSERT_EQUAL_MEMORY(src, p, n);
+        TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_pop_item(q));
+
+        // The largest item, crossing the end again, and seen the same way through another mapping
+        TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_push_item(q, src, cap - 16));
+        ANB_ShmSlab_t *other = ANB_shm_slab_open_fd(ANB_shm_slab_fd(q));
+        TEST_ASSERT_NOT_NULL(other);
+        p = ANB_shm_slab_peek_item_iter(other, NULL, &n);
+        TEST_ASSERT_EQUAL_size_t(cap - 16, n);
+        TEST_ASSERT_EQUAL_MEMORY(src, p, n);
+        TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_pop_item(other));
+        ANB_shm_slab_destroy(other);
+
+        TEST_ASSERT_NULL(ANB_shm_slab_peek_item_iter(q, NULL, NULL));
+        TEST_ASSERT_EQUAL_INT(0, ANB_shm_slab_push_item(q, src, 8));
+        TEST_ASSERT_EQUAL_size_t(1, ANB_shm_slab_item_count(q));
+        ANB_shm_slab_destroy(q);
+    }
+}
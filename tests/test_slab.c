@@ -1,7 +1,10 @@
 #include "unity.h"
 #include "slab.h"
+#include <poll.h>
+#include <pthread.h>
 #include <string.h>
 #include <stddef.h>
+#include <unistd.h>
 
 /* Mirrors the alignment macro used internally by ANB_Slab. */
 #define ALIGN_UP(x) (((x) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
@@ -350,6 +353,403 @@ void test_peek_item(void) {
     ANB_slab_destroy(q);
 }
 
+/* ------------------------------------------------------------------ */
+/* 10. Large items grow data past the mapping threshold               */
+/* ------------------------------------------------------------------ */
+void test_large_growth(void) {
+    ANB_Slab_t *q = ANB_slab_create(64);
+    static uint8_t item[100000];
+
+    for (size_t i = 0; i < 100; i++) {
+        memset(item, (int)i, sizeof(item));
+        ANB_slab_push_item(q, item, sizeof(item));
+    }
+    TEST_ASSERT_EQUAL_size_t(100, ANB_slab_item_count(q));
+
+    ANB_SlabIter_t iter = {0};
+    size_t sz, i = 0;
+    uint8_t *data;
+    while ((data = ANB_slab_peek_item_iter(q, &iter, &sz)) != NULL) {
+        TEST_ASSERT_EQUAL_size_t(sizeof(item), sz);
+        TEST_ASSERT_EQUAL_UINT8(i, data[0]);
+        TEST_ASSERT_EQUAL_UINT8(i, data[sz - 1]);
+        i++;
+    }
+    TEST_ASSERT_EQUAL_size_t(100, i);
+
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 11. Creation flags                                                 */
+/* ------------------------------------------------------------------ */
+void test_create_ex_flags(void) {
+    ANB_Slab_t *q = ANB_slab_create_ex(256, ANB_MEM_HUGEPAGE | ANB_MEM_PREFAULT | ANB_MEM_MLOCK);
+    TEST_ASSERT_NOT_NULL(q);
+
+    for (size_t i = 0; i < 1000; i++) {
+        ANB_slab_push_item(q, (const uint8_t *)"flagged", 8);
+    }
+    TEST_ASSERT_EQUAL_size_t(1000, ANB_slab_item_count(q));
+
+    ANB_SlabIter_t iter = {0};
+    size_t sz, n = 0;
+    uint8_t *data;
+    while ((data = ANB_slab_peek_item_iter(q, &iter, &sz)) != NULL) {
+        TEST_ASSERT_EQUAL_STRING("flagged", (const char *)data);
+        n++;
+    }
+    TEST_ASSERT_EQUAL_size_t(1000, n);
+
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 12. Trim keeps live items                                          */
+/* ------------------------------------------------------------------ */
+void test_trim(void) {
+    ANB_Slab_t *q = ANB_slab_create(64);
+    uint8_t item[256];
+    memset(item, 0x77, sizeof(item));
+
+    for (size_t i = 0; i < 200; i++) {
+        ANB_slab_push_item(q, item, sizeof(item));
+    }
+    for (size_t i = 0; i < 198; i++) {
+        ANB_slab_pop_item(q, NULL);
+    }
+    size_t before = ANB_slab_capacity(q);
+
+    /* Deleted items still occupy space until reset, so trim keeps write_pos */
+    ANB_slab_trim(q);
+    TEST_ASSERT_EQUAL_size_t(ANB_slab_size(q), ANB_slab_capacity(q));
+    TEST_ASSERT(ANB_slab_capacity(q) <= before);
+
+    ANB_SlabIter_t iter = {0};
+    size_t sz, n = 0;
+    uint8_t *data;
+    while ((data = ANB_slab_peek_item_iter(q, &iter, &sz)) != NULL) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(item, data, sz);
+        n++;
+    }
+    TEST_ASSERT_EQUAL_size_t(2, n);
+
+    /* After reset, trim returns to the initial size */
+    ANB_slab_pop_item(q, NULL);
+    ANB_slab_pop_item(q, NULL);
+    ANB_slab_trim(q);
+    TEST_ASSERT_EQUAL_size_t(64, ANB_slab_capacity(q));
+
+    ANB_slab_push_item(q, item, sizeof(item));
+    TEST_ASSERT_EQUAL_size_t(1, ANB_slab_item_count(q));
+
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 13. Automatic trim on reset                                        */
+/* ------------------------------------------------------------------ */
+void test_auto_trim(void) {
+    ANB_Slab_t *q = ANB_slab_create(64);
+    ANB_TrimPolicy_t p = { 50, 2, ANB_TRIM_SHRINK };
+    ANB_slab_set_trim(q, &p);
+    uint8_t item[64] = {0};
+
+    for (size_t i = 0; i < 500; i++) ANB_slab_push_item(q, item, sizeof(item));
+    while (ANB_slab_item_count(q)) ANB_slab_pop_item(q, NULL);
+    size_t peak = ANB_slab_capacity(q);
+
+    for (int round = 0; round < 2; round++) {
+        for (size_t i = 0; i < 10; i++) ANB_slab_push_item(q, item, sizeof(item));
+        while (ANB_slab_item_count(q)) ANB_slab_pop_item(q, NULL);
+    }
+    TEST_ASSERT_EQUAL_size_t(10 * ALIGN_UP(sizeof(item)), ANB_slab_capacity(q));
+    TEST_ASSERT(ANB_slab_capacity(q) < peak);
+
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 14. Secure queue wipes data when it resets                         */
+/* ------------------------------------------------------------------ */
+void test_secure_reset(void) {
+    ANB_Slab_t *q = ANB_slab_create_ex(64, ANB_MEM_SECURE);
+    uint8_t secret[48];
+    memset(secret, 0xC3, sizeof(secret));
+
+    for (size_t i = 0; i < 20; i++) {
+        ANB_slab_push_item(q, secret, sizeof(secret));   /* grows securely */
+    }
+
+    ANB_SlabIter_t iter = {0};
+    size_t sz;
+    uint8_t *first = ANB_slab_peek_item_iter(q, &iter, &sz);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(secret, first, sz);
+
+    size_t used = ANB_slab_size(q);
+    while (ANB_slab_item_count(q)) ANB_slab_pop_item(q, NULL);
+    for (size_t i = 0; i < used; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, first[i]);
+    }
+
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 15. FIFO pops interleaved with pushes and fresh iterators          */
+/* ------------------------------------------------------------------ */
+void test_fifo_pop_order(void) {
+    ANB_Slab_t *q = ANB_slab_create(64);
+    uint32_t next_push = 0, next_pop = 0;
+
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 7; i++, next_push++) {
+            ANB_slab_push_item(q, (const uint8_t *)&next_push, sizeof(next_push));
+        }
+        for (int i = 0; i < 5; i++, next_pop++) {
+            ANB_SlabIter_t iter = {0};
+            uint32_t v;
+            memcpy(&v, ANB_slab_peek_item_iter(q, &iter, NULL), sizeof(v));
+            TEST_ASSERT_EQUAL_UINT32(next_pop, v);
+            TEST_ASSERT_EQUAL_INT(0, ANB_slab_pop_item(q, NULL));
+        }
+
+        /* A fresh iterator sees exactly the live items, in order */
+        ANB_SlabIter_t iter = {0};
+        uint8_t *d;
+        uint32_t expect = next_pop;
+        while ((d = ANB_slab_peek_item_iter(q, &iter, NULL)) != NULL) {
+            uint32_t v;
+            memcpy(&v, d, sizeof(v));
+            TEST_ASSERT_EQUAL_UINT32(expect++, v);
+        }
+        TEST_ASSERT_EQUAL_UINT32(next_push, expect);
+    }
+    TEST_ASSERT_EQUAL_size_t(next_push - next_pop, ANB_slab_item_count(q));
+
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 16. Reset drops every item at once                                 */
+/* ------------------------------------------------------------------ */
+void test_slab_reset(void) {
+    ANB_Slab_t *q = ANB_slab_create(64);
+    for (uint32_t i = 0; i < 100; i++) {
+        ANB_slab_push_item(q, (const uint8_t *)&i, sizeof(i));
+    }
+    ANB_SlabIter_t iter = {0};
+    ANB_slab_peek_item_iter(q, &iter, NULL);
+    size_t cap = ANB_slab_capacity(q);
+
+    ANB_slab_reset(q);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_slab_item_count(q));
+    TEST_ASSERT_EQUAL_size_t(0, ANB_slab_size(q));
+    TEST_ASSERT_EQUAL_size_t(cap, ANB_slab_capacity(q));
+    TEST_ASSERT_FALSE(ANB_slab_item_valid(q, &iter));
+    TEST_ASSERT_EQUAL_INT(-1, ANB_slab_pop_item(q, NULL));
+
+    /* Usable again, starting from the front of the buffer */
+    uint32_t v = 7;
+    ANB_slab_push_item(q, (const uint8_t *)&v, sizeof(v));
+    ANB_SlabIter_t it2 = {0};
+    size_t sz;
+    uint8_t *d = ANB_slab_peek_item_iter(q, &it2, &sz);
+    TEST_ASSERT_EQUAL_size_t(sizeof(v), sz);
+    TEST_ASSERT_EQUAL_MEMORY(&v, d, sizeof(v));
+    TEST_ASSERT_EQUAL_size_t(1, ANB_slab_item_count(q));
+
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 17. Slab in caller storage fails when full                         */
+/* ------------------------------------------------------------------ */
+void test_slab_init_in(void) {
+    _Alignas(max_align_t) uint8_t buf[2048];
+    TEST_ASSERT_NULL(ANB_slab_init_in(buf, 16, 0));
+    TEST_ASSERT_NULL(ANB_slab_init_in(buf, sizeof(buf), ANB_MEM_MLOCK));
+
+    ANB_Slab_t *q = ANB_slab_init_in(buf + 3, sizeof(buf) - 3, 0);
+    TEST_ASSERT_NOT_NULL(q);
+    size_t cap = ANB_slab_capacity(q);
+    TEST_ASSERT_TRUE(cap > 0 && cap < sizeof(buf));
+
+    /* Smallest items: the index must not run out before the data */
+    uint32_t n = 0;
+    while (ANB_slab_push_item(q, (const uint8_t *)&n, sizeof(n)) == 0) n++;
+    TEST_ASSERT_EQUAL_size_t(n, ANB_slab_item_count(q));
+    TEST_ASSERT_TRUE(ANB_slab_size(q) + _Alignof(max_align_t) > cap);
+    TEST_ASSERT_NULL(ANB_slab_alloc_item(q, 1));
+    TEST_ASSERT_EQUAL_size_t(n, ANB_slab_item_count(q));
+    TEST_ASSERT_EQUAL_size_t(cap, ANB_slab_capacity(q));
+
+    ANB_SlabIter_t iter = {0};
+    uint8_t *d;
+    uint32_t expect = 0;
+    while ((d = ANB_slab_peek_item_iter(q, &iter, NULL)) != NULL) {
+        TEST_ASSERT_TRUE(d >= buf && d < buf + sizeof(buf));
+        uint32_t v;
+        memcpy(&v, d, sizeof(v));
+        TEST_ASSERT_EQUAL_UINT32(expect++, v);
+    }
+
+    /* Popping everything makes the storage reusable; trim leaves it alone */
+    ANB_slab_reset(q);
+    ANB_slab_trim(q);
+    TEST_ASSERT_EQUAL_size_t(cap, ANB_slab_capacity(q));
+    TEST_ASSERT_NOT_NULL(ANB_slab_alloc_item(q, cap));
+    TEST_ASSERT_NULL(ANB_slab_alloc_item(q, 1));
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 18. Slab in caller storage spills to the heap                      */
+/* ------------------------------------------------------------------ */
+void test_slab_init_in_spill(void) {
+    uint8_t buf[512];
+    ANB_Slab_t *q = ANB_slab_init_in(buf, sizeof(buf), ANB_MEM_SPILL);
+    TEST_ASSERT_NOT_NULL(q);
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_INT(0, ANB_slab_push_item(q, (const uint8_t *)&i, sizeof(i)));
+    }
+    TEST_ASSERT_TRUE(ANB_slab_capacity(q) > sizeof(buf));
+
+    ANB_SlabIter_t iter = {0};
+    uint8_t *d;
+    uint32_t expect = 0;
+    while ((d = ANB_slab_peek_item_iter(q, &iter, NULL)) != NULL) {
+        uint32_t v;
+        memcpy(&v, d, sizeof(v));
+        TEST_ASSERT_EQUAL_UINT32(expect++, v);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000, expect);
+
+    ANB_slab_destroy(q);
+}
+
+/* ------------------------------------------------------------------ */
+/* 19. A consumer sleeps until a producer thread pushes               */
+/* ------------------------------------------------------------------ */
+#define WAIT_ITEMS 2000
+
+typedef struct {
+    ANB_Slab_t *q;
+    pthread_mutex_t lock;
+} WaitShared_t;
+
+static void *wait_producer(void *arg) {
+    WaitShared_t *w = (WaitShared_t *)arg;
+    for (uint32_t i = 0; i < WAIT_ITEMS; i++) {
+        pthread_mutex_lock(&w->lock);
+        ANB_slab_push_item(w->q, (const uint8_t *)&i, sizeof(i));
+        pthread_mutex_unlock(&w->lock);
+        if (i % 250 == 0) usleep(2000); // Let the consumer fall asleep now and then
+    }
+    return NULL;
+}
+
+static void *wait_push_one(void *arg) {
+    WaitShared_t *w = (WaitShared_t *)arg;
+    pthread_mutex_lock(&w->lock);
+    ANB_slab_push_item(w->q, (const uint8_t *)"y", 1);
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+void test_slab_wait_nonempty(void) {
+    WaitShared_t w;
+    w.q = ANB_slab_create(256);
+    pthread_mutex_init(&w.lock, NULL);
+    TEST_ASSERT_EQUAL_INT(0, ANB_slab_wait_nonempty(w.q, 0));
+    TEST_ASSERT_EQUAL_INT(0, ANB_slab_wait_nonempty(w.q, 20));
+    ANB_slab_push_item(w.q, (const uint8_t *)"x", 1);
+    TEST_ASSERT_EQUAL_INT(1, ANB_slab_wait_nonempty(w.q, -1));
+    ANB_slab_pop_item(w.q, NULL);
+    TEST_ASSERT_EQUAL_INT(0, ANB_slab_wait_nonempty(w.q, 0));
+
+    pthread_t t;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&t, NULL, wait_producer, &w));
+    uint32_t expect = 0;
+    int ok = 1;
+    while (expect < WAIT_ITEMS && ok) {
+        if (!ANB_slab_wait_nonempty(w.q, 5000)) {
+            ok = 0;
+            break;
+        }
+        pthread_mutex_lock(&w.lock);
+        ANB_SlabIter_t it = {0};
+        uint8_t *d;
+        while ((d = ANB_slab_peek_item_iter(w.q, &it, NULL)) != NULL) {
+            uint32_t v;
+            memcpy(&v, d, sizeof(v));
+            if (v != expect++) ok = 0;
+            ANB_slab_pop_item(w.q, &it);
+        }
+        pthread_mutex_unlock(&w.lock);
+    }
+    pthread_join(t, NULL);
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL_size_t(0, ANB_slab_item_count(w.q));
+    ANB_slab_destroy(w.q);
+
+    // A push racing the very first wait on a fresh queue still wakes it
+    for (int round = 0; round < 300 && ok; round++) {
+        w.q = ANB_slab_create(64);
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&t, NULL, wait_push_one, &w));
+        ok = ANB_slab_wait_nonempty(w.q, 5000);
+        pthread_join(t, NULL);
+        ANB_slab_destroy(w.q);
+    }
+    TEST_ASSERT_TRUE(ok);
+    pthread_mutex_destroy(&w.lock);
+}
+
+/* ------------------------------------------------------------------ */
+/* 20. Event descriptor: one wakeup per burst, re-armed by ack        */
+/* ------------------------------------------------------------------ */
+static int slab_fd_readable(int fd) {
+    struct pollfd p = {fd, POLLIN, 0};
+    return poll(&p, 1, 0) == 1 && (p.revents & POLLIN);
+}
+
+void test_slab_event_fd(void) {
+    ANB_Slab_t *q = ANB_slab_create(256);
+    int fd = ANB_slab_event_fd(q);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(fd, ANB_slab_event_fd(q));
+    TEST_ASSERT_FALSE(slab_fd_readable(fd));
+
+    for (uint32_t i = 0; i < 100; i++) ANB_slab_push_item(q, (const uint8_t *)&i, sizeof(i));
+    TEST_ASSERT_TRUE(slab_fd_readable(fd));
+#if defined(__linux__)
+    uint64_t n = 0;
+    TEST_ASSERT_EQUAL_INT(8, (int)read(fd, &n, sizeof(n)));
+    TEST_ASSERT_TRUE(n == 1);                 // The burst wrote once
+    ANB_slab_push_item(q, (const uint8_t *)"x", 1);
+    TEST_ASSERT_FALSE(slab_fd_readable(fd)); // Still disarmed
+#endif
+
+    // Items left over make the descriptor readable again right away
+    ANB_slab_event_ack(q);
+    TEST_ASSERT_TRUE(slab_fd_readable(fd));
+    ANB_slab_reset(q);
+    ANB_slab_event_ack(q);
+    TEST_ASSERT_FALSE(slab_fd_readable(fd));
+    ANB_slab_alloc_item(q, 8);
+    TEST_ASSERT_TRUE(slab_fd_readable(fd));
+    ANB_slab_destroy(q);
+
+    // Created on a queue that already holds items: readable at once
+    uint8_t buf[1024];
+    q = ANB_slab_init_in(buf, sizeof(buf), 0);
+    ANB_slab_push_item(q, (const uint8_t *)"x", 1);
+    fd = ANB_slab_event_fd(q);
+    TEST_ASSERT_TRUE(slab_fd_readable(fd));
+    ANB_slab_destroy(q);
+}
+
 /* ------------------------------------------------------------------ */
 /* Blob test declarations                                             */
 /* ------------------------------------------------------------------ */
@@ -366,6 +766,95 @@ void test_push_auto_grow(void);
 void test_reset(void);
 void test_clear_resets_pos(void);
 void test_push_multiple(void);
+void test_blob_large_growth(void);
+void test_blob_create_ex_hugepage(void);
+void test_blob_create_ex_mlock(void);
+void test_blob_trim(void);
+void test_blob_auto_trim(void);
+void test_blob_auto_trim_release(void);
+void test_blob_secure(void);
+void test_secure_zero(void);
+void test_blob_init_in(void);
+void test_blob_init_in_spill(void);
+void test_blob_inline(void);
+void test_blob_create_compact(void);
+void test_blob_reserve_commit(void);
+void test_blob_consume(void);
+void test_blob_consume_reclaims(void);
+void test_blob_map_file(void);
+void test_blob_map_file_errors(void);
+void test_blob_find_byte_any(void);
+void test_blob_find_pattern(void);
+void test_blob_find_random(void);
+void test_blob_clear_dirty(void);
+
+/* ------------------------------------------------------------------ */
+/* Growth test declarations                                           */
+/* ------------------------------------------------------------------ */
+void test_growth_default_doubles(void);
+void test_growth_exact_fit(void);
+void test_growth_max_step(void);
+void test_growth_round(void);
+void test_growth_custom_fn(void);
+void test_growth_slab_blob_policy(void);
+
+/* ------------------------------------------------------------------ */
+/* Ring test declarations                                             */
+/* ------------------------------------------------------------------ */
+void test_ring_create(void);
+void test_ring_double_mapped(void);
+void test_ring_wraparound(void);
+void test_ring_full(void);
+void test_ring_spsc(void);
+
+/* ------------------------------------------------------------------ */
+/* Blob fd I/O test declarations                                      */
+/* ------------------------------------------------------------------ */
+void test_blob_io_read_pipe(void);
+void test_blob_io_read_max(void);
+void test_blob_io_read_grows(void);
+void test_blob_io_read_fixed(void);
+void test_blob_io_write_partial(void);
+void test_blob_io_writev(void);
+void test_blob_io_splice(void);
+
+/* ------------------------------------------------------------------ */
+/* Blob pool test declarations                                        */
+/* ------------------------------------------------------------------ */
+void test_blob_pool_recycle(void);
+void test_blob_pool_oversize(void);
+void test_blob_pool_grown(void);
+void test_blob_pool_retain_cap(void);
+void test_blob_pool_threads(void);
+void test_rope_push_iter(void);
+void test_rope_reserve_commit(void);
+void test_rope_iovec_consume(void);
+void test_rope_flatten(void);
+void test_rope_flags(void);
+void test_codec_fixed_width(void);
+void test_codec_varint(void);
+void test_codec_truncated(void);
+void test_codec_svb(void);
+void test_codec_svb_blob(void);
+void test_framer_length(void);
+void test_framer_delimiter(void);
+void test_framer_fixed(void);
+void test_framer_max_frame(void);
+void test_framer_full_slab(void);
+void test_blob_slice_cow(void);
+void test_blob_slice_reclaim(void);
+void test_blob_slice_storage(void);
+void test_blob_slice_threads(void);
+void test_digest_vectors(void);
+void test_digest_blob_stream(void);
+void test_digest_blob_paths(void);
+void test_digest_hook(void);
+void test_shm_slab_open_fd(void);
+void test_shm_slab_wrap(void);
+void test_shm_slab_fork(void);
+void test_shm_slab_mpsc(void);
+void test_shm_slab_named(void);
+void test_shm_slab_big_item(void);
 
 /* ------------------------------------------------------------------ */
 int main(void) {
@@ -379,6 +868,17 @@ int main(void) {
     RUN_TEST(test_reset_on_empty);
     RUN_TEST(test_iter_valid);
     RUN_TEST(test_peek_item);
+    RUN_TEST(test_large_growth);
+    RUN_TEST(test_create_ex_flags);
+    RUN_TEST(test_trim);
+    RUN_TEST(test_auto_trim);
+    RUN_TEST(test_secure_reset);
+    RUN_TEST(test_fifo_pop_order);
+    RUN_TEST(test_slab_reset);
+    RUN_TEST(test_slab_init_in);
+    RUN_TEST(test_slab_init_in_spill);
+    RUN_TEST(test_slab_wait_nonempty);
+    RUN_TEST(test_slab_event_fd);
     RUN_TEST(test_create_destroy);
     RUN_TEST(test_data_usable);
     RUN_TEST(test_alloc_explicit);
@@ -392,5 +892,78 @@ int main(void) {
     RUN_TEST(test_reset);
     RUN_TEST(test_clear_resets_pos);
     RUN_TEST(test_push_multiple);
+    RUN_TEST(test_blob_large_growth);
+    RUN_TEST(test_blob_create_ex_hugepage);
+    RUN_TEST(test_blob_create_ex_mlock);
+    RUN_TEST(test_blob_trim);
+    RUN_TEST(test_blob_auto_trim);
+    RUN_TEST(test_blob_auto_trim_release);
+    RUN_TEST(test_blob_secure);
+    RUN_TEST(test_secure_zero);
+    RUN_TEST(test_blob_init_in);
+    RUN_TEST(test_blob_init_in_spill);
+    RUN_TEST(test_blob_inline);
+    RUN_TEST(test_blob_create_compact);
+    RUN_TEST(test_blob_reserve_commit);
+    RUN_TEST(test_blob_consume);
+    RUN_TEST(test_blob_consume_reclaims);
+    RUN_TEST(test_blob_map_file);
+    RUN_TEST(test_blob_map_file_errors);
+    RUN_TEST(test_blob_find_byte_any);
+    RUN_TEST(test_blob_find_pattern);
+    RUN_TEST(test_blob_find_random);
+    RUN_TEST(test_blob_clear_dirty);
+    RUN_TEST(test_growth_default_doubles);
+    RUN_TEST(test_growth_exact_fit);
+    RUN_TEST(test_growth_max_step);
+    RUN_TEST(test_growth_round);
+    RUN_TEST(test_growth_custom_fn);
+    RUN_TEST(test_growth_slab_blob_policy);
+    RUN_TEST(test_ring_create);
+    RUN_TEST(test_ring_double_mapped);
+    RUN_TEST(test_ring_wraparound);
+    RUN_TEST(test_ring_full);
+    RUN_TEST(test_ring_spsc);
+    RUN_TEST(test_blob_io_read_pipe);
+    RUN_TEST(test_blob_io_read_max);
+    RUN_TEST(test_blob_io_read_grows);
+    RUN_TEST(test_blob_io_read_fixed);
+    RUN_TEST(test_blob_io_write_partial);
+    RUN_TEST(test_blob_io_writev);
+    RUN_TEST(test_blob_io_splice);
+    RUN_TEST(test_blob_pool_recycle);
+    RUN_TEST(test_blob_pool_oversize);
+    RUN_TEST(test_blob_pool_grown);
+    RUN_TEST(test_blob_pool_retain_cap);
+    RUN_TEST(test_blob_pool_threads);
+    RUN_TEST(test_rope_push_iter);
+    RUN_TEST(test_rope_reserve_commit);
+    RUN_TEST(test_rope_iovec_consume);
+    RUN_TEST(test_rope_flatten);
+    RUN_TEST(test_rope_flags);
+    RUN_TEST(test_codec_fixed_width);
+    RUN_TEST(test_codec_varint);
+    RUN_TEST(test_codec_truncated);
+    RUN_TEST(test_codec_svb);
+    RUN_TEST(test_codec_svb_blob);
+    RUN_TEST(test_framer_length);
+    RUN_TEST(test_framer_delimiter);
+    RUN_TEST(test_framer_fixed);
+    RUN_TEST(test_framer_max_frame);
+    RUN_TEST(test_framer_full_slab);
+    RUN_TEST(test_blob_slice_cow);
+    RUN_TEST(test_blob_slice_reclaim);
+    RUN_TEST(test_blob_slice_storage);
+    RUN_TEST(test_blob_slice_threads);
+    RUN_TEST(test_digest_vectors);
+    RUN_TEST(test_digest_blob_stream);
+    RUN_TEST(test_digest_blob_paths);
+    RUN_TEST(test_digest_hook);
+    RUN_TEST(test_shm_slab_open_fd);
+    RUN_TEST(test_shm_slab_wrap);
+    RUN_TEST(test_shm_slab_fork);
+    RUN_TEST(test_shm_slab_mpsc);
+    RUN_TEST(test_shm_slab_named);
+    RUN_TEST(test_shm_slab_big_item);
     return UNITY_END();
 }